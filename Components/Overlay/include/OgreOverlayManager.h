@@ -92,6 +92,10 @@ namespace Ogre {
         const StringVector& getScriptPatterns(void) const;
         /// @copydoc ScriptLoader::parseScript
         void parseScript(DataStreamPtr& stream, const String& groupName);
+        /// @copydoc ScriptLoader::prepareScript
+        Any prepareScript(DataStreamPtr& stream, const String& groupName);
+        /// @copydoc ScriptLoader::parsePreparedScript
+        void parsePreparedScript(DataStreamPtr& stream, const String& groupName, const Any& prepared);
         /// @copydoc ScriptLoader::getLoadingOrder
         Real getLoadingOrder(void) const;
 
@@ -195,6 +195,17 @@ namespace Ogre {
         return OverlayMapIterator(mOverlayMap.begin(), mOverlayMap.end());
     }
     void OverlayManager::parseScript(DataStreamPtr& stream, const String& groupName)
+    {
+        parsePreparedScript(stream, groupName, Any());
+    }
+    //---------------------------------------------------------------------
+    Any OverlayManager::prepareScript(DataStreamPtr& stream, const String& groupName)
+    {
+        return ScriptCompilerManager::getSingleton().prepareScript(stream, groupName);
+    }
+    //---------------------------------------------------------------------
+    void OverlayManager::parsePreparedScript(DataStreamPtr& stream, const String& groupName,
+                                             const Any& prepared)
     {
         // skip scripts that were already loaded as we lack proper re-loading support
         if(!stream->getName().empty() && !mLoadedScripts.emplace(stream->getName()).second)
@@ -204,7 +215,7 @@ namespace Ogre {
             return;
         }
 
-        ScriptCompilerManager::getSingleton().parseScript(stream, groupName);
+        ScriptCompilerManager::getSingleton().parsePreparedScript(stream, groupName, prepared);
     }
     //---------------------------------------------------------------------
     void OverlayManager::_queueOverlaysForRendering(Camera* cam, 
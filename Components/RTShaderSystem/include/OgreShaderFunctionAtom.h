@@ -214,6 +214,15 @@ public:
     /** Abstract method that writes a source code to the given output stream in the target shader language. */
     virtual void writeSourceCode(std::ostream& os, const String& targetLanguage) const = 0;
 
+    /** Appends everything writeSourceCode depends on to the given key.
+
+    Used to identify a program before writing its source code. The key is also stored in the
+    program index of the shader cache, so it must not depend on the compiler or the process.
+    Derived classes must prefix it with a tag of their own and append any additional state
+    they write.
+    */
+    virtual void _appendToKey(String& key) const;
+
 // Attributes.
 protected:
     /** Class default constructor. */
@@ -248,6 +257,9 @@ public:
     */
     virtual void writeSourceCode(std::ostream& os, const String& targetLanguage) const;
 
+    /// @copydoc FunctionAtom::_appendToKey
+    void _appendToKey(String& key) const override;
+
     /** Return the function name */
     const String& getFunctionName() const { return mFunctionName; }
 
@@ -293,6 +305,7 @@ public:
     /// @note the argument order is reversed comered to all other function invocations
     AssignmentAtom(const Out& lhs, const In& rhs, int groupOrder);
     void writeSourceCode(std::ostream& os, const String& targetLanguage) const;
+    void _appendToKey(String& key) const override;
 };
 
 /// shorthand for "dst = texture(sampler, uv);" instead of using FFP_SampleTexture
@@ -302,6 +315,7 @@ public:
     explicit SampleTextureAtom(int groupOrder) { mGroupExecutionOrder = groupOrder; }
     SampleTextureAtom(const In& sampler, const In& texcoord, const Out& dst, int groupOrder);
     void writeSourceCode(std::ostream& os, const String& targetLanguage) const;
+    void _appendToKey(String& key) const override;
 };
 
 /// shorthand for "dst = a OP b;"
@@ -312,6 +326,7 @@ public:
     explicit BinaryOpAtom(char op, int groupOrder) : mOp(op) { mGroupExecutionOrder = groupOrder; }
     BinaryOpAtom(char op, const In& a, const In& b, const Out& dst, int groupOrder);
     void writeSourceCode(std::ostream& os, const String& targetLanguage) const;
+    void _appendToKey(String& key) const override;
 };
 
 typedef std::vector<FunctionAtom*>                 FunctionAtomInstanceList;
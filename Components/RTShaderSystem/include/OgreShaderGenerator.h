@@ -54,6 +54,7 @@ class SGRenderObjectListener;
 class SGSceneManagerListener;
 class SGScriptTranslatorManager;
 class SGResourceGroupListener;
+class SGGenerationHandler;
 
 /** Shader generator system main interface. This singleton based class
 enables automatic generation of shader code based on existing material techniques.
@@ -431,6 +432,25 @@ public:
     */
     bool getCreateShaderOverProgrammablePass() const { return mCreateShaderOverProgrammablePass; }
 
+    /** Sets whether the programs of shader based techniques are generated in the background.
+
+    When enabled, validateScheme still builds the render states of new techniques, but creates
+    the CPU programs and writes their source code on the WorkQueue. Only the GPU programs are
+    created on the main thread, once the WorkQueue responses are processed. Until then, the
+    passes use a simple render state, that only transforms the vertices and applies the colours.
+    @note validateMaterial and illumination passes always generate the programs right away.
+    @param enable The value to set.
+    */
+    void setBackgroundGeneration(bool enable) { mBackgroundGeneration = enable; }
+
+    /** Returns whether the programs are generated in the background.
+    @see setBackgroundGeneration().
+    */
+    bool getBackgroundGeneration() const { return mBackgroundGeneration; }
+
+    /** Returns the number of passes, whose programs are being generated in the background. */
+    size_t getPendingGenerationCount() const;
+
 
     /** Returns the amount of schemes used in the for RT shader generation
     */
@@ -492,8 +512,13 @@ private:
 		SGPass(SGTechnique* parent, Pass* srcPass, Pass* dstPass, IlluminationStage stage);
         ~SGPass();
     
-        /** Build the render state and acquire the CPU/GPU programs */
-        void buildTargetRenderState();
+        /** Build the render state and acquire the CPU/GPU programs
+        @param inBackground generate the programs on the WorkQueue and use a simple render state meanwhile
+        */
+        void buildTargetRenderState(bool inBackground = false);
+
+        /** Acquire the programs of the render state and use it in place of the current one */
+        void _finishTargetRenderState(const TargetRenderStatePtr& targetRenderState);
 
         /** Get source pass. */
         Pass* getSrcPass() { return mSrcPass; }
@@ -548,8 +573,10 @@ private:
         /** Get the destination technique scheme name. */
         const String& getDestinationTechniqueSchemeName() const { return mDstTechniqueSchemeName; }
         
-        /** Build the render state. */
-        void buildTargetRenderState();
+        /** Build the render state.
+        @param inBackground generate the programs on the WorkQueue, see SGPass::buildTargetRenderState
+        */
+        void buildTargetRenderState(bool inBackground = false);
 
 		/** Build the render state for illumination passes. */
 		void buildIlluminationTargetRenderState();
@@ -838,6 +865,8 @@ private:
     std::unique_ptr<SGMaterialSerializerListener> mMaterialSerializerListener;
     // get notified if materials get dropped
     std::unique_ptr<SGResourceGroupListener> mResourceGroupListener;
+    // Generates programs on the WorkQueue.
+    std::unique_ptr<SGGenerationHandler> mGenerationHandler;
     // The core translator of the RT Shader System.
     SGScriptTranslator mCoreScriptTranslator;
     // The target shader language (currently only cg supported).
@@ -876,10 +905,13 @@ private:
     bool mCreateShaderOverProgrammablePass;
     // A flag to indicate finalizing
     bool mIsFinalizing;
+    // Tells whether programs are generated in the background
+    bool mBackgroundGeneration;
 
     uint32 ID_RT_SHADER_SYSTEM;
 
     friend class SGPass;
+    friend class SGGenerationHandler;
     friend class FFPRenderStateBuilder;
     friend class SGScriptTranslatorManager;
     friend class SGScriptTranslator;
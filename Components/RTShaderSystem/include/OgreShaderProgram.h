@@ -157,6 +157,23 @@ public:
     */
     bool getSkeletalAnimationIncluded() const { return mSkeletalAnimation; }
 
+    /** Sets whether a vertex program reads the world matrix per instance.
+    @see GpuProgram::setInstancingIncluded
+    */
+    void setInstancingIncluded(bool value, int texCoordIndex = -1)
+    {
+        mInstancing = value;
+        mInstancingTexCoordIndex = texCoordIndex;
+    }
+
+    /** Returns whether a vertex program reads the world matrix per instance.
+    */
+    bool getInstancingIncluded() const { return mInstancing; }
+
+    /** Returns the first texture coordinate the world matrix per instance is read from.
+    */
+    int getInstancingTexCoordIndex() const { return mInstancingTexCoordIndex; }
+
     /** Tells Ogre whether auto-bound matrices should be sent in column or row-major order.
     @remarks
         This method has the same effect as column_major_matrices option used when declaring manually written hlsl program.
@@ -211,6 +228,10 @@ private:
     String mPreprocessorDefines;
     // Skeletal animation calculation
     bool mSkeletalAnimation;
+    // Whether the world matrix is read per instance
+    bool mInstancing;
+    // First texture coordinate of the instance world matrix.
+    int mInstancingTexCoordIndex;
     // Whether to pass matrices as column-major.
     bool mColumnMajorMatrices;
     friend class TargetRenderState;
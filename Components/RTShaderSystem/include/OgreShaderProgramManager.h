@@ -31,6 +31,8 @@ THE SOFTWARE.
 #include "OgreSingleton.h"
 #include "OgreGpuProgram.h"
 #include "OgreStringVector.h"
+#include "OgreShaderProgramSet.h"
+#include "Threading/OgreThreadHeaders.h"
 
 namespace Ogre {
 namespace RTShader {
@@ -137,6 +139,20 @@ private:
     @param programSet The program set container.
     */
     void createGpuPrograms(ProgramSet* programSet);
+
+    /** Process the CPU programs of the given program set and write their source code, without
+    creating the GPU programs.
+
+    Does not touch the render system, so it can be called on a worker thread.
+    @param programSet The program set container.
+    */
+    void prepareGpuPrograms(ProgramSet* programSet);
+
+    /** Write the source code of the given CPU program.
+    @param shaderProgram The CPU program instance.
+    @param language The target shader language.
+    */
+    String writeSourceCode(Program* shaderProgram, const String& language);
         
     /** 
     Generates a unique hash from a string
@@ -146,16 +162,28 @@ private:
     */
     static String generateHash(const String& programString, const String& defines);
 
+    /**
+    Generates a unique hash from the structure of a CPU program, without writing its source code
+    @param shaderProgram the program to generate a hash value for
+    @param environment everything else the source code depends on, like the target language
+    @return A string representing a 128 bit hash value of the program
+    */
+    static String generateHash(Program* shaderProgram, const String& environment);
+
+    /** Load the program index written to the given cache path by previous runs.
+    @param cachePath The shader cache path.
+    */
+    void loadProgramIndex(const String& cachePath);
+
     /** Create GPU program based on the give CPU program.
     @param shaderProgram The CPU program instance.
-    @param programWriter The program writer instance.
+    @param prepared The structure hash and, unless the program is indexed, the source code of the program.
     @param language The target shader language.
     @param profiles The profiles string for program compilation.
-    @param profilesList The profiles string for program compilation as string list.
     @param cachePath The output path to write the program into.
     */
     GpuProgramPtr createGpuProgram(Program* shaderProgram, 
-        ProgramWriter* programWriter,
+        const ProgramSet::PreparedProgram& prepared,
         const String& language,
         const String& profiles,
         const String& cachePath);
@@ -198,6 +226,14 @@ private:
     GpuProgramsMap mVertexShaderMap;
     // The generated fragment shaders.
     GpuProgramsMap mFragmentShaderMap;
+    // Map between the structure hash of a CPU program and the name of the GPU program written for it.
+    std::map<String, String> mProgramIndex;
+    // The cache path the program index was loaded from.
+    String mProgramIndexPath;
+    // Guards the program writers and processors, which may be used by worker threads.
+    OGRE_WQ_MUTEX(mWriterMutex);
+    // Guards the program index.
+    OGRE_WQ_MUTEX(mIndexMutex);
     // The default program processors.
     ProgramProcessorList mDefaultProgramProcessors;
 
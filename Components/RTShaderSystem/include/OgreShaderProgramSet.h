@@ -65,6 +65,17 @@ private:
     void setCpuProgram(std::unique_ptr<Program>&& program);
     void setGpuProgram(const GpuProgramPtr& program);
 
+    /// structure hash and source code of a program, prepared ahead of creating the GPU program
+    struct PreparedProgram
+    {
+        String key;
+        String source;
+    };
+    PreparedProgram& getPreparedProgram(GpuProgramType type)
+    {
+        return type == GPT_VERTEX_PROGRAM ? mVSPreparedProgram : mPSPreparedProgram;
+    }
+
     // Vertex shader CPU program.
     std::unique_ptr<Program> mVSCpuProgram;
     // Fragment shader CPU program.
@@ -73,6 +84,12 @@ private:
     GpuProgramPtr mVSGpuProgram;
     // Fragment shader CPU program.
     GpuProgramPtr mPSGpuProgram;
+    // Vertex shader prepared by ProgramManager::prepareGpuPrograms.
+    PreparedProgram mVSPreparedProgram;
+    // Fragment shader prepared by ProgramManager::prepareGpuPrograms.
+    PreparedProgram mPSPreparedProgram;
+    // Whether the GPU programs were prepared.
+    bool mGpuProgramsPrepared;
 
     friend class ProgramManager;
     friend class TargetRenderState;
@@ -165,10 +165,18 @@ public:
     void addSubRenderStateInstance(SubRenderState* subRenderState);
 
     /** Acquire CPU/GPU programs set associated with the given render state and bind them to the pass.
+
+    Uses the CPU programs created by prepareGpuPrograms, if it was called before.
     @param pass The pass to bind the programs to.
     */
     void acquirePrograms(Pass* pass);
 
+    /** Create the CPU programs and write the source code of the GPU programs, without creating them.
+
+    Does not touch any pass or the render system, so it can be called on a worker thread.
+    */
+    void prepareGpuPrograms();
+
     /** Release CPU/GPU programs set associated with the given render state and pass.
     @param pass The pass to release the programs from.
     */
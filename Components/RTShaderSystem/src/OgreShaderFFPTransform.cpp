@@ -93,6 +93,7 @@ bool FFPTransform::createCpuSubPrograms(ProgramSet* programSet)
         }
 
         auto wMatrix = vsEntry->resolveInputParameter(mTexCoordIndex, GCT_MATRIX_3X4);
+        vsProgram->setInstancingIncluded(true, mTexCoordIndex - Parameter::SPC_TEXTURE_COORDINATE0);
         stage.callFunction(FFP_FUNC_TRANSFORM, wMatrix, positionIn, Out(positionIn).xyz());
 
         if(mDoLightCalculations)
@@ -143,6 +143,20 @@ int FunctionAtom::getGroupExecutionOrder() const
     return mGroupExecutionOrder;
 }
 
+//-----------------------------------------------------------------------------
+void FunctionAtom::_appendToKey(String& key) const
+{
+    key.append(mFunctionName).push_back('\0');
+
+    for (const auto& op : mOperands)
+    {
+        key.append(op.getParameter()->toString()).push_back('\0');
+        key.push_back(char(op.getSemantic()));
+        key.push_back(char(op.getMask()));
+        key.push_back(char(op.getIndirectionLevel()));
+    }
+}
+
 //-----------------------------------------------------------------------
 FunctionInvocation::FunctionInvocation(const String& functionName, int groupOrder,
                                        const String& returnType)
@@ -173,6 +187,15 @@ void FunctionInvocation::writeSourceCode(std::ostream& os, const String& targetL
     os << ");";
 }
 
+//-----------------------------------------------------------------------
+void FunctionInvocation::_appendToKey(String& key) const
+{
+    // the tags tell apart e.g. an AssignmentAtom from a call to a function named "assign"
+    key.push_back('F');
+    FunctionAtom::_appendToKey(key);
+    key.append(mReturnType).push_back('\0');
+}
+
 //-----------------------------------------------------------------------
 static String parameterNullMsg(const String& name, size_t pos)
 {
@@ -388,6 +411,12 @@ void AssignmentAtom::writeSourceCode(std::ostream& os, const String& targetLangu
     os << ";";
 }
 
+void AssignmentAtom::_appendToKey(String& key) const
+{
+    key.push_back('A');
+    FunctionAtom::_appendToKey(key);
+}
+
 SampleTextureAtom::SampleTextureAtom(const In& sampler, const In& texcoord, const Out& lhs, int groupOrder)
 {
     setOperands({sampler, texcoord, lhs});
@@ -431,6 +460,13 @@ void SampleTextureAtom::writeSourceCode(std::ostream& os, const String& targetLa
     os << ");";
 }
 
+void SampleTextureAtom::_appendToKey(String& key) const
+{
+    // the sampler type is part of the program parameters
+    key.push_back('S');
+    FunctionAtom::_appendToKey(key);
+}
+
 BinaryOpAtom::BinaryOpAtom(char op, const In& a, const In& b, const Out& dst, int groupOrder) {
     // do this backwards for compatibility with FFP_FUNC_ASSIGN calls
     setOperands({a, b, dst});
@@ -459,5 +495,12 @@ void BinaryOpAtom::writeSourceCode(std::ostream& os, const String& targetLanguag
     os << ";";
 }
 
+void BinaryOpAtom::_appendToKey(String& key) const
+{
+    key.push_back('B');
+    key.push_back(mOp);
+    FunctionAtom::_appendToKey(key);
+}
+
 }
 }
@@ -25,6 +25,7 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreShaderPrecompiledHeaders.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
 
@@ -109,6 +110,127 @@ protected:
     ShaderGenerator* mOwner;
 };
 
+/** Creates the CPU programs of passes and writes their source code on the WorkQueue. */
+class SGGenerationHandler : public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler,
+                            public RTShaderSystemAlloc
+{
+    struct Job
+    {
+        ShaderGenerator::SGPass* pass;
+        TargetRenderStatePtr renderState;
+        // held by the worker thread, so the render state is never destroyed there
+        OGRE_WQ_MUTEX(mutex);
+    };
+    typedef std::shared_ptr<Job> JobPtr;
+
+    std::map<ShaderGenerator::SGPass*, JobPtr> mPendingJobs;
+    uint16 mChannel;
+public:
+    SGGenerationHandler()
+    {
+        WorkQueue* wq = Root::getSingleton().getWorkQueue();
+        mChannel = wq->getChannel("Ogre/RTShaderGeneration");
+        wq->addRequestHandler(mChannel, this);
+        wq->addResponseHandler(mChannel, this);
+    }
+
+    ~SGGenerationHandler()
+    {
+        // the WorkQueue is gone along with Root, if the ShaderGenerator outlives it
+        if (WorkQueue* wq = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL)
+        {
+            wq->abortRequestsByChannel(mChannel);
+            // waits for the running requests
+            wq->removeRequestHandler(mChannel, this);
+            wq->removeResponseHandler(mChannel, this);
+        }
+
+        while (!mPendingJobs.empty())
+            cancel(mPendingJobs.begin()->first);
+    }
+
+    size_t getPendingCount() const { return mPendingJobs.size(); }
+
+    void request(ShaderGenerator::SGPass* pass, const TargetRenderStatePtr& renderState)
+    {
+        cancel(pass);
+
+        JobPtr job = std::make_shared<Job>();
+        job->pass = pass;
+        job->renderState = renderState;
+        mPendingJobs[pass] = job;
+
+        Root::getSingleton().getWorkQueue()->addRequest(mChannel, 0, job);
+    }
+
+    void cancel(ShaderGenerator::SGPass* pass)
+    {
+        auto it = mPendingJobs.find(pass);
+        if (it == mPendingJobs.end())
+            return;
+
+        // the request may still be queued, so keep the job, but drop its render state
+        JobPtr job = it->second;
+        mPendingJobs.erase(it);
+
+        OGRE_WQ_LOCK_MUTEX(job->mutex);
+        job->renderState.reset();
+    }
+
+    WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ) override
+    {
+        JobPtr job = any_cast<JobPtr>(req->getData());
+
+        OGRE_WQ_LOCK_MUTEX(job->mutex);
+        if (!job->renderState)
+            return OGRE_NEW WorkQueue::Response(req, false, Any(), "cancelled");
+
+        try
+        {
+            job->renderState->prepareGpuPrograms();
+        }
+        catch (Exception& e)
+        {
+            return OGRE_NEW WorkQueue::Response(req, false, Any(), e.getFullDescription());
+        }
+
+        return OGRE_NEW WorkQueue::Response(req, true, Any());
+    }
+
+    void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ) override
+    {
+        JobPtr job = any_cast<JobPtr>(res->getRequest()->getData());
+
+        // the pass was destroyed or built again meanwhile
+        auto it = mPendingJobs.find(job->pass);
+        if (it == mPendingJobs.end() || it->second != job)
+            return;
+
+        mPendingJobs.erase(it);
+
+        if (!res->succeeded())
+        {
+            // retry on the main thread, as if generating in the background was disabled
+            LogManager::getSingleton().logWarning(
+                "RTSS - generating programs in the background failed, retrying: " + res->getMessages());
+            job->renderState.reset();
+            try
+            {
+                job->pass->buildTargetRenderState(false);
+            }
+            catch (Exception& e)
+            {
+                LogManager::getSingleton().logError("RTSS - generating programs failed: " +
+                                                    e.getFullDescription());
+            }
+            return;
+        }
+
+        job->pass->_finishTargetRenderState(job->renderState);
+        job->renderState.reset();
+    }
+};
+
 String ShaderGenerator::DEFAULT_SCHEME_NAME     = "ShaderGeneratorDefaultScheme";
 String ShaderGenerator::SGTechnique::UserKey    = "SGTechnique";
 
@@ -129,7 +251,7 @@ ShaderGenerator& ShaderGenerator::getSingleton()
 ShaderGenerator::ShaderGenerator() :
     mActiveSceneMgr(NULL), mShaderLanguage(""),
     mFSLayer(0), mActiveViewportValid(false), mVSOutputCompactPolicy(VSOCP_LOW),
-    mCreateShaderOverProgrammablePass(false), mIsFinalizing(false)
+    mCreateShaderOverProgrammablePass(false), mIsFinalizing(false), mBackgroundGeneration(false)
 {
     mLightCount[0]              = 0;
     mLightCount[1]              = 0;
@@ -212,6 +334,8 @@ bool ShaderGenerator::_initialize()
 	mResourceGroupListener.reset(new SGResourceGroupListener(this));
 	ResourceGroupManager::getSingleton().addResourceGroupListener(mResourceGroupListener.get());
 
+    mGenerationHandler.reset(new SGGenerationHandler);
+
     return true;
 }
 
@@ -315,6 +439,9 @@ void ShaderGenerator::_destroy()
     }
     mTechniqueEntriesMap.clear();
 
+    // Wait for the programs generated in the background.
+    mGenerationHandler.reset();
+
     // Delete material entries.
     for (SGMaterialIterator itMat = mMaterialEntriesMap.begin(); itMat != mMaterialEntriesMap.end(); ++itMat)
     {       
@@ -1055,6 +1182,12 @@ void ShaderGenerator::preFindVisibleObjects(SceneManager* source,
     mActiveViewportValid = validateScheme(curMaterialScheme);
 }
 
+//-----------------------------------------------------------------------------
+size_t ShaderGenerator::getPendingGenerationCount() const
+{
+    return mGenerationHandler->getPendingCount();
+}
+
 //-----------------------------------------------------------------------------
 void ShaderGenerator::invalidateScheme(const String& schemeName)
 {
@@ -1433,11 +1566,14 @@ ShaderGenerator::SGPass::SGPass(SGTechnique* parent, Pass* srcPass, Pass* dstPas
 //-----------------------------------------------------------------------------
 ShaderGenerator::SGPass::~SGPass()
 {
+    if (auto handler = ShaderGenerator::getSingleton().mGenerationHandler.get())
+        handler->cancel(this);
+
     mDstPass->getUserObjectBindings().eraseUserAny(TargetRenderState::UserKey);
 }
 
 //-----------------------------------------------------------------------------
-void ShaderGenerator::SGPass::buildTargetRenderState()
+void ShaderGenerator::SGPass::buildTargetRenderState(bool inBackground)
 {   
     if(mSrcPass->isProgrammable() && !mParent->overProgrammablePass() && !isIlluminationPass()) return;
     const String& schemeName = mParent->getDestinationTechniqueSchemeName();
@@ -1479,8 +1615,29 @@ void ShaderGenerator::SGPass::buildTargetRenderState()
 #ifdef RTSHADER_SYSTEM_BUILD_CORE_SHADERS
     // Build the FFP state.
     FFPRenderStateBuilder::buildRenderState(this, targetRenderState.get());
+
+    if (inBackground)
+    {
+        // Use a simple render state until the programs are generated.
+        auto simpleRenderState = std::make_shared<TargetRenderState>();
+        simpleRenderState->link({"FFP_Transform", "FFP_Colour"}, mSrcPass, mDstPass);
+        simpleRenderState->acquirePrograms(mDstPass);
+        mDstPass->getUserObjectBindings().setUserAny(TargetRenderState::UserKey, simpleRenderState);
+
+        ShaderGenerator::getSingleton().mGenerationHandler->request(this, targetRenderState);
+        return;
+    }
 #endif
 
+    _finishTargetRenderState(targetRenderState);
+}
+
+//-----------------------------------------------------------------------------
+void ShaderGenerator::SGPass::_finishTargetRenderState(const TargetRenderStatePtr& targetRenderState)
+{
+    // Release the programs of the simple render state first, as releasing resets the pass programs.
+    mDstPass->getUserObjectBindings().eraseUserAny(TargetRenderState::UserKey);
+
     targetRenderState->acquirePrograms(mDstPass);
     mDstPass->getUserObjectBindings().setUserAny(TargetRenderState::UserKey, targetRenderState);
 }
@@ -1619,7 +1776,7 @@ void ShaderGenerator::SGTechnique::destroySGPasses()
 }
 
 //-----------------------------------------------------------------------------
-void ShaderGenerator::SGTechnique::buildTargetRenderState()
+void ShaderGenerator::SGTechnique::buildTargetRenderState(bool inBackground)
 {
     // Remove existing destination technique and passes
     // in order to build it again from scratch.
@@ -1650,7 +1807,7 @@ void ShaderGenerator::SGTechnique::buildTargetRenderState()
     for (SGPassIterator itPass = mPassEntries.begin(); itPass != mPassEntries.end(); ++itPass)
     {
 		assert(!(*itPass)->isIlluminationPass()); // this is not so important, but intended to be so here.
-        (*itPass)->buildTargetRenderState();
+        (*itPass)->buildTargetRenderState(inBackground);
     }
 
     // Turn off the build destination technique flag.
@@ -1803,11 +1960,13 @@ void ShaderGenerator::SGScheme::validate()
     if (mOutOfDate == false)
         return;
 
+    bool inBackground = ShaderGenerator::getSingleton().getBackgroundGeneration();
+
     // Build render state for each technique and acquire GPU programs.
     for (SGTechnique* curTechEntry : mTechniqueEntries)
     {
         if (curTechEntry->getBuildDestinationTechnique())
-            curTechEntry->buildTargetRenderState();
+            curTechEntry->buildTargetRenderState(inBackground);
     }
     
     // Mark this scheme as up to date.
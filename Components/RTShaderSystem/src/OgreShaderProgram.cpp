@@ -37,6 +37,8 @@ Program::Program(GpuProgramType type)
     // all programs must have an entry point
     mEntryPointFunction = new Function();
     mSkeletalAnimation  = false;
+    mInstancing         = false;
+    mInstancingTexCoordIndex = -1;
     mColumnMajorMatrices = true;
 }
 
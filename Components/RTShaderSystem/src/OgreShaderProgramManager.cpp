@@ -34,6 +34,9 @@ RTShader::ProgramManager* Singleton<RTShader::ProgramManager>::msSingleton = 0;
 
 namespace RTShader {
 
+/// file in the shader cache path, mapping the structure hash of a program to the cached program
+static const char* PROGRAM_INDEX_FILE = "RTShaderProgramIndex.txt";
+
 
 //-----------------------------------------------------------------------
 ProgramManager* ProgramManager::getSingletonPtr()
@@ -195,8 +198,11 @@ void ProgramManager::destroyProgramWriters()
 }
 
 //-----------------------------------------------------------------------------
-void ProgramManager::createGpuPrograms(ProgramSet* programSet)
+void ProgramManager::prepareGpuPrograms(ProgramSet* programSet)
 {
+    // The processors and writers keep state while processing a program set
+    OGRE_WQ_LOCK_MUTEX(mWriterMutex);
+
     // Before we start we need to make sure that the pixel shader input
     //  parameters are the same as the vertex output, this required by 
     //  shader models 4 and 5.
@@ -208,8 +214,60 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
         synchronizePixelnToBeVertexOut(programSet);
     }
 
-    // Grab the matching writer.
     const String& language = ShaderGenerator::getSingleton().getTargetLanguage();
+    const String& cachePath = ShaderGenerator::getSingleton().getShaderCachePath();
+
+    ProgramProcessorIterator itProcessor = mProgramProcessorsMap.find(language);
+
+    if (itProcessor == mProgramProcessorsMap.end())
+    {
+        OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM,
+            "Could not find processor for language '" + language,
+            "ProgramManager::prepareGpuPrograms");
+    }
+
+    // Call the pre creation of GPU programs method.
+    if (!itProcessor->second->preCreateGpuPrograms(programSet))
+        OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "preCreateGpuPrograms failed");
+
+    for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
+    {
+        Program* shaderProgram = programSet->getCpuProgram(type);
+        const String& profiles = ShaderGenerator::getSingleton().getShaderProfiles(type);
+
+        // The written source also depends on the capabilities of the render system, e.g. the GLSL version
+        String environment = language + " " + profiles;
+        if (auto rs = Root::getSingleton().getRenderSystem())
+        {
+            for (const auto& syntax : rs->getCapabilities()->getSupportedShaderProfiles())
+                environment += " " + syntax;
+        }
+
+        // Look up the program by its structure first, so known programs skip writing the source code
+        ProgramSet::PreparedProgram& prepared = programSet->getPreparedProgram(type);
+        prepared.key = generateHash(shaderProgram, environment);
+
+        bool indexed;
+        {
+            OGRE_WQ_LOCK_MUTEX(mIndexMutex);
+            if (!cachePath.empty())
+                loadProgramIndex(cachePath);
+            indexed = mProgramIndex.find(prepared.key) != mProgramIndex.end();
+        }
+
+        if (!indexed)
+            prepared.source = writeSourceCode(shaderProgram, language);
+    }
+
+    programSet->mGpuProgramsPrepared = true;
+}
+
+//-----------------------------------------------------------------------------
+String ProgramManager::writeSourceCode(Program* shaderProgram, const String& language)
+{
+    OGRE_WQ_LOCK_MUTEX(mWriterMutex);
+
+    // Grab the matching writer.
     ProgramWriterIterator itWriter = mProgramWritersMap.find(language);
     ProgramWriter* programWriter = NULL;
 
@@ -224,27 +282,27 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
         programWriter = itWriter->second;
     }
 
-    ProgramProcessorIterator itProcessor = mProgramProcessorsMap.find(language);
-    ProgramProcessor* programProcessor = NULL;
+    std::stringstream sourceCodeStringStream;
 
-    if (itProcessor == mProgramProcessorsMap.end())
-    {
-        OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM,
-            "Could not find processor for language '" + language,
-            "ProgramManager::createGpuPrograms");       
-    }
+    // Generate source code.
+    programWriter->writeSourceCode(sourceCodeStringStream, shaderProgram);
+    return sourceCodeStringStream.str();
+}
+
+//-----------------------------------------------------------------------------
+void ProgramManager::createGpuPrograms(ProgramSet* programSet)
+{
+    // The CPU programs may have been prepared on a worker thread already
+    if (!programSet->mGpuProgramsPrepared)
+        prepareGpuPrograms(programSet);
+
+    const String& language = ShaderGenerator::getSingleton().getTargetLanguage();
 
-    programProcessor = itProcessor->second;
-    
-    // Call the pre creation of GPU programs method.
-    if (!programProcessor->preCreateGpuPrograms(programSet))
-        OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "preCreateGpuPrograms failed");
-    
     // Create the shader programs
     for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
     {
-        auto gpuProgram = createGpuProgram(programSet->getCpuProgram(type), programWriter, language,
-                                           ShaderGenerator::getSingleton().getShaderProfiles(type),
+        auto gpuProgram = createGpuProgram(programSet->getCpuProgram(type), programSet->getPreparedProgram(type),
+                                           language, ShaderGenerator::getSingleton().getShaderProfiles(type),
                                            ShaderGenerator::getSingleton().getShaderCachePath());
 
         OgreAssert(gpuProgram, "gpu program could not be created");
@@ -254,81 +312,130 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
     //update flags
     programSet->getGpuProgram(GPT_VERTEX_PROGRAM)->setSkeletalAnimationIncluded(
         programSet->getCpuProgram(GPT_VERTEX_PROGRAM)->getSkeletalAnimationIncluded());
+    programSet->getGpuProgram(GPT_VERTEX_PROGRAM)->setInstancingIncluded(
+        programSet->getCpuProgram(GPT_VERTEX_PROGRAM)->getInstancingIncluded(),
+        programSet->getCpuProgram(GPT_VERTEX_PROGRAM)->getInstancingTexCoordIndex());
 
     // Call the post creation of GPU programs method.
-    if(!programProcessor->postCreateGpuPrograms(programSet))
+    if(!mProgramProcessorsMap.find(language)->second->postCreateGpuPrograms(programSet))
         OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "postCreateGpuPrograms failed");
 }
 
 //-----------------------------------------------------------------------------
 GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram, 
-                                               ProgramWriter* programWriter,
+                                               const ProgramSet::PreparedProgram& prepared,
                                                const String& language,
                                                const String& profiles,
                                                const String& cachePath)
 {
-    std::stringstream sourceCodeStringStream;
+    const String& programKey = prepared.key;
+    String programName;
+    String source = prepared.source;
+    HighLevelGpuProgramPtr pGpuProgram;
 
-    // Generate source code.
-    programWriter->writeSourceCode(sourceCodeStringStream, shaderProgram);
-    String source = sourceCodeStringStream.str();
-
-    // Generate program name.
-    String programName = generateHash(source, shaderProgram->getPreprocessorDefines());
-
-    if (shaderProgram->getType() == GPT_VERTEX_PROGRAM)
+    String indexedName;
     {
-        programName += "_VS";
+        OGRE_WQ_LOCK_MUTEX(mIndexMutex);
+        auto itIndex = mProgramIndex.find(programKey);
+        if (itIndex != mProgramIndex.end())
+            indexedName = itIndex->second;
     }
-    else if (shaderProgram->getType() == GPT_FRAGMENT_PROGRAM)
+
+    if (!indexedName.empty())
     {
-        programName += "_FS";
-    }
+        // Try to get program by name.
+        pGpuProgram = HighLevelGpuProgramManager::getSingleton().getByName(
+            indexedName, ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME);
 
-    // Try to get program by name.
-    HighLevelGpuProgramPtr pGpuProgram =
-        HighLevelGpuProgramManager::getSingleton().getByName(
-            programName, ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME);
+        if (pGpuProgram)
+            return static_pointer_cast<GpuProgram>(pGpuProgram);
 
-    if(pGpuProgram) {
-        return static_pointer_cast<GpuProgram>(pGpuProgram);
+        // use the program file written by a previous run, if it is still there
+        if (source.empty() && !cachePath.empty())
+        {
+            std::ifstream programFile((cachePath + indexedName + "." + language).c_str());
+            if (programFile)
+            {
+                StringStream buffer;
+                programFile >> buffer.rdbuf();
+                source = buffer.str();
+                programName = indexedName;
+            }
+        }
     }
 
-    // Case the program doesn't exist yet.
-    // Create new GPU program.
-    pGpuProgram = HighLevelGpuProgramManager::getSingleton().createProgram(programName,
-        ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME, language, shaderProgram->getType());
-
-    // Case cache directory specified -> create program from file.
-    if (!cachePath.empty())
+    if (programName.empty())
     {
-        const String  programFullName = programName + "." + language;
-        const String  programFileName = cachePath + programFullName;
-        std::ifstream programFile;
+        // Generate source code, unless it was prepared already.
+        if (source.empty())
+            source = writeSourceCode(shaderProgram, language);
 
-        // Check if program file already exist.
-        programFile.open(programFileName.c_str());
+        // Generate program name.
+        programName = generateHash(source, shaderProgram->getPreprocessorDefines());
 
-        // Case we have to write the program to a file.
-        if (!programFile)
+        if (shaderProgram->getType() == GPT_VERTEX_PROGRAM)
+        {
+            programName += "_VS";
+        }
+        else if (shaderProgram->getType() == GPT_FRAGMENT_PROGRAM)
         {
-            std::ofstream outFile(programFileName.c_str());
+            programName += "_FS";
+        }
+
+        // Try to get program by name.
+        pGpuProgram = HighLevelGpuProgramManager::getSingleton().getByName(
+            programName, ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME);
 
-            if (!outFile)
-                return GpuProgramPtr();
+        OGRE_WQ_LOCK_MUTEX(mIndexMutex);
 
-            outFile << source;
-            outFile.close();
+        if (pGpuProgram)
+        {
+            mProgramIndex[programKey] = programName;
+            return static_pointer_cast<GpuProgram>(pGpuProgram);
         }
-        else
+
+        // Case cache directory specified -> create program from file.
+        if (!cachePath.empty())
         {
-            // use program file version
-            StringStream buffer;
-            programFile >> buffer.rdbuf();
-            source = buffer.str();
+            const String  programFullName = programName + "." + language;
+            const String  programFileName = cachePath + programFullName;
+            std::ifstream programFile;
+
+            // Check if program file already exist.
+            programFile.open(programFileName.c_str());
+
+            // Case we have to write the program to a file.
+            if (!programFile)
+            {
+                std::ofstream outFile(programFileName.c_str());
+
+                if (!outFile)
+                    return GpuProgramPtr();
+
+                outFile << source;
+                outFile.close();
+            }
+            else
+            {
+                // use program file version
+                StringStream buffer;
+                programFile >> buffer.rdbuf();
+                source = buffer.str();
+            }
+
+            // remember the program for the next runs
+            std::ofstream indexFile((cachePath + PROGRAM_INDEX_FILE).c_str(), std::ios::app);
+            indexFile << programKey << " " << programName << "\n";
         }
+
+        mProgramIndex[programKey] = programName;
     }
 
+    // Case the program doesn't exist yet.
+    // Create new GPU program.
+    pGpuProgram = HighLevelGpuProgramManager::getSingleton().createProgram(programName,
+        ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME, language, shaderProgram->getType());
+
     pGpuProgram->setSource(source);
     pGpuProgram->setParameter("preprocessor_defines", shaderProgram->getPreprocessorDefines());
     pGpuProgram->setParameter("entry_point", "main");
@@ -379,6 +486,62 @@ String ProgramManager::generateHash(const String& programString, const String& d
     return StringUtil::format("%08x%08x%08x%08x", hash[0], hash[1], hash[2], hash[3]);
 }
 
+//-----------------------------------------------------------------------------
+template<typename ParameterList>
+static void appendParametersToKey(String& key, const ParameterList& parameters)
+{
+    for (const auto& param : parameters)
+    {
+        key.append(param->toString()).push_back('\0');
+
+        uint32 desc[] = {uint32(param->getType()), uint32(param->getSemantic()), uint32(param->getIndex()),
+                         uint32(param->getContent()), uint32(param->getSize())};
+        key.append((const char*)desc, sizeof(desc));
+    }
+}
+
+//-----------------------------------------------------------------------------
+String ProgramManager::generateHash(Program* shaderProgram, const String& environment)
+{
+    // Collect everything the program writers read into a binary key. This is much cheaper than
+    // writing the source code, as no code has to be formatted.
+    String key = environment;
+    key.push_back('\0');
+    key.push_back(char(shaderProgram->getType()));
+    key.push_back(char(shaderProgram->getUseColumnMajorMatrices()));
+
+    for (unsigned int i = 0; i < shaderProgram->getDependencyCount(); ++i)
+        key.append(shaderProgram->getDependency(i)).push_back('\0');
+
+    appendParametersToKey(key, shaderProgram->getParameters());
+
+    Function* main = shaderProgram->getMain();
+    appendParametersToKey(key, main->getInputParameters());
+    appendParametersToKey(key, main->getOutputParameters());
+    appendParametersToKey(key, main->getLocalParameters());
+
+    for (const auto* atom : main->getAtomInstances())
+        atom->_appendToKey(key);
+
+    return generateHash(key, shaderProgram->getPreprocessorDefines());
+}
+
+//-----------------------------------------------------------------------------
+void ProgramManager::loadProgramIndex(const String& cachePath)
+{
+    if (mProgramIndexPath == cachePath)
+        return;
+
+    mProgramIndexPath = cachePath;
+
+    std::ifstream indexFile((cachePath + PROGRAM_INDEX_FILE).c_str());
+    String programKey, programName;
+    while (indexFile >> programKey >> programName)
+    {
+        mProgramIndex[programKey] = programName;
+    }
+}
+
 
 //-----------------------------------------------------------------------------
 void ProgramManager::addProgramProcessor(ProgramProcessor* processor)
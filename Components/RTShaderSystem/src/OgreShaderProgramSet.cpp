@@ -31,7 +31,7 @@ namespace Ogre {
 namespace RTShader {
 
 //-----------------------------------------------------------------------------
-ProgramSet::ProgramSet() {}
+ProgramSet::ProgramSet() : mGpuProgramsPrepared(false) {}
 
 //-----------------------------------------------------------------------------
 ProgramSet::~ProgramSet() {}
@@ -144,7 +144,8 @@ void TargetRenderState::bindUniformParameters(Program* pCpuProgram, const GpuPro
 
 void TargetRenderState::acquirePrograms(Pass* pass)
 {
-    createCpuPrograms();
+    if (!mProgramSet)
+        createCpuPrograms();
 
     const char* matName = pass->getParent()->getParent()->getName().c_str();
 
@@ -180,6 +181,12 @@ void TargetRenderState::acquirePrograms(Pass* pass)
 }
 
 
+void TargetRenderState::prepareGpuPrograms()
+{
+    createCpuPrograms();
+    ProgramManager::getSingleton().prepareGpuPrograms(mProgramSet.get());
+}
+
 void TargetRenderState::releasePrograms(Pass* pass)
 {
     if(!mProgramSet)
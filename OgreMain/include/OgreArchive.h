@@ -130,6 +130,13 @@ namespace Ogre {
         */
         virtual bool isReadOnly() const { return mReadOnly; }
 
+        /** Reports whether files can be opened and read from several threads at once.
+        @remarks
+            Archives sharing a handle between their streams must return false, which
+            is the default, so that they are only accessed from one thread at a time.
+        */
+        virtual bool isThreadSafe() const { return false; }
+
         /** Open a stream on a given file. 
         @note
             There is no equivalent 'close' method; the returned stream
@@ -368,6 +368,10 @@ namespace Ogre {
         /** All techniques are forced to one weight per vertex. */
         IM_FORCEONEWEIGHT = 0x0020,
 
+        /** Bake all skeletal animations into a shared vertex texture at load time (HW VTF only).
+        Instances only upload their world transform and current frame.*/
+        IM_VTFBAKEDANIMATION = 0x0040,
+
         IM_USEALL       = IM_USE16BIT|IM_VTFBESTFIT|IM_USEONEWEIGHT
     };
     
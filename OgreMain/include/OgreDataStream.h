@@ -360,6 +360,60 @@ namespace Ogre {
         void setFreeOnClose(bool free) { mFreeOnClose = free; }
     };
 
+    /** Common subclass of DataStream for read-only access to memory mapped files.
+    @remarks
+        Instead of reading the file into a buffer, it is mapped into the address
+        space, so only the pages that are accessed get loaded. As this is a
+        MemoryDataStream, getPtr gives zero copy access to the contents.
+    @par
+        Streams created on a range of the file share the mapping, which is
+        released when the last of them is closed. The file must not be modified
+        while it is mapped: truncating it raises SIGBUS on access on POSIX systems,
+        while Windows refuses to delete or replace it.
+    @par
+        Because of that, archives only map files of at least getMinMappedSize() bytes,
+        where avoiding the copy pays off. Smaller files are read as before.
+    */
+    class _OgreExport MemoryMappedDataStream : public MemoryDataStream
+    {
+    private:
+        /// Keeps the mapping alive, shared by all streams on the same file
+        SharedPtr<void> mMapping;
+
+        MemoryMappedDataStream(const String& name, const SharedPtr<void>& mapping, uchar* data,
+                               size_t size);
+    public:
+        /** Create a stream on a range of an existing mapping
+        @param name The name to give the stream
+        @param source The stream holding the mapping
+        @param offset The offset of the range in bytes
+        @param size The size of the range in bytes
+        */
+        MemoryMappedDataStream(const String& name, MemoryMappedDataStream& source, size_t offset,
+                               size_t size);
+
+        /** Map the given file
+        @param path The path of the file to map
+        @param name The name to give the stream, defaults to the path
+        @param minSize Files smaller than this are not mapped
+        @return a null pointer if the file cannot be mapped, e.g. because it is empty, smaller than
+            minSize or memory mapping is not supported on this platform
+        */
+        static SharedPtr<MemoryMappedDataStream> open(const String& path, const String& name = "",
+                                                      size_t minSize = 0);
+
+        /// Set the size in bytes from which archives map files instead of reading them.
+        /// The default is 1MB, std::numeric_limits<size_t>::max() disables mapping.
+        static void setMinMappedSize(size_t size);
+
+        /// Get the size in bytes from which archives map files
+        static size_t getMinMappedSize();
+
+        /** @copydoc DataStream::close
+        */
+        void close(void);
+    };
+
     /** Common subclass of DataStream for handling data from 
         std::basic_istream.
     */
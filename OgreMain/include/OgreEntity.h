@@ -216,6 +216,40 @@ namespace Ogre {
         */
         bool cacheBoneMatrices(void);
 
+        /// LOD values (in mesh LOD strategy units) at which the skeleton update rate is reduced.
+        std::vector<Real> mAnimationLodValues;
+        /// Local transform of a bone, as evaluated by a reduced rate update.
+        struct AnimationLodBonePose
+        {
+            Vector3 position;
+            Quaternion orientation;
+            Vector3 scale;
+        };
+        /// Bone poses of the previous and the last reduced rate update, kept while objects are attached to bones.
+        std::vector<AnimationLodBonePose> mAnimationLodPoses;
+        /// Bone matrices of the previous and the last reduced rate update, used for extrapolation.
+        std::vector<Affine3> mAnimationLodMatrices;
+        /// Records the last frame in which the skeleton was evaluated at a reduced rate.
+        unsigned long mFrameAnimationLodLastEvaluated;
+        /// Records the frame of the reduced rate update before the last one.
+        unsigned long mFrameAnimationLodPrevEvaluated;
+        /// The animation LOD level, calculated by _notifyCurrentCamera. Level n updates every (n+1)th frame.
+        ushort mAnimationLodIndex;
+        /// Whether to interpolate bone matrices between reduced rate updates.
+        bool mAnimationLodInterpolation;
+        /// Time step used to quantize animation times for the skeleton evaluation cache, 0 if disabled.
+        Real mSkeletonEvaluationCacheQuantum;
+
+        /// Whether the skeleton has to be evaluated in the given frame according to the animation LOD.
+        bool isAnimationLodUpdateDue(unsigned long frameNumber) const;
+        /// Stores the bone matrices (and poses) just evaluated by a reduced rate update.
+        void storeAnimationLodPose(unsigned long frameNumber);
+        /** Extrapolates the last two reduced rate updates to the given frame.
+        @return
+            True if the bone matrices were updated.
+        */
+        bool extrapolateAnimationLodPose(unsigned long frameNumber);
+
         /** Flag indicating whether hardware animation is supported by this entities materials
             data is saved per scehme number.
         */
@@ -525,7 +559,51 @@ namespace Ogre {
             LOD will be limited by the number of LOD indexes used in the Material).
         */
         void setMaterialLodBias(Real factor, ushort maxDetailIndex = 0, ushort minDetailIndex = 99);
+
+        /** Sets the levels of detail at which the skeleton of this entity is updated at a reduced rate.
+        @remarks
+            Evaluating the skeleton of a distant entity every frame is mostly wasted, as the motion
+            is hardly noticeable on screen. Using the value of the Mesh LOD strategy (including the
+            mesh LOD bias), the skeleton is only evaluated every (n+1)th frame at animation LOD level n.
+            Optionally the bone matrices are extrapolated from the last two evaluations in between,
+            so the motion stays smooth without lagging behind, at a fraction of the cost of evaluating
+            the skeleton. The bones of the SkeletonInstance keep the last evaluated pose then, unless
+            objects are attached to them: in that case the bone positions, orientations and scales
+            are extrapolated instead and the matrices derived from them, so tag points follow.
+        @par
+            Frames are never skipped while manual bones are dirty or while the SkeletonInstance is
+            shared with other entities.
+        @param lodValues
+            The LOD values at which the next level starts, in the user units of the Mesh LOD strategy
+            (e.g. distances for the distance strategy). An empty list disables animation LOD.
+        @param interpolate
+            Whether to extrapolate the bone poses between reduced rate updates.
+        */
+        void setAnimationLodLevels(const std::vector<Real>& lodValues, bool interpolate = true);
 #endif
+        /** Returns the current animation LOD level, 0 meaning the skeleton is updated every frame.
+        */
+        ushort getCurrentAnimationLodIndex() const { return mAnimationLodIndex; }
+
+        /** Shares evaluated bone matrices with other entities using the same skeleton.
+        @remarks
+            In crowds, many entities play the same animations at nearly the same time positions.
+            With a non-zero quantum, the time positions of the enabled animations are rounded to
+            multiples of it, and the skeleton is evaluated at the rounded times. Entities whose
+            animations, rounded times and weights match within a frame then reuse the bone
+            matrices of the first one evaluated, which are kept in the Skeleton, instead of
+            evaluating their own SkeletonInstance.
+        @par
+            The bones of the SkeletonInstance are not updated when cached matrices are used. Hence
+            the cache is bypassed for entities with objects attached to bones, manually controlled
+            bones, blend masks, a displayed or shared skeleton, skeleton based bounds and while the
+            animation LOD reduces the update rate.
+        @param quantum
+            Time step in seconds, 0 disables the cache (the default).
+        */
+        void setSkeletonEvaluationCacheQuantum(Real quantum) { mSkeletonEvaluationCacheQuantum = quantum; }
+        /// @copydoc setSkeletonEvaluationCacheQuantum
+        Real getSkeletonEvaluationCacheQuantum() const { return mSkeletonEvaluationCacheQuantum; }
         /** Sets whether the polygon mode of this entire entity may be
             overridden by the camera detail settings.
         */
@@ -86,6 +86,10 @@ namespace Ogre {
     bool mMorphAnimation;
     /// Does this (vertex) program require support for vertex texture fetch?
     bool mVertexTextureFetch;
+    /// Does this (vertex) program read the world matrix per instance?
+    bool mInstancing;
+    /// First texture coordinate of the instance world matrix, -1 for the next free one
+    int mInstancingTexCoordIndex;
     /// Does this (geometry) program require adjacency information?
     bool mNeedsAdjacencyInfo;
     /// Did we encounter a compilation error?
@@ -256,6 +260,33 @@ namespace Ogre {
     */
     virtual bool isVertexTextureFetchRequired(void) const { return mVertexTextureFetch; }
 
+    /** Sets whether a vertex program reads the world matrix of each instance
+        from the vertex stream.
+        @remarks
+        If this is set to true, the SceneManager draws renderables sharing their geometry
+        as instances of one draw call. The 3x4 world matrix of each instance is passed in
+        3 consecutive texture coordinates, while the world matrix auto constants are identity.
+        @param included whether the program reads the world matrix per instance
+        @param texCoordIndex the first texture coordinate the program reads the matrix from.
+        -1 means following the ones of the geometry, the same way as with
+        InstanceManager::HWInstancingBasic.
+    */
+    virtual void setInstancingIncluded(bool included, int texCoordIndex = -1)
+    {
+        mInstancing = included;
+        mInstancingTexCoordIndex = texCoordIndex;
+    }
+    /** Returns whether a vertex program reads the world matrix of each instance
+        from the vertex stream.
+        @see setInstancingIncluded
+    */
+    virtual bool isInstancingIncluded(void) const { return mInstancing; }
+    /** Returns the first texture coordinate the world matrix of each instance is read from,
+        or -1 if it follows the ones of the geometry.
+        @see setInstancingIncluded
+    */
+    virtual int getInstancingTexCoordIndex(void) const { return mInstancingTexCoordIndex; }
+
     /// @deprecated use OT_DETAIL_ADJACENCY_BIT
     OGRE_DEPRECATED virtual void setAdjacencyInfoRequired(bool r) { mNeedsAdjacencyInfo = r; }
     /// @deprecated use OT_DETAIL_ADJACENCY_BIT
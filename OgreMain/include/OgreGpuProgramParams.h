@@ -1265,6 +1265,29 @@ namespace Ogre {
         /// physical index for active pass iteration parameter real constant entry;
         size_t mActivePassIterationIndex;
 
+        /// writes an auto constant, that is a plain copy of an AutoParamDataSource value
+        typedef void (*AutoConstantCopy)(GpuProgramParameters& params, const AutoConstantEntry& entry,
+                                         const AutoParamDataSource* source);
+        struct AutoConstantOp
+        {
+            /// index into mAutoConstants
+            uint32 entry;
+            /// set, if the constant does not need to go through the generic update
+            AutoConstantCopy copy;
+        };
+        struct AutoConstantGroup
+        {
+            uint16 variability;
+            uint32 begin;
+            uint32 end;
+        };
+        /// auto constants ordered by variability, so an update only visits the matching ones
+        std::vector<AutoConstantOp> mAutoConstantPlan;
+        std::vector<AutoConstantGroup> mAutoConstantGroups;
+        bool mAutoConstantPlanDirty;
+        /// rebuild the update plan after the auto constants changed
+        void buildAutoConstantPlan();
+
         /// Return the variability for an auto constant
         static uint16 deriveVariability(AutoConstantType act);
 
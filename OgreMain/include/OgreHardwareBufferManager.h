@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "OgreHardwareIndexBuffer.h"
 #include "OgreHardwareVertexBuffer.h"
 #include "Threading/OgreThreadHeaders.h"
+#include <deque>
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -97,6 +98,103 @@ namespace Ogre {
     };
 
 
+    /** Sub-allocates per frame data from a single, large hardware buffer
+
+        The space is appended behind the previous allocation and only reused once the frame that
+        wrote it is getFramesInFlight() frames old. HardwareBuffer has no fence API, so this frame
+        count acts as the fence for the GPU reading it, which lets users write with
+        HardwareBuffer::HBL_NO_OVERWRITE instead of relying on the driver renaming the storage.
+    */
+    class _OgreExport HardwareBufferRing : public BufferAlloc
+    {
+        HardwareBufferPtr mBuffer;
+        /// next byte to write to
+        size_t mHead;
+        /// frame numbers along with the first byte they wrote, oldest first
+        std::deque<std::pair<uint32, size_t> > mFences;
+        uint32 mFramesInFlight;
+    public:
+        /**
+        @param buffer the buffer to sub-allocate from
+        @param framesInFlight number of frames the GPU may lag behind
+        */
+        HardwareBufferRing(const HardwareBufferPtr& buffer, uint32 framesInFlight);
+
+        /** Reserve room in the ring
+        @param size the number of bytes to write
+        @param alignment required alignment of the returned offset
+        @param frame the number of the current frame, e.g. Root::getNextFrameNumber
+        @return the offset of the room, or -1 if the ring is out of space
+        */
+        size_t allocate(size_t size, size_t alignment, uint32 frame);
+
+        const HardwareBufferPtr& getBuffer() const { return mBuffer; }
+        uint32 getFramesInFlight() const { return mFramesInFlight; }
+    };
+
+    /** Sub-allocates shader constants from a single, large uniform buffer
+
+        Each draw writes its constants into the room of the current frame and the RenderSystem
+        only has to bind the buffer at the returned offset, see HardwareBufferRing.
+        The data is written with HardwareBuffer::writeData, so the buffer is not mapped per draw.
+    */
+    class _OgreExport UniformBufferRing : public HardwareBufferRing
+    {
+        size_t mAlignment;
+    public:
+        /**
+        @param sizeBytes size of the whole ring
+        @param alignment required alignment of the offsets, e.g. GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+        @param framesInFlight number of frames the GPU may lag behind
+        @param mgr the manager to create the buffer with, the HardwareBufferManager if NULL
+        */
+        UniformBufferRing(size_t sizeBytes, size_t alignment, uint32 framesInFlight = 3,
+                          HardwareBufferManagerBase* mgr = NULL);
+
+        /** copies the data into the ring
+        @param data the constants to write
+        @param size the number of bytes to write
+        @param frame the number of the current frame, e.g. Root::getNextFrameNumber
+        @return the offset the data was written to, or -1 if the ring is out of space
+        */
+        size_t write(const void* data, size_t size, uint32 frame);
+
+        size_t getAlignment() const { return mAlignment; }
+    };
+
+    /** Sub-allocates per frame vertex data from a single, large vertex buffer
+
+        Instead of discarding a dynamic buffer of their own on every update, users lock room for the
+        vertices of the current frame and render them with VertexData::vertexStart pointing at it,
+        see HardwareBufferRing. If there is no such space left, lock() fails and the caller falls
+        back to its own buffer.
+    */
+    class _OgreExport VertexBufferRing : public HardwareBufferRing
+    {
+        HardwareVertexBufferSharedPtr mBuffer;
+    public:
+        /**
+        @param vertexSize size of a vertex in bytes, shared by all users of the ring
+        @param numVertices capacity of the ring
+        @param framesInFlight number of frames the GPU may lag behind
+        @param mgr the manager to create the buffer with, the HardwareBufferManager if NULL
+        */
+        VertexBufferRing(size_t vertexSize, size_t numVertices, uint32 framesInFlight = 3,
+                         HardwareBufferManagerBase* mgr = NULL);
+
+        /** Lock room for the given number of vertices
+        @param numVertices the number of vertices to write
+        @param frame the number of the current frame, e.g. Root::getNextFrameNumber
+        @param[out] vertexStart the first vertex of the room, to be used as VertexData::vertexStart
+        @return the memory to write the vertices to, or NULL if the ring is out of space. Call
+        unlock() once done writing to it.
+        */
+        void* lock(size_t numVertices, uint32 frame, size_t& vertexStart);
+        void unlock() { mBuffer->unlock(); }
+
+        const HardwareVertexBufferSharedPtr& getBuffer() const { return mBuffer; }
+    };
+
     /** Base definition of a hardware buffer manager.
     @remarks
         This class is deliberately not a Singleton, so that multiple types can 
@@ -193,6 +291,12 @@ namespace Ogre {
         // Mutexes
         OGRE_MUTEX(mTempBuffersMutex);
 
+        /// Shared rings for per frame vertex data, by vertex size
+        std::map<size_t, std::unique_ptr<VertexBufferRing> > mDynamicVertexRings;
+        /// Size of each ring in bytes, 0 if disabled
+        size_t mDynamicVertexRingSize;
+        uint32 mDynamicVertexRingFramesInFlight;
+
 
         /// Creates a new buffer as a copy of the source, does not copy data.
         virtual HardwareVertexBufferSharedPtr makeBufferCopy(
@@ -391,6 +495,30 @@ namespace Ogre {
 
         /// Notification that a hardware vertex buffer has been destroyed.
         void _notifyVertexBufferDestroyed(HardwareVertexBuffer* buf);
+
+        /** Get the shared ring for per frame vertex data of the given vertex size.
+        @remarks
+            Used by BillboardSet and similar to avoid discarding buffers of their own on
+            every update. The ring is created on first use.
+        @return NULL if the rings are disabled
+        */
+        VertexBufferRing* getDynamicVertexRing(size_t vertexSize);
+
+        /** Set the size in bytes of each dynamic vertex ring.
+        @remarks
+            The default of 0 disables the rings. Only affects rings created afterwards.
+        @param bytes size of each ring
+        @param framesInFlight number of frames the GPU may lag behind, see VertexBufferRing
+        */
+        void setDynamicVertexRingSize(size_t bytes, uint32 framesInFlight = 3)
+        {
+            mDynamicVertexRingSize = bytes;
+            mDynamicVertexRingFramesInFlight = framesInFlight;
+        }
+        /// Get the size in bytes of each dynamic vertex ring
+        size_t getDynamicVertexRingSize() const { return mDynamicVertexRingSize; }
+        /// Get the number of frames in flight the dynamic vertex rings are created with
+        uint32 getDynamicVertexRingFramesInFlight() const { return mDynamicVertexRingFramesInFlight; }
     };
 
     /** Singleton wrapper for hardware buffer manager. */
@@ -197,6 +197,18 @@ namespace Ogre
         /** @see InstanceManager::updateDirtyBatches */
         void _updateBounds(void);
 
+        /** Brings the scene nodes of the instances up to date, so that _calculateBounds
+            doesn't have to update them lazily. Must be called from the main thread.
+        */
+        void _updateInstanceNodes(void);
+
+        /** Recomputes the bounds like _updateBounds but without notifying the parent node.
+        @remarks
+            Only touches this batch, so different batches may be processed concurrently
+            once _updateInstanceNodes has been called on all of them.
+        */
+        void _calculateBounds(void);
+
         /** Some techniques have a limit on how many instances can be done.
             Sometimes even depends on the material being used.
         @par
@@ -323,6 +335,11 @@ namespace Ogre
         */
         virtual bool useBoneWorldMatrices() const { return true; }
 
+        /** Tells whether skeletal animations are baked, so instanced entities only need
+            their animation states and no SkeletonInstance
+        */
+        virtual bool useBakedAnimation() const { return false; }
+
         /** Tells that the list of entity instances with shared transforms has changed */
         void _markTransformSharingDirty() { mTransformSharingDirty = true; }
 
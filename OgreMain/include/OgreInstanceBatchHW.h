@@ -61,6 +61,10 @@ namespace Ogre
     class _OgreExport InstanceBatchHW : public InstanceBatch
     {
         bool    mKeepStatic;
+        /// Visibility of each instance, as found by the parallel vertex buffer update
+        std::vector<uint8> mInstanceVisible;
+        /// Number of visible instances per chunk of the parallel vertex buffer update
+        std::vector<size_t> mChunkVisibleCounts;
 
         void setupVertices( const SubMesh* baseSubMesh );
         void setupIndices( const SubMesh* baseSubMesh );
@@ -69,6 +73,8 @@ namespace Ogre
         virtual bool checkSubMeshCompatibility( const SubMesh* baseSubMesh );
 
         size_t updateVertexBuffer( Camera *currentCamera );
+        /// Culls and writes the instances in chunks spread over the WorkQueue
+        size_t updateVertexBufferParallel( Camera *currentCamera, float *pDest );
 
     public:
         InstanceBatchHW( InstanceManager *creator, MeshPtr &meshReference, const MaterialPtr &material,
@@ -59,8 +59,20 @@ namespace Ogre
     class _OgreExport InstanceBatchHW_VTF : public BaseInstanceBatchVTF
     {
     protected:
+        /// Location of a skeletal animation inside the baked vertex texture
+        struct BakedClip
+        {
+            size_t firstRow;    ///< Bone palette of the first frame
+            size_t numFrames;
+        };
+        typedef std::map<String, BakedClip> BakedClipMap;
+
         bool    mKeepStatic;
 
+        bool            mUseBakedAnimation;
+        Real            mBakedAnimationFrameRate;
+        BakedClipMap    mBakedClips;
+
         //Pointer to the buffer containing the per instance vertex data
         HardwareVertexBufferSharedPtr mInstanceVertexBuffer;
 
@@ -87,6 +99,28 @@ namespace Ogre
         size_t updateVertexTexture( Camera *currentCamera );
 
         virtual bool matricesTogetherPerRow() const { return true; }
+
+        /** Overloaded to create (or reuse) the vertex texture with the baked animations */
+        virtual void createVertexTexture( const SubMesh* baseSubMesh );
+
+        /** Lays out the baked animations of the skeleton
+        @return the number of bone palettes, including the binding pose
+        */
+        size_t calculateBakedClips( BakedClipMap &outClips ) const;
+
+        /** Samples every skeletal animation of the mesh and writes the bone palettes to the
+            vertex texture. Row 0 holds the binding pose.
+        */
+        void bakeAnimations( size_t numPalettes );
+
+        /** @return the palette row matching the current animation state of the entity */
+        size_t getBakedAnimationRow( const InstancedEntity *entity ) const;
+
+        /** Overloaded to skip transform sharing, which is not needed with baked animations */
+        virtual void updateSharedLookupIndexes();
+
+        /** @see InstanceBatch::generateInstancedEntity() */
+        virtual InstancedEntity* generateInstancedEntity(size_t num);
     public:
         InstanceBatchHW_VTF( InstanceManager *creator, MeshPtr &meshReference, const MaterialPtr &material,
                             size_t instancesPerBatch, const Mesh::IndexMap *indexToBoneMap,
@@ -103,6 +137,25 @@ namespace Ogre
 
         bool isStatic() const { return mKeepStatic; }
 
+        /** Sets whether skeletal animations are baked into a vertex texture shared by all batches
+            of the InstanceManager.
+
+            Every animation of the skeleton is sampled at the given frame rate when the batch is
+            built, and instances only upload their world matrix and the location of their current
+            frame, so no bone matrices are evaluated on the CPU at runtime. Only the enabled
+            animation state with the highest weight is taken into account, and frames are not
+            interpolated. The vertex layout is the same as with bone matrix lookup, so the same
+            shaders can be used.
+
+            This value needs to be set before adding any instanced entities
+        */
+        void setBakedAnimation( bool enable, Real framesPerSecond );
+
+        /** Tells whether skeletal animations are baked into the vertex texture
+        @see setBakedAnimation()
+        */
+        virtual bool useBakedAnimation() const { return mUseBakedAnimation; }
+
         /** Overloaded to visibility on a per unit basis and finally updated the vertex texture */
         virtual void _updateRenderQueue( RenderQueue* queue );
     };
@@ -123,7 +123,11 @@ namespace Ogre
         void setupMaterialToUseVTF( TextureType textureType, MaterialPtr &material ) const;
 
         /** Creates the vertex texture */
-        void createVertexTexture( const SubMesh* baseSubMesh );
+        virtual void createVertexTexture( const SubMesh* baseSubMesh );
+
+        /** Calculates the dimensions of a vertex texture able to hold the given amount of matrices,
+            and the padding needed if all matrices of an instance must be in the same row */
+        void calculateVertexTextureSize( size_t numWorldMatrices, size_t &outWidth, size_t &outHeight );
 
         /** Creates 2 TEXCOORD semantics that will be used to sample the vertex texture */
         virtual void createVertexSemantics( VertexData *thisVertexData, VertexData *baseVertexData,
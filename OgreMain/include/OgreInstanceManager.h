@@ -118,6 +118,7 @@ namespace Ogre
         SceneManager*           mSceneManager;
 
         size_t                  mMaxLookupTableInstances;
+        Real                    mBakedAnimationFrameRate;
         unsigned char           mNumCustomParams;       //Number of custom params per instance.
 
         /** Finds a batch with at least one free instanced entity we can use.
@@ -180,6 +181,13 @@ namespace Ogre
         */
         void setMaxLookupTableInstances( size_t maxLookupTableInstances );
 
+        /** Sets the rate at which skeletal animations are sampled when baked with IM_VTFBAKEDANIMATION.
+            Raises an exception if trying to change it after creating the first InstancedEntity.
+        @remarks Higher rates give smoother animations, but need a bigger vertex texture.
+        @param framesPerSecond Samples per second of animation. Default: 30
+        */
+        void setBakedAnimationFrameRate( Real framesPerSecond );
+
         /** Sets the number of custom parameters per instance. Some techniques (i.e. HWInstancingBasic)
             support this, but not all of them. They also may have limitations to the max number. All
             instancing implementations assume each instance param is a Vector4 (4 floats).
@@ -93,6 +93,7 @@ namespace Ogre {
         friend class MeshSerializerImpl_v1_3;
         friend class MeshSerializerImpl_v1_2;
         friend class MeshSerializerImpl_v1_1;
+        friend class MeshManager;
 
     public:
         typedef std::vector<Real> LodValueList;
@@ -166,6 +167,43 @@ namespace Ogre {
         const ushort mNumLods;
         MeshLodUsageList mMeshLodUsageList;
 #endif
+        /// Index data of a generated LOD level, that is loaded on demand
+        struct StreamedLodLevel
+        {
+            /// location of a LOD index buffer in the mesh file
+            struct Source
+            {
+                size_t offset;
+                uint32 indexCount;
+                bool idx32Bit;
+                /// the level that owns the buffer, differs for merged buffers
+                ushort owner;
+            };
+            /// one per SubMesh, empty if the level is not streamed
+            std::vector<Source> sources;
+            unsigned long lastUsedFrame;
+            bool resident;
+            bool pending;
+            /// reading the level failed, so it is not requested again
+            bool failed;
+
+            StreamedLodLevel() : lastUsedFrame(0), resident(true), pending(false), failed(false) {}
+        };
+        /// indexed by LOD level, empty if the mesh was not loaded with LOD streaming
+        std::vector<StreamedLodLevel> mStreamedLodLevels;
+        /// tells the serializer to defer the intermediate LOD levels while loading
+        bool mStreamLodLevels;
+        bool mLodStreamFlipEndian;
+
+        /// creates an index buffer from the data at the current stream position
+        HardwareIndexBufferPtr readLodIndexBuffer(const StreamedLodLevel::Source& src,
+                                                  const DataStreamPtr& stream);
+        /// creates the index buffers of a streamed level, either seeking to their location in the
+        /// mesh file or reading them in order
+        void loadStreamedLodLevel(ushort index, const DataStreamPtr& stream, bool seekToSource);
+        void evictStreamedLodLevel(ushort index);
+        size_t getStreamedLodLevelSize(ushort index) const;
+
         HardwareBufferManagerBase* mBufferManager;
         HardwareBuffer::Usage mVertexBufferUsage;
         HardwareBuffer::Usage mIndexBufferUsage;
@@ -529,6 +567,25 @@ namespace Ogre {
         /** Removes all LOD data from this Mesh. */
         void removeLodLevels(void);
 
+        /** Returns whether the index data of the given LOD level is loaded
+
+            Always true, unless the mesh was loaded with MeshManager::setLodStreaming enabled.
+        */
+        bool isLodLevelResident(ushort index) const;
+
+        /** Loads the index data of all streamed LOD levels right away
+
+            Required before accessing the LOD index data of the SubMeshes directly.
+        */
+        void loadStreamedLodLevels();
+
+        /** Internal method returning the LOD level to render instead of the given one
+
+            Requests the index data of a streamed LOD level, that is not loaded yet, and returns the
+            closest coarser level that is. The coarsest level is always loaded.
+        */
+        ushort _getResidentLodIndex(ushort index);
+
         /** Sets the manager for the vertex and index buffers to be used when loading
             this Mesh.
         @remarks
@@ -847,6 +904,22 @@ namespace Ogre {
             const std::map<size_t, Vector3>& vertexOffsetMap,
             const std::map<size_t, Vector3>& normalsMap,
             VertexData* targetVertexData);
+
+        /// A pose together with the weight it is applied with
+        typedef std::vector<std::pair<const Pose*, Real> > PoseWeightList;
+
+        /** Performs a software vertex pose blend of several poses in one go.
+        @remarks
+            Gives the same result as calling the function above once per pose, but
+            the position buffer is only locked once and the sparse offsets are read
+            from the packed arrays of the poses rather than walking their maps.
+        @param poses
+            Poses to apply with their weights; poses with a zero weight are skipped.
+        @param targetVertexData 
+            VertexData destination, as above.
+        */
+        static void softwareVertexPoseBlend(const PoseWeightList& poses,
+            VertexData* targetVertexData);
         /** Gets a reference to the optional name assignments of the SubMeshes. */
         const SubMeshNameMap& getSubMeshNameMap(void) const { return mSubMeshNameMap; }
 
@@ -402,7 +402,43 @@ namespace Ogre {
         */
         MeshSerializerListener *getListener();
 
+        /** Enables streaming of the generated LOD levels
+
+            Meshes loaded afterwards only read the index data of the full detail and the coarsest
+            LOD level. The levels in between are read by the WorkQueue in the background, once an
+            Entity selects them, rendering the closest coarser level meanwhile.
+            @note
+                The default value is false. Only affects meshes in the current .mesh format.
+        */
+        void setLodStreaming(bool enabled) { mLodStreaming = enabled; }
+
+        /// Gets whether the generated LOD levels are streamed
+        bool getLodStreaming() const { return mLodStreaming; }
+
+        /** Sets the memory budget of the streamed LOD levels
+
+            Once the index data of the streamed levels exceeds this size, the ones that were not
+            rendered for the longest time are unloaded again.
+            @param bytes budget in bytes. 0 means unlimited.
+            @note
+                The default value is 0.
+        */
+        void setLodStreamingBudget(size_t bytes) { mLodStreamingBudget = bytes; }
+
+        /// Gets the memory budget of the streamed LOD levels
+        size_t getLodStreamingBudget() const { return mLodStreamingBudget; }
+
+        /// Internal method to load the index data of a streamed LOD level
+        void _requestLodStreaming(Mesh* mesh, ushort index);
+
     private:
+        class LodStreamingHandler;
+        friend class LodStreamingHandler;
+        /// apply streamed index data to its mesh, NULL if reading it failed
+        void finishLodStreaming(Mesh* mesh, ushort index, size_t stateCount, const DataStreamPtr& data);
+        /// unload the least recently rendered LOD levels until the streaming budget is met
+        void enforceLodStreamingBudget();
+
 
         /// @copydoc ResourceManager::createImpl
         Resource* createImpl(const String& name, ResourceHandle handle, 
@@ -472,6 +508,10 @@ namespace Ogre {
         // The listener to pass to serializers
         MeshSerializerListener *mListener;
 
+        std::unique_ptr<LodStreamingHandler> mLodStreamingHandler;
+        bool mLodStreaming;
+        size_t mLodStreamingBudget;
+
     private:
         std::unique_ptr<Codec> mMeshCodec;
     };
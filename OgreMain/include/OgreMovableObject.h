@@ -289,7 +289,7 @@ namespace Ogre {
             changes are best done using this method; large or more longer term
             changes are best done by detaching.
         */
-        void setVisible(bool visible) { mVisible = visible; }
+        void setVisible(bool visible);
 
         /** Gets this object whether to be visible or not, if it has a renderable component. 
         @remarks
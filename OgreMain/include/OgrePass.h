@@ -131,10 +131,31 @@ namespace Ogre {
         };
 
         typedef std::vector<TextureUnitState*> TextureUnitStates;
+
+        /** Interned IDs of the render state a Pass sets.
+
+            Passes which set the same state of a kind get the same ID for it, regardless
+            of whether they are the same Pass object, so comparing two IDs is enough to
+            find a redundant state change. The IDs are compiled together with the hash
+            and are 0 while the Pass is dirty, meaning that the state is unknown.
+        */
+        struct StateIds
+        {
+            uint32 programs; //!< GPU programs
+            uint32 textures; //!< texture names and samplers
+            uint32 blend;    //!< colour blend state and alpha rejection
+            uint32 depth;    //!< depth buffer settings
+            uint32 raster;   //!< culling, polygon and shading mode
+
+            StateIds() : programs(0), textures(0), blend(0), depth(0), raster(0) {}
+        };
     private:
         Technique* mParent;
         String mName; /// Optional name for the pass
         uint32 mHash; /// Pass hash
+        uint64 mSortKey; /// Packed StateIds, as they were when the hash was calculated
+        uint32 mChangeCount; /// Incremented whenever the hash is dirtied
+        StateIds mStateIds;
         //-------------------------------------------------------------------------
         // Colour properties, only applicable in fixed-function passes
         ColourValue mAmbient;
@@ -257,6 +278,13 @@ namespace Ogre {
         static PassSet msPassGraveyard;
         /// The Pass hash functor
         static HashFunc* msHashFunc;
+        /// Incremented whenever a pass is queued for deletion
+        static uint32 msDeletionCounter;
+        OGRE_STATIC_MUTEX(msStateIdsMutex);
+        /// Compiles mStateIds and mSortKey from the current state
+        void compileStateIds(void);
+        /// Lets go of the entries of mStateIds in the ID pools
+        void releaseStateIds(void);
     public:
         OGRE_STATIC_MUTEX(msDirtyHashListMutex);
         OGRE_STATIC_MUTEX(msPassGraveyardMutex);
@@ -1321,6 +1349,23 @@ namespace Ogre {
             by the textures which it's TextureUnitState instances are using.
         */
         uint32 getHash(void) const { return mHash; }
+        /** Gets the interned IDs of the render state this pass sets
+
+            They are compiled whenever the hash is recalculated, so changing the
+            render state of a loaded pass should be followed by @ref _dirtyHash.
+        */
+        const StateIds& getStateIds(void) const { return mStateIds; }
+        /** Gets a key to sort passes by, so that passes setting the same state end up next to each other
+
+            Unlike @ref getStateIds this only changes together with the hash, so it can be used
+            for ordered containers.
+        */
+        uint64 getSortKey(void) const { return mSortKey; }
+        /** Gets a counter that is incremented whenever the hash of this pass is dirtied
+
+            Allows detecting that the state of a pass changed since it was last seen.
+        */
+        uint32 getChangeCount(void) const { return mChangeCount; }
         /// Mark the hash as dirty
         void _dirtyHash(void);
         /** Internal method for recalculating the hash.
@@ -1364,6 +1409,13 @@ namespace Ogre {
          */
         static const PassSet& getPassGraveyard(void)
         { return msPassGraveyard; }
+        /** Static method returning a counter that is incremented whenever a pass is queued for deletion.
+
+            This allows holding on to Pass pointers across frames, like the render commands recorded
+            for a Viewport, and detecting when they may be dangling.
+         */
+        static uint32 getDeletionCounter(void)
+        { return msDeletionCounter; }
         /** Static method to reset the list of passes which need their hash
             values recalculated.
             @remarks
@@ -118,17 +118,37 @@ namespace Ogre {
          *
          * @attention does not invalidate the vertexbuffer
          */
-        VertexOffsetMap& _getVertexOffsets() { return mVertexOffsetMap; }
+        VertexOffsetMap& _getVertexOffsets()
+        {
+            mPackedDataDirty = true;
+            return mVertexOffsetMap;
+        }
 
         /** writable access to the vertex normals for offline processing
          *
          * @attention does not invalidate the vertexbuffer
          */
-        NormalsMap& _getNormals() { return mNormalsMap; }
+        NormalsMap& _getNormals()
+        {
+            mPackedDataDirty = true;
+            return mNormalsMap;
+        }
 
         /** Get a hardware vertex buffer version of the vertex offsets. */
         const HardwareVertexBufferSharedPtr& _getHardwareVertexBuffer(const VertexData* origData) const;
 
+        /** Get the indices of the affected vertices as a flat array, for software blending.
+        @remarks
+            Entry i matches the 3 floats starting at i*3 in _getPackedOffsets and
+            _getPackedNormals. Rebuilt on the next call after any change, including
+            writes through _getVertexOffsets and _getNormals.
+        */
+        const std::vector<uint32>& _getPackedIndices() const;
+        /// Vertex offsets in the order of _getPackedIndices
+        const std::vector<float>& _getPackedOffsets() const;
+        /// Normals in the order of _getPackedIndices, empty if the pose has none
+        const std::vector<float>& _getPackedNormals() const;
+
         /** Clone this pose and create another one configured exactly the same
             way (only really useful for cloning holders of this class).
         */
@@ -144,6 +164,15 @@ namespace Ogre {
         NormalsMap mNormalsMap;
         /// Derived hardware buffer, covers all vertices
         mutable HardwareVertexBufferSharedPtr mBuffer;
+        /// Derived flat copies of the maps, sparse vertex use
+        mutable std::vector<uint32> mPackedIndices;
+        mutable std::vector<float> mPackedOffsets;
+        mutable std::vector<float> mPackedNormals;
+        /// Whether the maps may have changed since the flat copies were made
+        mutable bool mPackedDataDirty;
+
+        void invalidateDerivedData();
+        void updatePackedData() const;
     };
     typedef std::vector<Pose*> PoseList;
 
@@ -181,6 +181,7 @@ namespace Ogre {
     class Ray;
     class RaySceneQuery;
     class RaySceneQueryListener;
+    struct RenderCommandList;
     class Renderable;
     class RenderPriorityGroup;
     class RenderQueue;
@@ -141,6 +141,7 @@ namespace Ogre {
         bool mShadowCastersCannotBeReceivers;
 
         RenderableListener* mRenderableListener;
+        std::vector<MovableObject*>* mVisibleObjects;
     public:
         RenderQueue();
         virtual ~RenderQueue();
@@ -285,6 +286,11 @@ namespace Ogre {
         RenderableListener* getRenderableListener(void) const
         { return mRenderableListener; }
 
+        /** Advanced method to collect the objects added by processVisibleObject
+        @param list the list to append the visible objects to, NULL to stop collecting
+        */
+        void _setVisibleObjectList(std::vector<MovableObject*>* list) { mVisibleObjects = list; }
+
         /** Merge render queue.
         */
         void merge( const RenderQueue* rhs );
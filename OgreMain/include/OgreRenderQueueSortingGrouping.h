@@ -132,6 +132,12 @@ namespace Ogre {
                 uint32 hashb = b->getHash();
                 if (hasha == hashb)
                 {
+                    // Keep passes setting the same state next to each other
+                    uint64 keya = a->getSortKey();
+                    uint64 keyb = b->getSortKey();
+                    if (keya != keyb)
+                        return keya < keyb;
+
                     // Must differentTransparentQueueItemLessiate by pointer incase 2 passes end up with the same hash
                     return a < b;
                 }
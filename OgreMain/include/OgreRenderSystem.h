@@ -774,6 +774,40 @@ namespace Ogre
         /** Reports the number of vertices passed to the renderer since the last _beginGeometryCount call. */
         virtual unsigned int _getVertexCount(void) const;
 
+        /// Number of render state blocks passed on to the backend and dropped as redundant
+        struct StateChangeStats
+        {
+            size_t issued;
+            size_t filtered;
+        };
+        /** Reports the render state blocks issued and filtered since the current frame started.
+        @see _applyBlendState
+        */
+        const StateChangeStats& getStateChangeStats(void) const { return mStateChangeStats; }
+
+        /** Sets the colour blend and alpha rejection state, unless it is set already.
+
+            The _apply methods group the render states into blocks and remember the block last
+            passed to the backend, so setting the same state again does not reach the backend.
+            Sampler states are filtered the same way by _setTextureUnitSettings.
+        @note
+            Code calling the underlying backend methods directly, must call _invalidateStateCache
+            afterwards.
+        */
+        void _applyBlendState(const ColourBlendState& state, CompareFunction alphaRejectFunc,
+                              unsigned char alphaRejectValue, bool alphaToCoverage);
+        /** Sets the depth buffer parameters and the depth bias, unless they are set already.
+        @see _applyBlendState
+        */
+        void _applyDepthState(bool depthTest, bool depthWrite, CompareFunction depthFunction,
+                              float constantBias, float slopeScaleBias);
+        /** Sets the culling, polygon and shading mode, unless they are set already.
+        @see _applyBlendState
+        */
+        void _applyRasterState(CullingMode cullMode, PolygonMode polygonMode, ShadeOptions shading);
+        /** Forgets the render state blocks set last, so the next _apply calls reach the backend. */
+        void _invalidateStateCache(void);
+
         /// @deprecated use ColourValue::getAsBYTE()
         OGRE_DEPRECATED static void convertColourValue(const ColourValue& colour, uint32* pDest)
         {
@@ -1186,6 +1220,72 @@ namespace Ogre
         size_t mFaceCount;
         size_t mVertexCount;
 
+        /// The render state blocks last passed to the backend, see _applyBlendState
+        struct BlendStateBlock
+        {
+            ColourBlendState blend;
+            CompareFunction alphaRejectFunc;
+            unsigned char alphaRejectValue;
+            bool alphaToCoverage;
+            bool operator==(const BlendStateBlock& rhs) const;
+        };
+        struct DepthStateBlock
+        {
+            bool depthTest;
+            bool depthWrite;
+            CompareFunction depthFunction;
+            float constantBias;
+            float slopeScaleBias;
+            bool operator==(const DepthStateBlock& rhs) const;
+        };
+        struct RasterStateBlock
+        {
+            CullingMode cullMode;
+            PolygonMode polygonMode;
+            ShadeOptions shading;
+            bool operator==(const RasterStateBlock& rhs) const;
+        };
+        /// Some backends store the sampler state with the texture, so it is keyed by both
+        struct SamplerStateBlock
+        {
+            const Texture* texture;
+            size_t textureStateCount;
+            FilterOptions filtering[3];
+            Sampler::UVWAddressingMode addressMode;
+            unsigned int anisotropy;
+            float mipmapBias;
+            bool compareEnabled;
+            CompareFunction compareFunction;
+            ColourValue borderColour;
+            bool operator==(const SamplerStateBlock& rhs) const;
+        };
+        /// A state block along with whether it is known
+        template <typename T> struct CachedState
+        {
+            T state;
+            bool valid;
+        };
+        CachedState<BlendStateBlock> mBlendStateCache;
+        CachedState<DepthStateBlock> mDepthStateCache;
+        CachedState<RasterStateBlock> mRasterStateCache;
+        CachedState<SamplerStateBlock> mSamplerStateCache[OGRE_MAX_TEXTURE_LAYERS];
+        StateChangeStats mStateChangeStats;
+
+        /// returns true if the given block is set already, otherwise records it as set
+        template <typename T> bool isRedundantStateChange(CachedState<T>& cache, const T& state)
+        {
+            if (cache.valid && cache.state == state)
+            {
+                ++mStateChangeStats.filtered;
+                return true;
+            }
+
+            cache.state = state;
+            cache.valid = true;
+            ++mStateChangeStats.issued;
+            return false;
+        }
+
         /// Saved manual colour blends
         ColourValue mManualBlendColours[OGRE_MAX_TEXTURE_LAYERS][2];
 
@@ -60,6 +60,7 @@ namespace Ogre {
 
 
     struct ResourceRequest;
+    struct ResourceResponse;
 
     /** This class is used to perform Resource operations in a
         background thread. 
@@ -69,6 +70,19 @@ namespace Ogre {
         refer to that class for configuring the behaviour of the threads
         themselves, this class merely provides an interface that is specific
         to resource loading around this common functionality.
+    @par
+        Group requests are split up per resource: each resource is prepared
+        (I/O and decoding) by its own request, so a group is processed by as many
+        worker threads as the WorkQueue provides, see setMaxConcurrentPrepares.
+        Resources are prepared one loading order at a time (e.g. skeletons before
+        meshes). For loadResourceGroup, the final Resource::load happens in the main
+        thread as each resource becomes ready, within the
+        WorkQueue::setResponseProcessingTimeLimit budget of every frame.
+        The ResourceGroupListener events of the group are fired in the main thread as
+        well, in loading order, and no ResourceGroupManager lock is held meanwhile.
+        The first failure stops the operation like an exception would stop
+        ResourceGroupManager::loadResourceGroup; it is reported by
+        Listener::operationCompleted.
     @par
         The general approach here is that on requesting a background resource
         process, your request is placed on a queue ready for the background
@@ -102,6 +116,13 @@ namespace Ogre {
                 so that you don't have to be concerned about thread safety. 
             */
             virtual void operationCompleted(BackgroundProcessTicket ticket, const BackgroundProcessResult& result) = 0;
+            /** Called each time a resource of a queued group operation has been
+                processed, queued into main thread.
+            @param ticket The ticket of the group operation
+            @param completed Number of resources processed so far
+            @param total Number of resources in the group
+            */
+            virtual void operationProgress(BackgroundProcessTicket ticket, size_t completed, size_t total) {}
             /// Need virtual destructor in case subclasses use it
             virtual ~Listener() {}
 
@@ -114,8 +135,34 @@ namespace Ogre {
         typedef std::set<BackgroundProcessTicket> OutstandingRequestSet;   
         OutstandingRequestSet mOutstandingRequestSet;
 
+        /// A group prepare / load whose resources are being processed individually
+        struct GroupOperation
+        {
+            bool load;
+            String groupName;
+            Listener* listener;
+            /// Resources of the group, one list per loading order
+            std::vector<std::vector<ResourcePtr> > stages;
+            /// Next resource to queue
+            size_t stage, next;
+            /// Count announced by the group started event
+            size_t eventCount;
+            std::set<WorkQueue::RequestID> inFlight;
+            size_t completed, total;
+            BackgroundProcessResult result;
+        };
+        typedef std::map<BackgroundProcessTicket, GroupOperation> GroupOperationMap;
+        GroupOperationMap mGroupOperations;
+
+        size_t mMaxConcurrentPrepares;
+
         BackgroundProcessTicket addRequest(ResourceRequest& req);
 
+        void startGroupOperation(BackgroundProcessTicket ticket, ResourceResponse& resresp);
+        /// Queue the next resources of the operation, or complete it when none are left
+        void updateGroupOperation(BackgroundProcessTicket ticket);
+        void handleGroupResponse(const WorkQueue::Response* res, ResourceResponse& resresp);
+
     public:
         ResourceBackgroundQueue();
         virtual ~ResourceBackgroundQueue();
@@ -130,6 +177,17 @@ namespace Ogre {
         */
         virtual void shutdown(void);
 
+        /** Sets the maximum number of resources of a group operation that are
+            queued for preparation at the same time.
+        @remarks
+            Prepared resources hold their decoded data until they are loaded, so this
+            bounds the memory in flight as well as the worker threads in use.
+            Defaults to the hardware concurrency, 0 means no limit.
+        */
+        void setMaxConcurrentPrepares(size_t count) { mMaxConcurrentPrepares = count; }
+        /// @copydoc setMaxConcurrentPrepares
+        size_t getMaxConcurrentPrepares() const { return mMaxConcurrentPrepares; }
+
         /** Initialise a resource group in the background.
         @see ResourceGroupManager::initialiseResourceGroup
         @param name The name of the resource group to initialise
@@ -153,6 +211,8 @@ namespace Ogre {
             Listener* listener = 0);
         /** Prepares a resource group in the background.
         @see ResourceGroupManager::prepareResourceGroup
+        @note The resources are prepared in parallel, and the listener is
+            notified of the progress via Listener::operationProgress.
         @param name The name of the resource group to prepare
         @param listener Optional callback interface, take note of warnings in 
             the header and only use if you understand them.
@@ -164,6 +224,9 @@ namespace Ogre {
 
         /** Loads a resource group in the background.
         @see ResourceGroupManager::loadResourceGroup
+        @note The resources are prepared in parallel and then loaded in the main
+            thread, and the listener is notified of the progress via
+            Listener::operationProgress.
         @param name The name of the resource group to load
         @param listener Optional callback interface, take note of warnings in 
             the header and only use if you understand them.
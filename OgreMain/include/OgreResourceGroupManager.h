@@ -234,6 +234,8 @@ namespace Ogre {
     */
     class _OgreExport ResourceGroupManager : public Singleton<ResourceGroupManager>, public ResourceAlloc
     {
+        /// processes the resources of a group itself, but fires the same events
+        friend class ResourceBackgroundQueue;
     public:
         OGRE_AUTO_MUTEX; // public to allow external locking
         /// same as @ref RGN_DEFAULT
@@ -884,6 +886,14 @@ namespace Ogre {
         */
         ResourceManager* _getResourceManager(const String& resourceType) const;
 
+        /** Internal method for getting the created resources of a group.
+        @param name The name of the resource group
+        @param stages Receives one list of resources per ResourceManager loading order,
+            sorted by increasing order like in loadResourceGroup
+        */
+        void _getResourceGroupLoadStages(const String& name,
+                                         std::vector<std::vector<ResourcePtr> >& stages) const;
+
         /** Internal method called by ResourceManager when a resource is created.
         @param res Weak reference to resource
         */
@@ -47,6 +47,7 @@ Torus Knot Software Ltd.
 #include "OgreManualObject.h"
 #include "OgreRenderSystem.h"
 #include "OgreLodListener.h"
+#include "OgrePlaneBoundedVolume.h"
 #include "OgreHeaderPrefix.h"
 #include "OgreNameGenerator.h"
 
@@ -94,6 +95,58 @@ namespace Ogre {
     struct EntityMeshLodChangedEvent;
     struct EntityMaterialLodChangedEvent;
 
+    /** The render commands recorded for a Viewport, in rendering order.
+
+        The SceneManager replays them instead of the render queue, as long as the scene state they
+        were recorded with did not change.
+        @see Viewport::setRenderRecordingEnabled
+    */
+    struct _OgreExport RenderCommandList : public RenderQueueAlloc
+    {
+        struct Command
+        {
+            Renderable* rend;
+            const Pass* pass;
+            uint8 queueId;
+            /// Set if the per object state below was derived when recording, so it is not derived again
+            bool derived;
+            bool scaled;
+            bool negativeScale;
+            bool polygonModeOverrideable;
+        };
+        typedef std::vector<Command> CommandList;
+        CommandList commands;
+        /// The objects that queued the commands, notified of the camera again on replay so that
+        /// their LOD and texture usage stays current
+        std::vector<MovableObject*> objects;
+
+        /// The passes used by the commands, with their Pass::getChangeCount when recorded
+        std::vector<std::pair<const Pass*, uint32> > passes;
+        /// The volume seen by the camera, changes outside of it do not affect the commands
+        PlaneBoundedVolume volume;
+
+        /// The SceneManager notifying about changes to the scene, NULL if nothing was recorded yet
+        SceneManager* sceneManager;
+        /// Whether the commands still match the scene
+        bool valid;
+        /// Whether the commands were replayed since they were recorded
+        bool replayed;
+        /// Number of recordings in a row that were invalidated before they were replayed
+        uint8 wastedRecordings;
+        /// The frame from which recording is attempted again
+        unsigned long nextRecordingFrame;
+
+        const Camera* camera;
+        Affine3 viewMatrix;
+        Matrix4 projMatrix;
+        uint32 visibilityMask;
+        String materialScheme;
+        uint32 passDeletionCounter;
+
+        RenderCommandList();
+        ~RenderCommandList();
+    };
+
     /** Structure collecting together information about the visible objects
     that have been discovered in a scene.
     */
@@ -593,6 +646,10 @@ namespace Ogre {
         LightInfoList mTestLightInfos; // potentially new list
         ulong mLightsDirtyCounter;
 
+        typedef std::vector<RenderCommandList*> RenderCommandListList;
+        /// The render commands recorded by this SceneManager, that are notified of scene changes
+        RenderCommandListList mRenderRecordings;
+
         /// Simple structure to hold MovableObject map and a mutex to go with it.
         struct MovableObjectCollection
         {
@@ -913,6 +970,14 @@ namespace Ogre {
 
         /** Internal method for rendering all objects using the default queue sequence. */
         void renderVisibleObjectsDefaultSequence(void);
+        /** Internal method for recording the filled render queue of a viewport. */
+        void recordRenderCommands(RenderCommandList& recording, Camera* cam, Viewport* vp);
+        /** Internal method for checking whether a recording still matches the scene, camera and viewport. */
+        bool isRenderRecordingValid(const RenderCommandList& recording, Camera* cam, Viewport* vp) const;
+        /** Internal method for rendering a recording instead of the render queue. */
+        void renderRecordedCommands(const RenderCommandList& recording);
+        /** Internal method for rendering a recorded command with the per object state derived when recording. */
+        void renderRecordedObject(const RenderCommandList::Command& cmd);
         /** Internal method for preparing the render queue for use with each render. */
         void prepareRenderQueue(void);
 
@@ -928,6 +993,11 @@ namespace Ogre {
         void renderSingleObject(Renderable* rend, const Pass* pass,
             bool lightScissoringClipping, bool doLightIteration, const LightList* manualLightList = 0);
 
+        /** Internal method for applying the normalisation, culling and polygon mode of an object,
+            derived from the properties of its world matrix. */
+        void applyObjectRasterState(const Pass* pass, bool scaled, bool negativeScale,
+                                    bool polygonModeOverrideable);
+
         /** Internal method for creating the AutoParamDataSource instance. */
         AutoParamDataSource* createAutoParamDataSource(void) const
         {
@@ -996,6 +1066,32 @@ namespace Ogre {
 
         /** Updates all instance managaers with dirty instance batches. @see _addDirtyInstanceManager */
         void updateDirtyInstanceManagers(void);
+
+        /// Draws renderables sharing their geometry as instances, see GpuProgram::setInstancingIncluded
+        class AutoInstanceBatch;
+        std::unique_ptr<AutoInstanceBatch> mAutoInstanceBatch;
+        /// Renderables collected for the next instanced draw
+        RenderableList mAutoInstanceRun;
+
+        /// Whether the vertex program of the pass reads the world matrix per instance
+        bool isAutoInstancingPass(const Pass* pass) const;
+        /// What decides whether and with which renderables a renderable can be drawn as an instance
+        struct AutoInstanceInfo
+        {
+            RenderOperation op;
+            bool instanceable;
+            bool negativeScale;
+        };
+        /// Cached per camera, as the renderables are queried for every pass they are rendered with
+        std::unordered_map<Renderable*, AutoInstanceInfo> mAutoInstanceInfos;
+        /// Whether and with which renderables the renderable can be drawn as an instance
+        const AutoInstanceInfo& getAutoInstanceInfo(Renderable* rend);
+        /// Renders the renderables, drawing runs of compatible ones as instances of one draw
+        void renderAutoInstanced(const RenderableList& rends, const Pass* pass, bool lightScissoringClipping,
+                                 bool doLightIteration, const LightList* manualLightList);
+        /// Renders the renderables as instances of one draw
+        void renderAutoInstanceBatch(const RenderableList& rends, const Pass* pass, bool lightScissoringClipping,
+                                     bool doLightIteration, const LightList* manualLightList);
         
         void _destroySceneNode(SceneNodeList::iterator it);
     public:
@@ -1065,11 +1161,14 @@ namespace Ogre {
 
         /// Last light sets
         uint32 mLastLightHash;
+        /// Pass::StateIds::programs of the bound programs, 0 if unknown
+        uint32 mLastProgramsId;
         /// Gpu params that need rebinding (mask of GpuParamVariability)
         uint16 mGpuParamsDirty;
 
         void useLights(const LightList* lights, ushort limit);
-        void bindGpuProgram(GpuProgram* prog);
+        /// Binds the programs of the pass and unbinds the ones it does not use
+        void bindPassGpuPrograms(const Pass* pass);
         void updateGpuProgramParameters(const Pass* p);
 
         /// Set of registered LOD listeners
@@ -1300,6 +1399,21 @@ namespace Ogre {
         */
         ulong _getLightsDirtyCounter(void) const { return mLightsDirtyCounter; }
 
+        /** Advanced method to notify the SceneManager that the contents of the given region changed.
+        @remarks
+            This is called whenever a scene node is updated, enters or leaves the scene graph,
+            or the visibility or material of an object changes. The render commands recorded for
+            viewports seeing the region are invalidated.
+        @see Viewport::setRenderRecordingEnabled
+        */
+        void _notifySceneChanged(const AxisAlignedBox& bounds);
+
+        /// Advanced method to check whether any render commands are recorded, that need _notifySceneChanged
+        bool _hasRenderRecordings(void) const { return !mRenderRecordings.empty(); }
+
+        /// @private
+        void _removeRenderRecording(RenderCommandList* recording);
+
         /** Get the list of lights which could be affecting the frustum.
         @remarks
             This returns a cached light list which is populated when rendering the scene.
@@ -3359,6 +3473,13 @@ namespace Ogre {
         */
         void _markGpuParamsDirty(uint16 mask);
 
+        /** Binds a program outside of _setPass, e.g. for a compute dispatch
+
+            Unlike RenderSystem::bindGpuProgram, this makes sure the programs and parameters
+            of the next pass are bound again.
+        */
+        void bindGpuProgram(GpuProgram* prog);
+
         /** Render the objects in a given queue group
         */
         void _renderQueueGroupObjects(RenderQueueGroup* group,
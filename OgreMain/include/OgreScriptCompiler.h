@@ -188,6 +188,8 @@ namespace Ogre
     public: // Externally accessible types
         //typedef std::map<String,uint32> IdMap;
         typedef std::unordered_map<String,uint32> IdMap;
+        /// Maps the names of imported scripts to the hashes of their contents
+        typedef std::map<String,uint32> ImportHashMap;
 
         // These are the built-in error codes
         enum{
@@ -219,6 +221,18 @@ namespace Ogre
         bool compile(const String &str, const String &source, const String &group);
         /// Compiles resources from the given concrete node list
         bool compile(const ConcreteNodeListPtr &nodes, const String &group);
+        /** Compiles resources from the given concrete node list, returning the intermediate AST
+         * @param ast Receives the AST after import, inheritance and variable processing
+         * @param importHashes Receives the hashes of all scripts imported from the resource system
+         */
+        bool _compile(const ConcreteNodeListPtr &nodes, const String &group, AbstractNodeListPtr &ast,
+                      ImportHashMap &importHashes);
+        /// Compiles resources from an AST that was already processed, e.g. one restored by _deserialiseAST
+        bool _compile(const AbstractNodeListPtr &ast, const String &group);
+        /// Writes a processed AST to a compact binary representation
+        static MemoryDataStreamPtr _serialiseAST(const AbstractNodeList &nodes);
+        /// Restores an AST written by _serialiseAST. Returns a null pointer if the data is not valid.
+        AbstractNodeListPtr _deserialiseAST(const MemoryDataStreamPtr &data) const;
         /// Adds the given error to the compiler's list of errors
         void addError(uint32 code, const String &file, int line, const String &msg = "");
         /// Sets the listener used by the compiler
@@ -254,6 +268,10 @@ namespace Ogre
 
     private: // Tree processing
         AbstractNodeListPtr convertToAST(const ConcreteNodeList &nodes);
+        /// Converts the nodes to an AST and runs all processing steps preceding the translation
+        AbstractNodeListPtr processAST(const ConcreteNodeListPtr &nodes, const String &group);
+        /// Translates the processed AST into resources
+        bool translateAST(const AbstractNodeListPtr &ast);
         /// This built-in function processes import nodes
         void processImports(AbstractNodeList &nodes);
         /// Loads the requested script and converts it to an AST
@@ -288,6 +306,7 @@ namespace Ogre
         ImportCacheMap mImports; // The set of imported scripts to avoid circular dependencies
         typedef std::multimap<String,String> ImportRequestMap;
         ImportRequestMap mImportRequests; // This holds the target objects for each script to be imported
+        ImportHashMap mImportHashes; // The content hashes of the scripts loaded by loadImportPath
 
         // This stores the imports of the scripts, so they are separated and can be treated specially
         AbstractNodeList mImportTable;
@@ -408,6 +427,34 @@ namespace Ogre
 
         // the specific compiler instance used
         ScriptCompiler mScriptCompiler;
+
+        // A processed AST along with the imports it was created from
+        struct CachedScript
+        {
+            ScriptCompiler::ImportHashMap imports;
+            MemoryDataStreamPtr ast;
+        };
+        // Maps the hashes of script names and contents to their processed ASTs
+        std::map<uint32, CachedScript> mScriptCache;
+        // Hashes of the imports already read during this session, keyed by group and name
+        std::map<std::pair<String, String>, uint32> mImportHashes;
+        size_t mScriptCacheHits;
+        bool mSaveScriptsToCache;
+        bool mScriptCacheDirty;
+
+        // Forgets the import hashes of a group whenever its scripts are parsed
+        class ImportHashInvalidator;
+        std::unique_ptr<ImportHashInvalidator> mImportHashInvalidator;
+
+        /// Returns the hash of the import contents, reading it only on first use. 0 if it does not exist.
+        uint32 getImportHash(const String& name, const String& groupName);
+        /// Drops the import hashes of the group, so they are read again on next use
+        void clearImportHashes(const String& groupName);
+
+        /// Translates the cached AST of the script. Returns false if there is no valid cache entry.
+        bool compileFromCache(uint32 hash, const String& groupName);
+        /// Compiles the parsed script, adding its AST to the cache if enabled
+        void compileAndCache(uint32 hash, const ConcreteNodeListPtr& nodes, const String& groupName);
     public:
         ScriptCompilerManager();
         virtual ~ScriptCompilerManager();
@@ -445,9 +492,44 @@ namespace Ogre
         const StringVector& getScriptPatterns(void) const;
         /// @copydoc ScriptLoader::parseScript
         void parseScript(DataStreamPtr& stream, const String& groupName);
+        /// Tokenizes and parses the script, unless its AST is available from the script cache
+        Any prepareScript(DataStreamPtr& stream, const String& groupName);
+        /// @copydoc ScriptLoader::parsePreparedScript
+        void parsePreparedScript(DataStreamPtr& stream, const String& groupName, const Any& prepared);
         /// @copydoc ScriptLoader::getLoadingOrder
         Real getLoadingOrder(void) const;
 
+        /** Get if the processed ASTs of compiled scripts should be saved to a cache
+        */
+        bool getSaveScriptsToCache() const { return mSaveScriptsToCache; }
+        /** Set if the processed ASTs of compiled scripts should be saved to a cache
+
+            Cached scripts skip lexing, parsing, import, inheritance and variable processing
+            as long as neither the script nor any of its imports changed. The cache is
+            bypassed while a ScriptCompilerListener is set.
+        */
+        void setSaveScriptsToCache(bool val) { mSaveScriptsToCache = val; }
+
+        /** Returns true if the script cache changed during the run.
+        */
+        bool isScriptCacheDirty(void) const { return mScriptCacheDirty; }
+
+        /** Returns the number of scripts compiled from the cache since it was last loaded.
+        */
+        size_t getScriptCacheHits(void) const { return mScriptCacheHits; }
+
+        /** Saves the script cache to disk.
+        @param stream The destination stream
+        */
+        void saveScriptCache(DataStreamPtr stream) const;
+        /** Loads the script cache from disk.
+
+            A cache written by a different %Ogre version or a truncated cache is discarded,
+            leaving the cache empty.
+        @param stream The source stream
+        */
+        void loadScriptCache(DataStreamPtr stream);
+
         /// @copydoc Singleton::getSingleton()
         static ScriptCompilerManager& getSingleton(void);
         /// @copydoc Singleton::getSingleton()
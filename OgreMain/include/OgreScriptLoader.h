@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreDataStream.h"
 #include "OgreStringVector.h"
+#include "OgreAny.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -77,6 +78,27 @@ namespace Ogre {
         */
         virtual void parseScript(DataStreamPtr& stream, const String& groupName) = 0;
 
+        /** Performs the part of parseScript which can run concurrently for different scripts.
+        @remarks
+            ResourceGroupManager may call this from worker threads for a batch of scripts of this
+            loader, before calling parsePreparedScript for each of them in the usual order. This is
+            skipped while a ResourceLoadingListener is set, as it may replace the opened streams.
+            It must not touch any shared state, e.g. only tokenize and parse the stream.
+            The default implementation does nothing.
+        @return Data passed on to parsePreparedScript, empty if there is nothing to reuse
+        */
+        virtual Any prepareScript(DataStreamPtr& stream, const String& groupName) { return Any(); }
+
+        /** Parse a script file, reusing the result of prepareScript.
+        @param stream The stream passed to prepareScript
+        @param groupName The name of the resource group, as for parseScript
+        @param prepared The result of prepareScript, or empty if it wasn't called or failed
+        */
+        virtual void parsePreparedScript(DataStreamPtr& stream, const String& groupName, const Any& prepared)
+        {
+            parseScript(stream, groupName);
+        }
+
         /** Gets the relative loading order of scripts of this type.
         @remarks
             There are dependencies between some kinds of scripts, and to enforce
@@ -369,6 +369,40 @@ namespace Ogre {
         /// Are there any manually controlled bones?
         virtual bool hasManualBones(void) const { return !mManualBones.empty(); }
 
+        /// One enabled animation in a BonePaletteKey
+        struct BonePaletteKeyEntry
+        {
+            const Animation* animation;
+            int timeStep;
+            Real weight;
+
+            bool operator<(const BonePaletteKeyEntry& o) const
+            {
+                if (animation != o.animation)
+                    return animation < o.animation;
+                if (timeStep != o.timeStep)
+                    return timeStep < o.timeStep;
+                return weight < o.weight;
+            }
+            bool operator==(const BonePaletteKeyEntry& o) const
+            {
+                return animation == o.animation && timeStep == o.timeStep && weight == o.weight;
+            }
+        };
+        /// Identifies an animation state with quantized time positions, sorted by animation
+        typedef std::vector<BonePaletteKeyEntry> BonePaletteKey;
+
+        /** Looks up bone matrices evaluated earlier in the same frame for the given key.
+        @see Entity::setSkeletonEvaluationCacheQuantum
+        @return The matrices, one per bone, or null if nothing was cached
+        */
+        const Affine3* _findCachedBoneMatrices(unsigned long frameNumber, const BonePaletteKey& key) const;
+        /** Stores evaluated bone matrices for the given key.
+        @remarks
+            Entries are only kept for the frame they were added in.
+        */
+        void _cacheBoneMatrices(unsigned long frameNumber, const BonePaletteKey& key, const Affine3* matrices);
+
         /// Map to translate bone handle from one skeleton to another skeleton.
         typedef std::vector<ushort> BoneHandleMap;
 
@@ -449,6 +483,11 @@ namespace Ogre {
         /// Storage of bones, indexed by bone handle
         BoneList mBoneList;
 
+        typedef std::map<BonePaletteKey, std::vector<Affine3> > BonePaletteCache;
+        /// Bone matrices shared between entities, only valid for mBonePaletteCacheFrame
+        BonePaletteCache mBonePaletteCache;
+        unsigned long mBonePaletteCacheFrame;
+
         /** Internal method which parses the bones to derive the root bone. 
         @remarks
             Must be const because called in getRootBone but mRootBone is mutable
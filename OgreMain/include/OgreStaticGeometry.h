@@ -201,7 +201,12 @@ namespace Ogre {
             IndexData* mIndexData;
             /// Maximum vertex indexable
             size_t mMaxVertexIndex;
+            /// Contents of the index buffer followed by the vertex buffers, between _bake and _upload
+            std::vector<std::vector<uchar> > mBakedBuffers;
         public:
+            /// Contents of the index buffer followed by the vertex buffers of a queued geometry
+            typedef std::vector<const uchar*> BufferContents;
+
             GeometryBucket(MaterialBucket* parent, const VertexData* vData, const IndexData* iData);
             virtual ~GeometryBucket();
             MaterialBucket* getParent(void) { return mParent; }
@@ -222,8 +227,21 @@ namespace Ogre {
             @return false if there is no room left in this bucket
             */
             bool assign(QueuedGeometry* qsm);
+            /// Get the geometry queued for the build
+            const QueuedGeometryList& getQueuedGeometry(void) const { return mQueuedGeometry; }
             /// Build
             void build(bool stencilShadows);
+            /// Check that the queued geometry can be built
+            void _prepareBuild(bool stencilShadows);
+            /** Transform the queued geometry into system memory, relative to the region centre.
+            @remarks
+                Only reads the passed contents and writes memory owned by this bucket, so
+                several buckets can be baked concurrently.
+            @param sources the contents of the buffers of each queued geometry
+            */
+            void _bake(const std::vector<BufferContents>& sources);
+            /// Create the hardware buffers from the geometry baked before
+            void _upload(bool stencilShadows);
             /// Dump contents for diagnostics
             void dump(std::ofstream& of) const;
         };
@@ -258,6 +276,8 @@ namespace Ogre {
             void assign(QueuedGeometry* qsm);
             /// Build
             void build(bool stencilShadows);
+            /// Load the material and check the geometry, ahead of baking it
+            void _prepareBuild(bool stencilShadows);
             /// Add children to the render queue
             void addRenderables(RenderQueue* queue, uint8 group, 
                 Real lodValue);
@@ -304,6 +324,9 @@ namespace Ogre {
             bool mVertexProgramInUse;
             /// List of shadow renderables
             ShadowCaster::ShadowRenderableList mShadowRenderables;
+
+            /// Build the edge list of the built geometry for stencil shadows
+            void buildEdgeList(void);
         public:
             LODBucket(Region* parent, unsigned short lod, Real lodValue);
             virtual ~LODBucket();
@@ -316,6 +339,8 @@ namespace Ogre {
             void assign(QueuedSubMesh* qsm, ushort atLod);
             /// Build
             void build(bool stencilShadows);
+            /// Upload the baked geometry of the child buckets
+            void _finishBuild(bool stencilShadows);
             /// Add children to the render queue
             void addRenderables(RenderQueue* queue, uint8 group, 
                 Real lodValue);
@@ -393,6 +418,10 @@ namespace Ogre {
             void assign(QueuedSubMesh* qmesh);
             /// Build this region
             void build(bool stencilShadows);
+            /// Create the buckets of this region, ready for baking their geometry
+            void _prepareBuild(bool stencilShadows);
+            /// Upload the baked geometry and add this region to the scene
+            void _finishBuild(bool stencilShadows);
             /// Get the region ID of this region
             uint32 getID(void) const { return mRegionID; }
             /// Get the centre point of the region
@@ -467,6 +496,15 @@ namespace Ogre {
         /// Map of regions
         RegionMap mRegionMap;
 
+        class BuildHandler;
+        /// Bakes the regions on the WorkQueue for buildInBackground, created on demand
+        std::unique_ptr<BuildHandler> mBuildHandler;
+
+        /// Allocate the queued meshes to regions
+        void allocateRegions(void);
+        /// Finish building the regions, once their geometry is baked
+        void finishBuild(bool stencilShadows);
+
         /** Virtual method for getting a region most suitable for the
             passed in bounds. Can be overridden by subclasses.
         */
@@ -597,6 +635,19 @@ namespace Ogre {
         */
         virtual void build(void);
 
+        /** Build the geometry in the background.
+        @remarks
+            Like build(), but the geometry is baked on the WorkQueue, while the
+            geometry built before stays in place. It is swapped for the new one on
+            the main thread, as soon as all regions are ready. Calling build(),
+            destroy() or reset() meanwhile drops the pending build.
+        @see isBuilding
+        */
+        virtual void buildInBackground(void);
+
+        /// Whether geometry built by buildInBackground() is waiting to be swapped in
+        bool isBuilding(void) const;
+
         /** Destroys all the built geometry state (reverse of build). 
         @remarks
             You can call build() again after this and it will pick up all the
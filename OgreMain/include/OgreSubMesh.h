@@ -209,6 +209,15 @@ namespace Ogre {
         */
         void generateExtremes(size_t count);
 
+        /** Object space extent covered by one unit of the first texture coordinate set
+
+            The square root of the ratio between the object space and the texture space area
+            of the triangles. Multiplied by the pixels per object space unit on screen, this gives
+            the texture resolution needed to map one texel per pixel.
+            @return 0 if the submesh has no triangle list with 2D texture coordinates
+        */
+        Real _getTexelFactor(void) const;
+
         /** Returns true(by default) if the submesh should be included in the mesh EdgeList, otherwise returns false.
         */      
         bool isBuildEdgesEnabled(void) const { return mBuildEdgesEnabled; }
@@ -236,6 +245,9 @@ namespace Ogre {
         /// Is Build Edges Enabled
         bool mBuildEdgesEnabled;
 
+        /// Cached result of _getTexelFactor, negative if not computed yet
+        mutable Real mTexelFactor;
+
         /// the material this SubMesh uses.
         MaterialPtr mMaterial;
 
@@ -322,6 +322,24 @@ namespace Ogre {
         */
         void _loadImages( const ConstImagePtrList& images );
 
+        /** Number of the largest mipmaps of the source image, that are not resident
+
+            Non-zero while the texture is streamed, see TextureManager::setStreamingResidentSize.
+            The texture then has the size of the source image mipmap at this level.
+        */
+        uint32 getMipmapSkip() const { return mMipmapSkip; }
+
+        /// Whether the largest mipmaps of the texture are streamed in on demand
+        bool isStreamed() const { return mResidentMipmapSkip > 0; }
+
+        /** Notify the texture of the resolution it is seen with on screen
+
+            If the texture is streamed and its resident mipmaps are too small for the given size,
+            the missing levels are requested for the end of the frame.
+        @param texels the texture size needed to map one texel per pixel on screen
+        */
+        void _notifyRequiredSize(uint32 texels);
+
         /** Returns the pixel format for the texture surface. */
         PixelFormat getFormat() const
         {
@@ -486,7 +504,26 @@ namespace Ogre {
 
         TextureType mTextureType;
 
+        /// mipmaps of the source image, that are currently not resident
+        uint32 mMipmapSkip;
+        /// mipmap skip the texture was loaded with and falls back to when evicted
+        uint32 mResidentMipmapSkip;
+        /// frame the texture was last seen on screen
+        unsigned long mLastVisibleFrame;
+        /// whether a streaming request for this texture is queued
+        bool mStreamingPending;
+
+        friend class TextureManager;
+        /// reload the texture from its source image with the given mipmap skip
+        void _streamMipmaps(const Image& source, uint32 mipmapSkip);
+        /** decode the source image of a streamed texture into images[0], with the size and mipmaps
+            it was loaded with. Safe to call concurrently. */
+        static void decodeStreamingSource(LoadedImages& images, const DataStreamPtr& stream, const String& ext,
+                                          uint32 width, uint32 height, uint32 numMipmaps);
+
         void readImage(LoadedImages& imgs, const String& name, const String& ext, bool haveNPOT);
+        /// decode an image and scale it to a power of two, if needed. Safe to call concurrently.
+        static void decodeImage(Image& img, const DataStreamPtr& stream, const String& ext, bool haveNPOT);
 
         void prepareImpl();
         void unprepareImpl();
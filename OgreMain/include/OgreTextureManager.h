@@ -400,6 +400,54 @@ namespace Ogre {
             return mDefaultNumMipmaps;
         }
 
+        /** Enables texture streaming
+
+            2D textures using mipmaps are then loaded without the mipmaps larger than the given size.
+            Images without a custom mipmap chain get one generated in software on loading.
+            Once a texture is seen large enough on screen, as derived from the texel density of the
+            mesh, its image is decoded again on the WorkQueue and the missing levels are uploaded
+            at the end of a frame, see setStreamingUploadBudget. No decoded image is kept in host
+            memory meanwhile.
+            @param size largest dimension of the resident mipmap in pixels. 0 disables streaming.
+            @note
+                The default value is 0.
+        */
+        void setStreamingResidentSize(uint32 size) { mStreamingResidentSize = size; }
+
+        /// Gets the largest dimension, streamed textures are initially loaded with
+        uint32 getStreamingResidentSize() const { return mStreamingResidentSize; }
+
+        /** Sets the memory budget of the streamed textures
+
+            Once the textures that have more than their resident mipmaps loaded exceed this size,
+            the ones that were not seen for the longest time fall back to their resident mipmaps.
+            @param bytes budget in bytes. 0 means unlimited.
+            @note
+                The default value is 0.
+        */
+        void setStreamingBudget(size_t bytes) { mStreamingBudget = bytes; }
+
+        /// Gets the memory budget of the streamed textures
+        size_t getStreamingBudget() const { return mStreamingBudget; }
+
+        /** Sets how much texture data of the decoded streaming requests is uploaded per frame
+
+            The remaining requests wait for the next frames, but at least one is uploaded per frame.
+            @param bytes size of the uploaded textures in bytes. 0 means unlimited.
+            @note
+                The default value is 0.
+        */
+        void setStreamingUploadBudget(size_t bytes) { mStreamingUploadBudget = bytes; }
+
+        /// Gets how much texture data of the decoded streaming requests is uploaded per frame
+        size_t getStreamingUploadBudget() const { return mStreamingUploadBudget; }
+
+        /// Internal method to load the mipmaps of a streamed texture down to the given skip
+        void _requestStreaming(Texture* texture, uint32 mipmapSkip);
+
+        /// Internal method to upload the decoded streaming requests at the end of the frame, called by Root
+        void _updateStreaming();
+
         /// Internal method to create a warning texture (bound when a texture unit is blank)
         const TexturePtr& _getWarningTexture();
 
@@ -415,12 +463,31 @@ namespace Ogre {
 
         virtual SamplerPtr _createSamplerImpl() { return std::make_shared<Sampler>(); }
 
+        class StreamingHandler;
+        friend class StreamingHandler;
+        /// evict the least recently seen textures until the streaming budget is met
+        void enforceStreamingBudget();
+
         ushort mPreferredIntegerBitDepth;
         ushort mPreferredFloatBitDepth;
         uint32 mDefaultNumMipmaps;
         TexturePtr mWarningTexture;
         SamplerPtr mDefaultSampler;
         std::map<String, SamplerPtr> mNamedSamplers;
+
+        /// source image decoded on the WorkQueue, waiting to be uploaded
+        struct StreamedImage
+        {
+            TexturePtr texture;
+            uint32 mipmapSkip;
+            size_t stateCount;
+            SharedPtr<std::vector<Image> > images;
+        };
+        std::vector<StreamedImage> mStreamedImages;
+        std::unique_ptr<StreamingHandler> mStreamingHandler;
+        uint32 mStreamingResidentSize;
+        size_t mStreamingBudget;
+        size_t mStreamingUploadBudget;
     };
 
     /// Specialisation of TextureManager for offline processing. Cannot be used with an active RenderSystem.
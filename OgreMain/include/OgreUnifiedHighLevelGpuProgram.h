@@ -126,6 +126,8 @@ namespace Ogre {
         ushort getNumberOfPosesIncluded(void) const;
 
         bool isVertexTextureFetchRequired(void) const;
+        bool isInstancingIncluded(void) const;
+        int getInstancingTexCoordIndex(void) const;
         const GpuProgramParametersPtr& getDefaultParameters(void) override;
         bool hasDefaultParameters(void) const;
         bool getPassSurfaceAndLightStates(void) const;
@@ -384,6 +384,34 @@ namespace Ogre {
 		/** Returns the current colour buffer type for this viewport.*/
 		ColourBufferType getDrawBuffer() const;
 
+        /** Sets whether the render commands issued for this viewport are recorded and replayed.
+
+            When enabled, the SceneManager records the renderables and passes of the visible scene in
+            rendering order the first time the viewport is rendered, together with the per object
+            state derived from them. On the following frames, it replays this list directly, skipping
+            the scene traversal, culling, render queue sorting and most of the state derivation. The
+            recording is discarded when the camera or one of the recorded passes changes, or when a
+            scene node, the visibility or the material of an object changes within the view of the
+            camera. If recordings keep being discarded before they are replayed, recording is
+            attempted less often.
+
+            This is intended for views which rarely change, like security camera feeds, probes or UI
+            viewports. Objects updating their geometry while being queued (e.g. animated entities or
+            particle systems) are not updated while a recording is replayed, call
+            invalidateRenderRecording when they change. Viewports rendering shadows are never recorded.
+        */
+        void setRenderRecordingEnabled(bool enabled);
+
+        /** Returns whether the render commands issued for this viewport are recorded and replayed. */
+        bool getRenderRecordingEnabled(void) const { return mRenderRecording != nullptr; }
+
+        /** Discards the recorded render commands, so they are recorded anew the next time the
+            viewport is rendered. */
+        void invalidateRenderRecording(void);
+
+        /// @private
+        RenderCommandList* _getRenderRecording(void) const { return mRenderRecording.get(); }
+
     private:
         Camera* mCamera;
         RenderTarget* mTarget;
@@ -415,6 +443,9 @@ namespace Ogre {
         typedef std::vector<Listener*> ListenerList;
         ListenerList mListeners;
 		ColourBufferType mColourBuffer;
+
+        /// Render commands recorded by the SceneManager, NULL if recording is disabled
+        std::unique_ptr<RenderCommandList> mRenderRecording;
     };
     /** @} */
     /** @} */
@@ -36,6 +36,7 @@ THE SOFTWARE.
 #include "OgreHeaderPrefix.h"
 
 #include <deque>
+#include <functional>
 
 namespace Ogre
 {
@@ -99,10 +100,15 @@ namespace Ogre
             RequestID mID;
             /// Abort Flag
             mutable bool mAborted;
+            /// Scheduling priority of the channel, higher is processed first
+            int mChannelPriority;
+            /// Scheduling priority among requests of the same channel priority
+            int mPriority;
 
         public:
             /// Constructor 
-            Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid);
+            Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid,
+                    int channelPriority = 0, int priority = 0);
             ~Request();
             /// Set the abort flag
             void abortRequest() const { mAborted = true; }
@@ -118,6 +124,10 @@ namespace Ogre
             RequestID getID() const { return mID; }
             /// Get the abort flag
             bool getAborted() const { return mAborted; }
+            /// Get the scheduling priority of the channel, as it was when the request was added
+            int getChannelPriority() const { return mChannelPriority; }
+            /// Get the scheduling priority of this request within its channel priority
+            int getPriority() const { return mPriority; }
         };
 
         /** General purpose response structure. 
@@ -270,10 +280,12 @@ namespace Ogre
             1. If a request handler can't process multiple requests in parallel.
             2. If you add lot of requests, but you want to keep the game fast.
             3. If you have lot of more important threads. (example: physics).
+        @param priority Orders the pending requests of the same channel priority, higher is
+            processed first, see setChannelPriority. Not used for synchronous and idle requests.
         @return The ID of the request that has been added
         */
         virtual RequestID addRequest(uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount = 0, 
-            bool forceSynchronous = false, bool idleThread = false) = 0;
+            bool forceSynchronous = false, bool idleThread = false, int priority = 0) = 0;
 
         /** Abort a previously issued request.
         If the request is still waiting to be processed, it will be 
@@ -365,6 +377,28 @@ namespace Ogre
         */
         virtual uint16 getChannel(const String& channelName);
 
+        /** Set the scheduling priority of the requests of a channel.
+        @remarks
+            Pending requests with a higher channel priority are processed first. Within
+            the same channel priority, the priority passed to addRequest decides, and
+            requests of equal priorities are processed in the order they were added.
+            The default priority is 0. This only affects requests added afterwards,
+            and is ignored by implementations that do not support priorities.
+        */
+        virtual void setChannelPriority(uint16 channel, int priority) {}
+        /// Get the scheduling priority of the requests of a channel
+        virtual int getChannelPriority(uint16 channel) const { return 0; }
+
+        /** Run a function over the index range [0, count) and return once all calls are done.
+        @remarks
+            Implementations may call func concurrently from several threads, so it must
+            only touch data owned by the given index. The default implementation
+            simply loops on the calling thread.
+            If func throws, the first exception is rethrown on the calling thread once all
+            threads are done. Indices not yet started at that point may be skipped.
+        */
+        virtual void parallelFor(size_t count, const std::function<void(size_t)>& func);
+
     };
 
     /** Base for a general purpose request / response style background work queue.
@@ -444,7 +478,7 @@ namespace Ogre
 
         /// @copydoc WorkQueue::addRequest
         virtual RequestID addRequest(uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount = 0, 
-            bool forceSynchronous = false, bool idleThread = false);
+            bool forceSynchronous = false, bool idleThread = false, int priority = 0);
         /// @copydoc WorkQueue::abortRequest
         virtual void abortRequest(RequestID id);
         /// @copydoc WorkQueue::abortPendingRequest
@@ -469,6 +503,22 @@ namespace Ogre
         virtual unsigned long getResponseProcessingTimeLimit() const { return mResposeTimeLimitMS; }
         /// @copydoc WorkQueue::setResponseProcessingTimeLimit
         virtual void setResponseProcessingTimeLimit(unsigned long ms) { mResposeTimeLimitMS = ms; }
+
+        /// @copydoc WorkQueue::setChannelPriority
+        virtual void setChannelPriority(uint16 channel, int priority);
+        /// @copydoc WorkQueue::getChannelPriority
+        virtual int getChannelPriority(uint16 channel) const;
+
+        /** @copydoc WorkQueue::parallelFor
+        @remarks
+            The calling thread takes part in the work, while up to getWorkerThreadCount()
+            requests are queued so that idle workers can pick up the remaining indices.
+            Indices are handed out in chunks to keep the threads from contending on
+            every call. The helper requests are queued ahead of all other requests,
+            as the calling thread is waiting for them.
+            Falls back to the serial loop if the queue is not running or is paused.
+        */
+        virtual void parallelFor(size_t count, const std::function<void(size_t)>& func);
     protected:
         String mName;
         size_t mWorkerThreadCount;
@@ -478,7 +528,7 @@ namespace Ogre
 
         typedef std::deque<Request*> RequestQueue;
         typedef std::deque<Response*> ResponseQueue;
-        RequestQueue mRequestQueue; // Guarded by mRequestMutex
+        RequestQueue mRequestQueue; // Guarded by mRequestMutex, sorted by decreasing channel and request priority
         RequestQueue mProcessQueue; // Guarded by mProcessMutex
         ResponseQueue mResponseQueue; // Guarded by mResponseMutex
 
@@ -555,6 +605,7 @@ namespace Ogre
         RequestHandlerListByChannel mRequestHandlers;
         ResponseHandlerListByChannel mResponseHandlers;
         RequestID mRequestCount; // Guarded by mRequestMutex
+        std::vector<int> mChannelPriorities; // Guarded by mRequestMutex
         bool mPaused;
         bool mAcceptRequests;
         bool mShuttingDown;
@@ -576,7 +627,10 @@ namespace Ogre
         /// Notify workers about a new request. 
         virtual void notifyWorkers() = 0;
         /// Put a Request on the queue with a specific RequestID.
-        void addRequestWithRID(RequestID rid, uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount);
+        void addRequestWithRID(RequestID rid, uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount,
+                               int priority);
+        /// Insert a request behind the pending ones of the same or higher priority, mRequestMutex must be held
+        void queueRequest(Request* req);
         
         RequestQueue mIdleRequestQueue; // Guarded by mIdleMutex
         bool mIdleThreadRunning; // Guarded by mIdleMutex
@@ -584,6 +638,15 @@ namespace Ogre
         
 
         bool processIdleRequests();
+
+        /// Runs the share of a parallelFor task picked up by a worker thread
+        class _OgreExport ParallelForHandler : public RequestHandler
+        {
+        public:
+            Response* handleRequest(const Request* req, const WorkQueue* srcQ);
+        };
+        ParallelForHandler mParallelForHandler;
+        uint16 mParallelForChannel;
     };
 
 
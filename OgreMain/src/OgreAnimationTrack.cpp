@@ -863,6 +863,11 @@ namespace Ogre {
             // key 2 and interpolate the influence
             const VertexPoseKeyFrame::PoseRefList& poseList1 = vkf1->getPoseReferences();
             const VertexPoseKeyFrame::PoseRefList& poseList2 = vkf2->getPoseReferences();
+            // In software, gather the poses and blend them all with a single lock
+            const bool software = mTargetMode != TM_HARDWARE;
+            Mesh::PoseWeightList softwarePoses;
+            if (software)
+                softwarePoses.reserve(poseList1.size() + poseList2.size());
             for (VertexPoseKeyFrame::PoseRefList::const_iterator p1 = poseList1.begin();
                 p1 != poseList1.end(); ++p1)
             {
@@ -886,7 +891,10 @@ namespace Ogre {
                 assert (poseList && p1->poseIndex < poseList->size());
                 Pose* pose = (*poseList)[p1->poseIndex];
                 // apply
-                applyPoseToVertexData(pose, data, influence);
+                if (software)
+                    softwarePoses.push_back(std::make_pair(pose, influence));
+                else
+                    applyPoseToVertexData(pose, data, influence);
             }
             // Now deal with any poses in key 2 which are not in key 1
             for (VertexPoseKeyFrame::PoseRefList::const_iterator p2 = poseList2.begin();
@@ -912,9 +920,15 @@ namespace Ogre {
                     assert (poseList && p2->poseIndex <= poseList->size());
                     const Pose* pose = (*poseList)[p2->poseIndex];
                     // apply
-                    applyPoseToVertexData(pose, data, influence);
+                    if (software)
+                        softwarePoses.push_back(std::make_pair(pose, influence));
+                    else
+                        applyPoseToVertexData(pose, data, influence);
                 }
             } // key 2 iteration
+
+            if (!softwarePoses.empty())
+                Mesh::softwareVertexPoseBlend(softwarePoses, data);
         } // morph or pose animation
     }
     //-----------------------------------------------------------------------------
@@ -312,34 +312,33 @@ namespace Ogre {
         mNumVisibleBillboards = 0;
 
         // Lock the buffer
-        if (numBillboards) // optimal lock
+        // just one vertex per billboard (this also excludes texcoords), or 4 corners
+        size_t billboardVertices = mPointRendering ? 1 : 4;
+        // clamp to max, or lock the entire thing
+        numBillboards = numBillboards ? std::min(mPoolSize, numBillboards) : mPoolSize;
+
+        // Dynamic data is appended to the shared ring, if there is room
+        bool dynamic = mMainBuf->getUsage() & HardwareBuffer::HBU_DYNAMIC;
+        VertexBufferRing* ring =
+            dynamic ? HardwareBufferManager::getSingleton().getDynamicVertexRing(mMainBuf->getVertexSize()) : NULL;
+        if (ring)
         {
-            // clamp to max
-            numBillboards = std::min(mPoolSize, numBillboards);
-
-            size_t billboardSize;
-            if (mPointRendering)
-            {
-                // just one vertex per billboard (this also excludes texcoords)
-                billboardSize = mMainBuf->getVertexSize();
-            }
-            else
+            size_t vertexStart;
+            mLockPtr = static_cast<float*>(ring->lock(numBillboards * billboardVertices,
+                                                      Root::getSingleton().getNextFrameNumber(), vertexStart));
+            if (mLockPtr)
             {
-                // 4 corners
-                billboardSize = mMainBuf->getVertexSize() * 4;
+                mVertexData->vertexBufferBinding->setBinding(0, ring->getBuffer());
+                mVertexData->vertexStart = vertexStart;
+                return;
             }
-            assert (numBillboards * billboardSize <= mMainBuf->getSizeInBytes());
-
-            mLockPtr = static_cast<float*>(
-                mMainBuf->lock(0, numBillboards * billboardSize, 
-                mMainBuf->getUsage() & HardwareBuffer::HBU_DYNAMIC ?
-                HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL) );
         }
-        else // lock the entire thing
-            mLockPtr = static_cast<float*>(
-            mMainBuf->lock(mMainBuf->getUsage() & HardwareBuffer::HBU_DYNAMIC ?
-            HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL) );
 
+        mVertexData->vertexBufferBinding->setBinding(0, mMainBuf);
+        mVertexData->vertexStart = 0;
+        mLockPtr = static_cast<float*>(
+            mMainBuf->lock(0, numBillboards * billboardVertices * mMainBuf->getVertexSize(),
+            dynamic ? HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL) );
     }
     //-----------------------------------------------------------------------
     void BillboardSet::injectBillboard(const Billboard& bb)
@@ -386,7 +385,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void BillboardSet::endBillboards(void)
     {
-        mMainBuf->unlock();
+        // either our own buffer or the ring
+        mVertexData->vertexBufferBinding->getBuffer(0)->unlock();
     }
     //-----------------------------------------------------------------------
     void BillboardSet::setBounds(const AxisAlignedBox& box, Real radius)
@@ -482,8 +482,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void BillboardSet::getRenderOperation(RenderOperation& op)
     {
+        // vertexStart is set when locking
         op.vertexData = mVertexData.get();
-        op.vertexData->vertexStart = 0;
 
         if (mPointRendering)
         {
@@ -294,7 +294,7 @@ public:
         {
             auto params = pass->getGpuProgramParameters(GPT_COMPUTE_PROGRAM);
             params->_updateAutoParams(sm->_getAutoParamDataSource(), GPV_GLOBAL);
-            rs->bindGpuProgram(pass->getComputeProgram()->_getBindingDelegate());
+            sm->bindGpuProgram(pass->getComputeProgram()->_getBindingDelegate());
             rs->bindGpuProgramParameters(GPT_COMPUTE_PROGRAM, params, GPV_GLOBAL);
             rs->_dispatchCompute(thread_groups);
         }
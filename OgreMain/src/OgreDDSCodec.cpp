@@ -741,6 +741,69 @@ namespace {
             pCol[i].a = derivedAlphas[dw & 0x7];
     }
     //---------------------------------------------------------------------
+    void DDSCodec::decompressDXTLevel(const uchar* src, PixelFormat sourceFormat, uchar* dst, PixelFormat format,
+                                      uint32 width, uint32 height, uint32 depth) const
+    {
+        DXTColourBlock col;
+        DXTInterpolatedAlphaBlock iAlpha;
+        DXTExplicitAlphaBlock eAlpha;
+        // 4x4 block of decompressed colour
+        ColourValue tempColours[16];
+        size_t destBpp = PixelUtil::getNumElemBytes(format);
+        size_t dstPitch = width * destBpp;
+
+        // slices are done individually
+        for(size_t z = 0; z < depth; ++z)
+        {
+            // 4x4 blocks in x/y
+            for (size_t y = 0; y < height; y += 4)
+            {
+                size_t sy = std::min<size_t>( height - y, 4u );
+
+                for (size_t x = 0; x < width; x += 4)
+                {
+                    size_t sx = std::min<size_t>( width - x, 4u );
+
+                    if (sourceFormat == PF_DXT2 || 
+                        sourceFormat == PF_DXT3)
+                    {
+                        // explicit alpha
+                        memcpy(&eAlpha, src, sizeof(DXTExplicitAlphaBlock));
+                        src += sizeof(DXTExplicitAlphaBlock);
+                        flipEndian(eAlpha.alphaRow, sizeof(uint16), 4);
+                        unpackDXTAlpha(eAlpha, tempColours) ;
+                    }
+                    else if (sourceFormat == PF_DXT4 || 
+                        sourceFormat == PF_DXT5)
+                    {
+                        // interpolated alpha
+                        memcpy(&iAlpha, src, sizeof(DXTInterpolatedAlphaBlock));
+                        src += sizeof(DXTInterpolatedAlphaBlock);
+                        flipEndian(&(iAlpha.alpha_0), sizeof(uint16));
+                        flipEndian(&(iAlpha.alpha_1), sizeof(uint16));
+                        unpackDXTAlpha(iAlpha, tempColours) ;
+                    }
+                    // always read colour
+                    memcpy(&col, src, sizeof(DXTColourBlock));
+                    src += sizeof(DXTColourBlock);
+                    flipEndian(&(col.colour_0), sizeof(uint16));
+                    flipEndian(&(col.colour_1), sizeof(uint16));
+                    unpackDXTColour(sourceFormat, col, tempColours);
+
+                    // write 4x4 block to uncompressed version
+                    uchar* blockPtr = dst + (z * height + y) * dstPitch + x * destBpp;
+                    for (size_t by = 0; by < sy; ++by)
+                    {
+                        for (size_t bx = 0; bx < sx; ++bx)
+                            PixelUtil::packColour(tempColours[by*4+bx], format, blockPtr + bx * destBpp);
+                        // advance to next row
+                        blockPtr += dstPitch;
+                    }
+                }
+            }
+        }
+    }
+    //---------------------------------------------------------------------
     ImageCodec::DecodeResult DDSCodec::decode(const DataStreamPtr& stream) const
     {
         // Read 4 character code
@@ -904,110 +967,65 @@ namespace {
         // Now deal with the data
         void* destPtr = output->getPtr();
 
-        // all mips for a face, then each face
-        for(size_t i = 0; i < numFaces; ++i)
+        if (decompressDXT)
         {
-            uint32 width = imgData->width;
-            uint32 height = imgData->height;
-            uint32 depth = imgData->depth;
-
-            for(size_t mip = 0; mip <= imgData->num_mipmaps; ++mip)
+            // all mips for a face, then each face. Read the blocks of all levels into memory, then
+            // decompress the levels in parallel
+            struct Level
             {
-                size_t dstPitch = width * PixelUtil::getNumElemBytes(imgData->format);
-                
-                if (PixelUtil::isCompressed(sourceFormat))
+                size_t src;
+                uchar* dst;
+                uint32 width, height, depth;
+            };
+            std::vector<Level> levels;
+            size_t srcSize = 0;
+            for(size_t i = 0; i < numFaces; ++i)
+            {
+                uint32 width = imgData->width;
+                uint32 height = imgData->height;
+                uint32 depth = imgData->depth;
+
+                for(size_t mip = 0; mip <= imgData->num_mipmaps; ++mip)
                 {
-                    // Compressed data
-                    if (decompressDXT)
-                    {
-                        DXTColourBlock col;
-                        DXTInterpolatedAlphaBlock iAlpha;
-                        DXTExplicitAlphaBlock eAlpha;
-                        // 4x4 block of decompressed colour
-                        ColourValue tempColours[16];
-                        size_t destBpp = PixelUtil::getNumElemBytes(imgData->format);
-
-                        // slices are done individually
-                        for(size_t z = 0; z < depth; ++z)
-                        {
-                            size_t remainingHeight = height;
+                    levels.push_back({srcSize, static_cast<uchar*>(destPtr), width, height, depth});
+                    srcSize += PixelUtil::getMemorySize(width, height, depth, sourceFormat);
+                    destPtr = static_cast<uchar*>(destPtr) +
+                              PixelUtil::getMemorySize(width, height, depth, imgData->format);
+
+                    /// Next mip
+                    if(width!=1) width /= 2;
+                    if(height!=1) height /= 2;
+                    if(depth!=1) depth /= 2;
+                }
+            }
 
-                            // 4x4 blocks in x/y
-                            for (size_t y = 0; y < height; y += 4)
-                            {
-                                size_t sy = std::min<size_t>( remainingHeight, 4u );
-                                remainingHeight -= sy;
-
-                                size_t remainingWidth = width;
-
-                                for (size_t x = 0; x < width; x += 4)
-                                {
-                                    size_t sx = std::min<size_t>( remainingWidth, 4u );
-                                    size_t destPitchMinus4 = dstPitch - destBpp * sx;
-
-                                    remainingWidth -= sx;
-
-                                    if (sourceFormat == PF_DXT2 || 
-                                        sourceFormat == PF_DXT3)
-                                    {
-                                        // explicit alpha
-                                        stream->read(&eAlpha, sizeof(DXTExplicitAlphaBlock));
-                                        flipEndian(eAlpha.alphaRow, sizeof(uint16), 4);
-                                        unpackDXTAlpha(eAlpha, tempColours) ;
-                                    }
-                                    else if (sourceFormat == PF_DXT4 || 
-                                        sourceFormat == PF_DXT5)
-                                    {
-                                        // interpolated alpha
-                                        stream->read(&iAlpha, sizeof(DXTInterpolatedAlphaBlock));
-                                        flipEndian(&(iAlpha.alpha_0), sizeof(uint16));
-                                        flipEndian(&(iAlpha.alpha_1), sizeof(uint16));
-                                        unpackDXTAlpha(iAlpha, tempColours) ;
-                                    }
-                                    // always read colour
-                                    stream->read(&col, sizeof(DXTColourBlock));
-                                    flipEndian(&(col.colour_0), sizeof(uint16));
-                                    flipEndian(&(col.colour_1), sizeof(uint16));
-                                    unpackDXTColour(sourceFormat, col, tempColours);
-
-                                    // write 4x4 block to uncompressed version
-                                    for (size_t by = 0; by < sy; ++by)
-                                    {
-                                        for (size_t bx = 0; bx < sx; ++bx)
-                                        {
-                                            PixelUtil::packColour(tempColours[by*4+bx],
-                                                imgData->format, destPtr);
-                                            destPtr = static_cast<void*>(
-                                                static_cast<uchar*>(destPtr) + destBpp);
-                                        }
-                                        // advance to next row
-                                        destPtr = static_cast<void*>(
-                                            static_cast<uchar*>(destPtr) + destPitchMinus4);
-                                    }
-                                    // next block. Our dest pointer is 4 lines down
-                                    // from where it started
-                                    if (x + 4 >= width)
-                                    {
-                                        // Jump back to the start of the line
-                                        destPtr = static_cast<void*>(
-                                            static_cast<uchar*>(destPtr) - destPitchMinus4);
-                                    }
-                                    else
-                                    {
-                                        // Jump back up 4 rows and 4 pixels to the
-                                        // right to be at the next block to the right
-                                        destPtr = static_cast<void*>(
-                                            static_cast<uchar*>(destPtr) - dstPitch * sy + destBpp * sx);
-
-                                    }
-
-                                }
+            std::vector<uchar> src(srcSize);
+            if (stream->read(src.data(), srcSize) != srcSize)
+            {
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Unexpected end of DDS data", "DDSCodec::decode");
+            }
 
-                            }
-                        }
+            auto decompressLevel = [&](size_t i) {
+                const Level& l = levels[i];
+                decompressDXTLevel(&src[l.src], sourceFormat, l.dst, imgData->format, l.width, l.height,
+                                   l.depth);
+            };
+            Root::getSingleton().getWorkQueue()->parallelFor(levels.size(), decompressLevel);
+        }
+        else
+        {
+            // all mips for a face, then each face
+            for(size_t i = 0; i < numFaces; ++i)
+            {
+                uint32 width = imgData->width;
+                uint32 height = imgData->height;
+                uint32 depth = imgData->depth;
 
-                    }
-                    else
+                for(size_t mip = 0; mip <= imgData->num_mipmaps; ++mip)
+                {
+                    size_t dstPitch = width * PixelUtil::getNumElemBytes(imgData->format);
+
+                    if (PixelUtil::isCompressed(sourceFormat))
                     {
                         // load directly
                         // DDS format lies! sizeOrPitch is not always set for DXT!!
@@ -1015,27 +1033,25 @@ namespace {
                         stream->read(destPtr, dxtSize);
                         destPtr = static_cast<void*>(static_cast<uchar*>(destPtr) + dxtSize);
                     }
-
-                }
-                else
-                {
-                    // Note: We assume the source and destination have the same pitch
-                    for (size_t z = 0; z < depth; ++z)
+                    else
                     {
-                        for (size_t y = 0; y < height; ++y)
+                        // Note: We assume the source and destination have the same pitch
+                        for (size_t z = 0; z < depth; ++z)
                         {
-                            stream->read(destPtr, dstPitch);
-                            destPtr = static_cast<void*>(static_cast<uchar*>(destPtr) + dstPitch);
+                            for (size_t y = 0; y < height; ++y)
+                            {
+                                stream->read(destPtr, dstPitch);
+                                destPtr = static_cast<void*>(static_cast<uchar*>(destPtr) + dstPitch);
+                            }
                         }
                     }
-                }
 
-                /// Next mip
-                if(width!=1) width /= 2;
-                if(height!=1) height /= 2;
-                if(depth!=1) depth /= 2;
+                    /// Next mip
+                    if(width!=1) width /= 2;
+                    if(height!=1) height /= 2;
+                    if(depth!=1) depth /= 2;
+                }
             }
-
         }
 
         DecodeResult ret;
@@ -65,6 +65,9 @@ namespace Ogre {
         void unpackDXTAlpha(const DXTExplicitAlphaBlock& block, ColourValue* pCol) const;
         /// Unpack DXT alphas into array of 16 colour values
         void unpackDXTAlpha(const DXTInterpolatedAlphaBlock& block, ColourValue* pCol) const;
+        /// Decompress the DXT blocks of one mipmap level. Safe to call concurrently.
+        void decompressDXTLevel(const uchar* src, PixelFormat sourceFormat, uchar* dst, PixelFormat format,
+                                uint32 width, uint32 height, uint32 depth) const;
 
         /// Single registered codec instance
         static DDSCodec* msInstance;
@@ -27,6 +27,19 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32 || OGRE_PLATFORM == OGRE_PLATFORM_WINRT
+#  define WIN32_LEAN_AND_MEAN
+#  if !defined(NOMINMAX) && defined(_MSC_VER)
+#   define NOMINMAX // required to stop windows.h messing up std::min
+#  endif
+#  include <windows.h>
+#else
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
 namespace Ogre {
 
     //-----------------------------------------------------------------------
@@ -760,5 +773,92 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    static size_t gMinMappedSize = 1024 * 1024;
+    //-----------------------------------------------------------------------
+    MemoryMappedDataStream::MemoryMappedDataStream(const String& name, const SharedPtr<void>& mapping,
+                                                   uchar* data, size_t size)
+        : MemoryDataStream(name, data, size, false, true), mMapping(mapping)
+    {
+    }
+    //-----------------------------------------------------------------------
+    MemoryMappedDataStream::MemoryMappedDataStream(const String& name, MemoryMappedDataStream& source,
+                                                   size_t offset, size_t size)
+        : MemoryDataStream(name, source.getPtr() + offset, size, false, true), mMapping(source.mMapping)
+    {
+        OgreAssert(offset + size <= source.size(), "range exceeds the mapped file");
+    }
+    //-----------------------------------------------------------------------
+    SharedPtr<MemoryMappedDataStream> MemoryMappedDataStream::open(const String& path, const String& name,
+                                                                   size_t minSize)
+    {
+        SharedPtr<void> mapping;
+        size_t size = 0;
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            return SharedPtr<MemoryMappedDataStream>();
+
+        LARGE_INTEGER fileSize;
+        HANDLE fileMapping = NULL;
+        // empty files cannot be mapped
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 && uint64(fileSize.QuadPart) >= minSize)
+            fileMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle(file);
+        if (!fileMapping)
+            return SharedPtr<MemoryMappedDataStream>();
+
+        // the view keeps the mapping object alive
+        void* data = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(fileMapping);
+        if (!data)
+            return SharedPtr<MemoryMappedDataStream>();
+
+        size = size_t(fileSize.QuadPart);
+        mapping.reset(data, [](void* p) { UnmapViewOfFile(p); });
+#elif OGRE_PLATFORM != OGRE_PLATFORM_WINRT
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return SharedPtr<MemoryMappedDataStream>();
+
+        struct stat tagStat;
+        void* data = MAP_FAILED;
+        // empty files cannot be mapped, while pipes and devices might not behave like files
+        if (fstat(fd, &tagStat) == 0 && S_ISREG(tagStat.st_mode) && tagStat.st_size > 0 &&
+            uint64(tagStat.st_size) >= minSize)
+        {
+            size = size_t(tagStat.st_size);
+            data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if (data == MAP_FAILED)
+            return SharedPtr<MemoryMappedDataStream>();
+
+        mapping.reset(data, [size](void* p) { munmap(p, size); });
+#endif
+        if (!mapping)
+            return SharedPtr<MemoryMappedDataStream>();
+
+        return SharedPtr<MemoryMappedDataStream>(OGRE_NEW MemoryMappedDataStream(
+            name.empty() ? path : name, mapping, static_cast<uchar*>(mapping.get()), size));
+    }
+    //-----------------------------------------------------------------------
+    void MemoryMappedDataStream::close(void)
+    {
+        MemoryDataStream::close();
+        mMapping.reset();
+    }
+    //-----------------------------------------------------------------------
+    void MemoryMappedDataStream::setMinMappedSize(size_t size)
+    {
+        gMinMappedSize = size;
+    }
+    //-----------------------------------------------------------------------
+    size_t MemoryMappedDataStream::getMinMappedSize()
+    {
+        return gMinMappedSize;
+    }
+    //-----------------------------------------------------------------------
 
 }
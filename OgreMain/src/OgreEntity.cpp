@@ -33,9 +33,74 @@ Copyright (c) 2000-2014 Torus Knot Software Ltd
 #include "OgreOptimisedUtil.h"
 #include "OgreLodStrategy.h"
 #include "OgreLodListener.h"
+#include "OgrePixelCountLodStrategy.h"
 
 
 namespace Ogre {
+    namespace {
+        /// Tells streamed textures the resolution they are seen with on screen
+        void notifyTextureRequiredSize(const Technique* tech, const SubMesh* subMesh, Real pixelsPerUnit,
+                                       Real screenSize)
+        {
+            Real texelFactor = subMesh->_getTexelFactor();
+            for (const Pass* pass : tech->getPasses())
+            {
+                for (const TextureUnitState* tus : pass->getTextureUnitStates())
+                {
+                    const TexturePtr& tex = tus->_getTexturePtr();
+                    if (!tex)
+                        continue;
+
+                    // the texel density is only known for the first texture coordinate set,
+                    // otherwise assume the texture covers the whole entity
+                    Real size = screenSize;
+                    if (texelFactor > 0 && tus->getTextureCoordSet() == 0)
+                    {
+                        Real scale = std::min(std::abs(tus->getTextureUScale()), std::abs(tus->getTextureVScale()));
+                        size = pixelsPerUnit * texelFactor / std::max(scale, Real(1e-3));
+                    }
+                    tex->_notifyRequiredSize(uint32(std::min<Real>(size, 1 << 16)));
+                }
+            }
+        }
+
+        int quantizeTime(Real time, Real quantum) { return int(Math::Floor(time / quantum + 0.5f)); }
+
+        /// Builds the key of the skeleton evaluation cache, false if the animation state can't be shared
+        bool buildBonePaletteKey(const AnimationStateSet& states, const SkeletonInstance* skeleton,
+                                 Real quantum, Skeleton::BonePaletteKey& key)
+        {
+            for (const AnimationState* state : states.getEnabledAnimationStates())
+            {
+                if (state->hasBlendMask())
+                    return false;
+
+                // Vertex animations of the mesh don't affect the bones
+                const Animation* anim = skeleton->_getAnimationImpl(state->getAnimationName());
+                if (!anim)
+                    continue;
+
+                Skeleton::BonePaletteKeyEntry entry = {anim, quantizeTime(state->getTimePosition(), quantum),
+                                                       state->getWeight()};
+                key.push_back(entry);
+            }
+            std::sort(key.begin(), key.end());
+            return true;
+        }
+
+        /// Copies the enabled animation states, with the time positions rounded as in the key
+        void quantizeAnimationStates(const AnimationStateSet& states, Real quantum, AnimationStateSet& quantized)
+        {
+            for (const AnimationState* state : states.getEnabledAnimationStates())
+            {
+                AnimationState* copy = quantized.createAnimationState(state->getAnimationName(), 0,
+                                                                      state->getLength(), state->getWeight());
+                copy->setEnabled(true);
+                copy->setLoop(state->getLoop());
+                copy->setTimePosition(quantizeTime(state->getTimePosition(), quantum) * quantum);
+            }
+        }
+    }
     //-----------------------------------------------------------------------
     Entity::Entity ()
         : mAnimationState(NULL),
@@ -57,6 +122,11 @@ namespace Ogre {
           mFrameAnimationLastUpdated(std::numeric_limits<unsigned long>::max()),
           mFrameBonesLastUpdated(NULL),
           mSharedSkeletonEntities(NULL),
+          mFrameAnimationLodLastEvaluated(std::numeric_limits<unsigned long>::max()),
+          mFrameAnimationLodPrevEvaluated(std::numeric_limits<unsigned long>::max()),
+          mAnimationLodIndex(0),
+          mAnimationLodInterpolation(true),
+          mSkeletonEvaluationCacheQuantum(0),
         mSoftwareAnimationRequests(0),
         mSoftwareAnimationNormalsRequests(0),
         mMeshLodIndex(0),
@@ -227,6 +297,8 @@ namespace Ogre {
         if (mSkeletonInstance) {
             OGRE_FREE_SIMD(mBoneWorldMatrices, MEMCATEGORY_ANIMATION);
             mBoneWorldMatrices = 0;
+            mAnimationLodPoses.clear();
+            mAnimationLodMatrices.clear();
 
             if (mSharedSkeletonEntities) {
                 mSharedSkeletonEntities->erase(this);
@@ -377,18 +449,36 @@ namespace Ogre {
             // Notify LOD event listeners
             cam->getSceneManager()->_notifyEntityMeshLodChanged(evt);
 
-            // Change LOD index
-            mMeshLodIndex = evt.newLodIndex;
+            // Change LOD index, falling back to a coarser level while a streamed one is loaded
+            mMeshLodIndex = mMesh->_getResidentLodIndex(evt.newLodIndex);
+
+            // Reduce the skeleton update rate of distant entities
+            if (!mAnimationLodValues.empty())
+                mAnimationLodIndex = meshStrategy->getIndex(biasedMeshLodValue, mAnimationLodValues);
 
             // Now do material LOD
             lodValue *= mMaterialLodFactorTransformed;
 #endif
 
 
+            // Diameter of the entity on screen, which drives texture streaming
+            Real screenSize = 0, pixelsPerUnit = 0;
+            TextureManager* texMgr = TextureManager::getSingletonPtr();
+            if (texMgr && texMgr->getStreamingResidentSize() && cam->getLodCamera()->getViewport())
+            {
+                Real area = AbsolutePixelCountLodStrategy::getSingleton().getValue(this, cam);
+                screenSize = 2 * Math::Sqrt(area / Math::PI);
+                if (mMesh->getBoundingSphereRadius() > 0)
+                    pixelsPerUnit = screenSize / (2 * mMesh->getBoundingSphereRadius());
+            }
+
             SubEntityList::iterator i, iend;
             iend = mSubEntityList.end();
             for (i = mSubEntityList.begin(); i != iend; ++i)
             {
+                if (screenSize > 0 && (*i)->isVisible() && (*i)->getTechnique())
+                    notifyTextureRequiredSize((*i)->getTechnique(), (*i)->getSubMesh(), pixelsPerUnit, screenSize);
+
 #if !OGRE_NO_MESHLOD
                 // Get sub-entity material
                 const MaterialPtr& material = (*i)->getMaterial();
@@ -792,6 +882,14 @@ namespace Ogre {
         bool animationDirty =
             (mFrameAnimationLastUpdated != mAnimationState->getDirtyFrameNumber()) ||
             (hasSkeleton() && getSkeleton()->getManualBonesDirty());
+
+        // Without interpolation the bone matrices stay untouched on frames skipped by the
+        // animation LOD, so there is nothing to blend either
+        if (animationDirty && !mAnimationLodInterpolation && hasSkeleton() && !hasVertexAnimation() &&
+            !getSkeleton()->getManualBonesDirty() && !isAnimationLodUpdateDue(root.getNextFrameNumber()))
+        {
+            animationDirty = false;
+        }
         
         //update the current hardware animation state
         mCurrentHWAnimationState = hwAnimation;
@@ -1359,9 +1457,59 @@ namespace Ogre {
         if ((*mFrameBonesLastUpdated != currentFrameNumber) ||
             (hasSkeleton() && getSkeleton()->getManualBonesDirty()))
         {
-            if ((!mSkipAnimStateUpdates) && (*mFrameBonesLastUpdated != currentFrameNumber))
+            bool manualBonesDirty = hasSkeleton() && getSkeleton()->getManualBonesDirty();
+            if (!manualBonesDirty && !isAnimationLodUpdateDue(currentFrameNumber))
+            {
+                // Skipped by the animation LOD, reuse or extrapolate the last evaluated poses
+                *mFrameBonesLastUpdated = currentFrameNumber;
+                return mAnimationLodInterpolation && extrapolateAnimationLodPose(currentFrameNumber);
+            }
+
+            // Try the bone matrices other entities evaluated for the same animation state
+            Skeleton::BonePaletteKey paletteKey;
+            Skeleton* paletteCache = NULL;
+            if (mSkeletonEvaluationCacheQuantum > 0 && !mSkipAnimStateUpdates && !manualBonesDirty &&
+                !mSharedSkeletonEntities && mAnimationLodIndex == 0 && mChildObjectList.empty() &&
+                !mDisplaySkeleton && !mUpdateBoundingBoxFromSkeleton && !mSkeletonInstance->hasManualBones() &&
+                buildBonePaletteKey(*mAnimationState, mSkeletonInstance, mSkeletonEvaluationCacheQuantum,
+                                    paletteKey))
+            {
+                paletteCache = mMesh->getSkeleton().get();
+                if (const Affine3* cached = paletteCache->_findCachedBoneMatrices(currentFrameNumber, paletteKey))
+                {
+                    std::copy(cached, cached + mNumBoneMatrices, mBoneMatrices);
+                    mFrameAnimationLodLastEvaluated = std::numeric_limits<unsigned long>::max();
+                    *mFrameBonesLastUpdated = currentFrameNumber;
+                    return true;
+                }
+            }
+
+            if (paletteCache)
+            {
+                // the cached matrices must not depend on the times of the entity evaluating them
+                AnimationStateSet quantized;
+                quantizeAnimationStates(*mAnimationState, mSkeletonEvaluationCacheQuantum, quantized);
+                mSkeletonInstance->setAnimationState(quantized);
+            }
+            else if ((!mSkipAnimStateUpdates) && (*mFrameBonesLastUpdated != currentFrameNumber))
                 mSkeletonInstance->setAnimationState(*mAnimationState);
+
             mSkeletonInstance->_getBoneMatrices(mBoneMatrices);
+
+            if (mAnimationLodIndex > 0 && !mSharedSkeletonEntities)
+            {
+                if (mAnimationLodInterpolation)
+                    storeAnimationLodPose(currentFrameNumber);
+                mFrameAnimationLodLastEvaluated = currentFrameNumber;
+            }
+            else
+            {
+                // Force an evaluation as soon as a reduced rate is used again
+                mFrameAnimationLodLastEvaluated = std::numeric_limits<unsigned long>::max();
+            }
+
+            if (paletteCache)
+                paletteCache->_cacheBoneMatrices(currentFrameNumber, paletteKey, mBoneMatrices);
             *mFrameBonesLastUpdated  = currentFrameNumber;
 
             return true;
@@ -1369,6 +1517,94 @@ namespace Ogre {
         return false;
     }
     //-----------------------------------------------------------------------
+    bool Entity::isAnimationLodUpdateDue(unsigned long frameNumber) const
+    {
+        return mAnimationLodIndex == 0 || mSharedSkeletonEntities ||
+               mFrameAnimationLodLastEvaluated == std::numeric_limits<unsigned long>::max() ||
+               frameNumber - mFrameAnimationLodLastEvaluated > mAnimationLodIndex;
+    }
+    //-----------------------------------------------------------------------
+    void Entity::storeAnimationLodPose(unsigned long frameNumber)
+    {
+        // Without a previous update to extrapolate from, the pose is held
+        bool restart = mFrameAnimationLodLastEvaluated == std::numeric_limits<unsigned long>::max() ||
+                       mAnimationLodMatrices.size() != size_t(mNumBoneMatrices) * 2;
+        mAnimationLodMatrices.resize(size_t(mNumBoneMatrices) * 2);
+        Affine3* prevMatrices = mAnimationLodMatrices.data();
+        Affine3* lastMatrices = prevMatrices + mNumBoneMatrices;
+        for (ushort i = 0; i < mNumBoneMatrices; ++i)
+        {
+            prevMatrices[i] = restart ? mBoneMatrices[i] : lastMatrices[i];
+            lastMatrices[i] = mBoneMatrices[i];
+        }
+
+        ushort numBones = mSkeletonInstance->getNumBones();
+        if (mChildObjectList.empty())
+        {
+            mAnimationLodPoses.clear();
+        }
+        else
+        {
+            bool restartPoses = restart || mAnimationLodPoses.size() != size_t(numBones) * 2;
+            mAnimationLodPoses.resize(size_t(numBones) * 2);
+            AnimationLodBonePose* prev = mAnimationLodPoses.data();
+            AnimationLodBonePose* last = prev + numBones;
+
+            for (ushort i = 0; i < numBones; ++i)
+            {
+                const Bone* bone = mSkeletonInstance->getBone(i);
+                AnimationLodBonePose pose = {bone->getPosition(), bone->getOrientation(), bone->getScale()};
+                prev[i] = restartPoses ? pose : last[i];
+                last[i] = pose;
+            }
+        }
+
+        mFrameAnimationLodPrevEvaluated = restart ? frameNumber : mFrameAnimationLodLastEvaluated;
+    }
+    //-----------------------------------------------------------------------
+    bool Entity::extrapolateAnimationLodPose(unsigned long frameNumber)
+    {
+        if (mAnimationLodMatrices.size() != size_t(mNumBoneMatrices) * 2 ||
+            mFrameAnimationLodLastEvaluated == mFrameAnimationLodPrevEvaluated)
+            return false; // nothing to extrapolate from, hold the last pose
+
+        // 1 is the last update, beyond that the motion between the last two updates continues
+        Real t = std::min(Real(frameNumber - mFrameAnimationLodPrevEvaluated) /
+                              (mFrameAnimationLodLastEvaluated - mFrameAnimationLodPrevEvaluated),
+                          Real(2));
+
+        ushort numBones = mSkeletonInstance->getNumBones();
+        if (!mChildObjectList.empty() && mAnimationLodPoses.size() == size_t(numBones) * 2)
+        {
+            // tag points need the bones themselves to follow
+            const AnimationLodBonePose* prev = mAnimationLodPoses.data();
+            const AnimationLodBonePose* last = prev + numBones;
+            for (ushort i = 0; i < numBones; ++i)
+            {
+                Bone* bone = mSkeletonInstance->getBone(i);
+                if (bone->isManuallyControlled())
+                    continue;
+                bone->setPosition(prev[i].position + (last[i].position - prev[i].position) * t);
+                bone->setOrientation(Quaternion::Slerp(t, prev[i].orientation, last[i].orientation, true));
+                bone->setScale(prev[i].scale + (last[i].scale - prev[i].scale) * t);
+            }
+            mSkeletonInstance->_getBoneMatrices(mBoneMatrices);
+            return true;
+        }
+
+        // Linear in the matrix elements, which is close enough for the small motion
+        // between two updates and leaves the skeleton untouched
+        const Affine3* prev = mAnimationLodMatrices.data();
+        const Affine3* last = prev + mNumBoneMatrices;
+        for (ushort i = 0; i < mNumBoneMatrices; ++i)
+        {
+            for (int r = 0; r < 3; ++r)
+                for (int c = 0; c < 4; ++c)
+                    mBoneMatrices[i][r][c] = prev[i][r][c] + (last[i][r][c] - prev[i][r][c]) * t;
+        }
+        return true;
+    }
+    //-----------------------------------------------------------------------
     void Entity::setDisplaySkeleton(bool display)
     {
         mDisplaySkeleton = display;
@@ -1416,6 +1652,21 @@ namespace Ogre {
         mMaxMaterialLodIndex = maxDetailIndex;
         mMinMaterialLodIndex = minDetailIndex;
     }
+    //-----------------------------------------------------------------------
+    void Entity::setAnimationLodLevels(const std::vector<Real>& lodValues, bool interpolate)
+    {
+        const LodStrategy* strategy = mMesh->getLodStrategy();
+        mAnimationLodValues.clear();
+        if (!lodValues.empty())
+        {
+            mAnimationLodValues.push_back(strategy->getBaseValue());
+            for (Real v : lodValues)
+                mAnimationLodValues.push_back(strategy->transformUserValue(v));
+        }
+        mAnimationLodInterpolation = interpolate;
+        mAnimationLodIndex = 0;
+        mFrameAnimationLodLastEvaluated = std::numeric_limits<unsigned long>::max();
+    }
 #endif
     //-----------------------------------------------------------------------
     void Entity::buildSubEntityList(MeshPtr& mesh, SubEntityList* sublist)
@@ -2210,6 +2461,8 @@ namespace Ogre {
         {
             OGRE_DELETE mSkeletonInstance;
             OGRE_FREE_SIMD(mBoneMatrices, MEMCATEGORY_ANIMATION);
+            mAnimationLodPoses.clear();
+            mAnimationLodMatrices.clear();
             OGRE_DELETE mAnimationState;
             // using OGRE_FREE since unsigned long is not a destructor
             OGRE_FREE(mFrameBonesLastUpdated, MEMCATEGORY_ANIMATION);
@@ -80,6 +80,9 @@ namespace {
         /// @copydoc Archive::isCaseSensitive
         bool isCaseSensitive(void) const;
 
+        /// @copydoc Archive::isThreadSafe
+        bool isThreadSafe() const { return true; }
+
         /// @copydoc Archive::load
         void load();
         /// @copydoc Archive::unload
@@ -339,7 +342,17 @@ namespace {
 
         if(!readOnly) mode |= std::ios::out;
 
-        return _openFileStream(concatenate_path(mName, filename), mode, filename);
+        String full_path = concatenate_path(mName, filename);
+
+        // Map large regular files, so they are loaded on demand and can be accessed in place
+        if(readOnly)
+        {
+            size_t minSize = MemoryMappedDataStream::getMinMappedSize();
+            if(auto stream = MemoryMappedDataStream::open(full_path, filename, minSize))
+                return stream;
+        }
+
+        return _openFileStream(full_path, mode, filename);
     }
     DataStreamPtr _openFileStream(const String& full_path, std::ios::openmode mode, const String& name)
     {
@@ -71,6 +71,12 @@ namespace Ogre
         String doGet(const void* target) const;
         void doSet(void* target, const String& val);
     };
+    class CmdInstancing : public ParamCommand
+    {
+    public:
+        String doGet(const void* target) const;
+        void doSet(void* target, const String& val);
+    };
     class CmdManualNamedConstsFile : public ParamCommand
     {
     public:
@@ -90,6 +96,7 @@ namespace Ogre
     static CmdMorph msMorphCmd;
     static CmdPose msPoseCmd;
     static CmdVTF msVTFCmd;
+    static CmdInstancing msInstancingCmd;
     static CmdManualNamedConstsFile msManNamedConstsFileCmd;
     static CmdAdjacency msAdjacencyCmd;
     }
@@ -98,7 +105,8 @@ namespace Ogre
     GpuProgram::GpuProgram(ResourceManager* creator, const String& name, ResourceHandle handle, const String& group,
                            bool isManual, ManualResourceLoader* loader)
         : Resource(creator, name, handle, group, isManual, loader), mType(GPT_VERTEX_PROGRAM), mLoadFromFile(true),
-          mSkeletalAnimation(false), mMorphAnimation(false), mVertexTextureFetch(false), mNeedsAdjacencyInfo(false),
+          mSkeletalAnimation(false), mMorphAnimation(false), mVertexTextureFetch(false), mInstancing(false),
+          mInstancingTexCoordIndex(-1), mNeedsAdjacencyInfo(false),
           mCompileError(false), mLoadedManualNamedConstants(false), mPoseAnimation(0)
     {
         createParameterMappingStructures();
@@ -410,6 +418,11 @@ namespace Ogre
             ParameterDef("uses_vertex_texture_fetch", 
                          "Whether this vertex program requires vertex texture fetch support.", PT_BOOL), 
             &msVTFCmd);
+        dict->addParameter(
+            ParameterDef("includes_instancing",
+                         "Whether this vertex program reads the world matrix per instance, "
+                         "optionally followed by the first texture coordinate it is read from", PT_STRING),
+            &msInstancingCmd);
         dict->addParameter(
             ParameterDef("manual_named_constants", 
                          "File containing named parameter mappings for low-level programs.", PT_BOOL), 
@@ -518,6 +531,24 @@ namespace Ogre
         t->setVertexTextureFetchRequired(StringConverter::parseBool(val));
     }
     //-----------------------------------------------------------------------
+    String CmdInstancing::doGet(const void* target) const
+    {
+        const GpuProgram* t = static_cast<const GpuProgram*>(target);
+        String ret = StringConverter::toString(t->isInstancingIncluded());
+        if (t->getInstancingTexCoordIndex() >= 0)
+            ret += " " + StringConverter::toString(t->getInstancingTexCoordIndex());
+        return ret;
+    }
+    void CmdInstancing::doSet(void* target, const String& val)
+    {
+        GpuProgram* t = static_cast<GpuProgram*>(target);
+        StringVector vecparams = StringUtil::split(val, " \t");
+        OgreAssert(vecparams.size() == 1 || vecparams.size() == 2,
+                   "includes_instancing expects <bool> [<texcoord index>]");
+        int texCoordIndex = vecparams.size() == 2 ? StringConverter::parseInt(vecparams[1], -1) : -1;
+        t->setInstancingIncluded(StringConverter::parseBool(vecparams[0]), texCoordIndex);
+    }
+    //-----------------------------------------------------------------------
     String CmdManualNamedConstsFile::doGet(const void* target) const
     {
         const GpuProgram* t = static_cast<const GpuProgram*>(target);
@@ -777,6 +777,7 @@ namespace Ogre
         , mTransposeMatrices(false)
         , mIgnoreMissingParams(false)
         , mActivePassIterationIndex(std::numeric_limits<size_t>::max())
+        , mAutoConstantPlanDirty(true)
     {
     }
     GpuProgramParameters::~GpuProgramParameters() {}
@@ -804,6 +805,7 @@ namespace Ogre
         mTransposeMatrices = oth.mTransposeMatrices;
         mIgnoreMissingParams  = oth.mIgnoreMissingParams;
         mActivePassIterationIndex = oth.mActivePassIterationIndex;
+        mAutoConstantPlanDirty = true;
 
         return *this;
     }
@@ -1464,6 +1466,7 @@ namespace Ogre
             mAutoConstants.push_back(AutoConstantEntry(acType, physicalIndex, extraInfo, variability, elementSize));
 
         mCombinedVariability |= variability;
+        mAutoConstantPlanDirty = true;
 
 
     }
@@ -1490,6 +1493,7 @@ namespace Ogre
             mAutoConstants.push_back(AutoConstantEntry(acType, physicalIndex, rData, variability, elementSize));
 
         mCombinedVariability |= variability;
+        mAutoConstantPlanDirty = true;
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::clearAutoConstant(size_t index)
@@ -1507,6 +1511,7 @@ namespace Ogre
                 if (i->physicalIndex == physicalIndex)
                 {
                     mAutoConstants.erase(i);
+                    mAutoConstantPlanDirty = true;
                     break;
                 }
             }
@@ -1528,6 +1533,7 @@ namespace Ogre
                     if (i->physicalIndex == def->physicalIndex)
                     {
                         mAutoConstants.erase(i);
+                        mAutoConstantPlanDirty = true;
                         break;
                     }
                 }
@@ -1539,6 +1545,7 @@ namespace Ogre
     {
         mAutoConstants.clear();
         mCombinedVariability = GPV_GLOBAL;
+        mAutoConstantPlanDirty = true;
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::setAutoConstantReal(size_t index, AutoConstantType acType, float rData)
@@ -1563,7 +1570,76 @@ namespace Ogre
         _setRawAutoConstantReal(indexUse->physicalIndex, acType, rData, indexUse->variability, sz);
     }
     //-----------------------------------------------------------------------------
+    template <typename T, const T& (AutoParamDataSource::*getter)() const>
+    static void copyAutoConstant(GpuProgramParameters& params, const GpuProgramParameters::AutoConstantEntry& entry,
+                                 const AutoParamDataSource* source)
+    {
+        params._writeRawConstant(entry.physicalIndex, (source->*getter)(), entry.elementCount);
+    }
+    /// the most frequently updated constants, which are cached by the AutoParamDataSource
+    static void (*getAutoConstantCopy(GpuProgramParameters::AutoConstantType type))(
+        GpuProgramParameters&, const GpuProgramParameters::AutoConstantEntry&, const AutoParamDataSource*)
+    {
+        typedef GpuProgramParameters GPP;
+        switch (type)
+        {
+        case GPP::ACT_WORLD_MATRIX:
+            return copyAutoConstant<Affine3, &AutoParamDataSource::getWorldMatrix>;
+        case GPP::ACT_INVERSE_WORLD_MATRIX:
+            return copyAutoConstant<Affine3, &AutoParamDataSource::getInverseWorldMatrix>;
+        case GPP::ACT_INVERSE_TRANSPOSE_WORLD_MATRIX:
+            return copyAutoConstant<Matrix4, &AutoParamDataSource::getInverseTransposeWorldMatrix>;
+        case GPP::ACT_WORLDVIEW_MATRIX:
+            return copyAutoConstant<Affine3, &AutoParamDataSource::getWorldViewMatrix>;
+        case GPP::ACT_INVERSE_WORLDVIEW_MATRIX:
+            return copyAutoConstant<Affine3, &AutoParamDataSource::getInverseWorldViewMatrix>;
+        case GPP::ACT_INVERSE_TRANSPOSE_WORLDVIEW_MATRIX:
+            return copyAutoConstant<Matrix4, &AutoParamDataSource::getInverseTransposeWorldViewMatrix>;
+        case GPP::ACT_WORLDVIEWPROJ_MATRIX:
+            return copyAutoConstant<Matrix4, &AutoParamDataSource::getWorldViewProjMatrix>;
+        case GPP::ACT_VIEW_MATRIX:
+            return copyAutoConstant<Affine3, &AutoParamDataSource::getViewMatrix>;
+        case GPP::ACT_PROJECTION_MATRIX:
+            return copyAutoConstant<Matrix4, &AutoParamDataSource::getProjectionMatrix>;
+        case GPP::ACT_VIEWPROJ_MATRIX:
+            return copyAutoConstant<Matrix4, &AutoParamDataSource::getViewProjectionMatrix>;
+        case GPP::ACT_CAMERA_POSITION:
+            return copyAutoConstant<Vector4, &AutoParamDataSource::getCameraPosition>;
+        case GPP::ACT_CAMERA_POSITION_OBJECT_SPACE:
+            return copyAutoConstant<Vector4, &AutoParamDataSource::getCameraPositionObjectSpace>;
+        default:
+            return NULL;
+        }
+    }
+    //-----------------------------------------------------------------------------
+    void GpuProgramParameters::buildAutoConstantPlan()
+    {
+        mAutoConstantPlan.clear();
+        mAutoConstantGroups.clear();
+        for (uint32 i = 0; i < mAutoConstants.size(); ++i)
+        {
+            AutoConstantOp op = {i, getAutoConstantCopy(mAutoConstants[i].paramType)};
+            mAutoConstantPlan.push_back(op);
+        }
 
+        std::stable_sort(mAutoConstantPlan.begin(), mAutoConstantPlan.end(),
+                         [this](const AutoConstantOp& a, const AutoConstantOp& b) {
+                             return mAutoConstants[a.entry].variability < mAutoConstants[b.entry].variability;
+                         });
+
+        for (uint32 i = 0; i < mAutoConstantPlan.size(); ++i)
+        {
+            uint16 variability = mAutoConstants[mAutoConstantPlan[i].entry].variability;
+            if (mAutoConstantGroups.empty() || mAutoConstantGroups.back().variability != variability)
+            {
+                AutoConstantGroup group = {variability, i, i};
+                mAutoConstantGroups.push_back(group);
+            }
+            mAutoConstantGroups.back().end = i + 1;
+        }
+
+        mAutoConstantPlanDirty = false;
+    }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::_updateAutoParams(const AutoParamDataSource* source, uint16 mask)
     {
@@ -1585,12 +1661,24 @@ namespace Ogre
 
         mActivePassIterationIndex = std::numeric_limits<size_t>::max();
 
-        // Autoconstant index is not a physical index
-        for (AutoConstantList::const_iterator i = mAutoConstants.begin(); i != mAutoConstants.end(); ++i)
+        if (mAutoConstantPlanDirty)
+            buildAutoConstantPlan();
+
+        for (const AutoConstantGroup& group : mAutoConstantGroups)
         {
             // Only update needed slots
-            if (i->variability & mask)
+            if (!(group.variability & mask))
+                continue;
+
+            for (uint32 op = group.begin; op < group.end; ++op)
             {
+                // Autoconstant index is not a physical index
+                const AutoConstantEntry* i = &mAutoConstants[mAutoConstantPlan[op].entry];
+                if (mAutoConstantPlan[op].copy)
+                {
+                    mAutoConstantPlan[op].copy(*this, *i, source);
+                    continue;
+                }
 
                 switch(i->paramType)
                 {
@@ -2412,6 +2500,8 @@ namespace Ogre
     {
         if (index < mAutoConstants.size())
         {
+            // the entry might be modified
+            mAutoConstantPlanDirty = true;
             return &(mAutoConstants[index]);
         }
         else
@@ -2472,6 +2562,7 @@ namespace Ogre
         mRegisters = source.mRegisters;
         mAutoConstants = source.getAutoConstantList();
         mCombinedVariability = source.mCombinedVariability;
+        mAutoConstantPlanDirty = true;
         copySharedParamSetUsage(source.mSharedParamSets);
     }
     //---------------------------------------------------------------------
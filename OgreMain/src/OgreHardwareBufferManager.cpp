@@ -55,7 +55,8 @@ namespace Ogre {
     const size_t HardwareBufferManagerBase::EXPIRED_DELAY_FRAME_THRESHOLD = 5;
     //-----------------------------------------------------------------------
     HardwareBufferManagerBase::HardwareBufferManagerBase()
-        : mUnderUsedFrameCount(0)
+        : mUnderUsedFrameCount(0), mDynamicVertexRingSize(0),
+          mDynamicVertexRingFramesInFlight(3)
     {
     }
     //-----------------------------------------------------------------------
@@ -519,6 +520,109 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------------
+    HardwareBufferRing::HardwareBufferRing(const HardwareBufferPtr& buffer, uint32 framesInFlight)
+        : mBuffer(buffer), mHead(0), mFramesInFlight(framesInFlight)
+    {
+    }
+    //-----------------------------------------------------------------------------
+    size_t HardwareBufferRing::allocate(size_t size, size_t alignment, uint32 frame)
+    {
+        // retire the frames the GPU is done with
+        while (!mFences.empty() && frame - mFences.front().first >= mFramesInFlight)
+            mFences.pop_front();
+
+        size_t capacity = mBuffer->getSizeInBytes();
+        if (size > capacity)
+            return -1;
+
+        size_t start = (mHead + alignment - 1) / alignment * alignment;
+        if (mFences.empty())
+        {
+            // nothing in flight
+            if (start + size > capacity)
+                start = 0;
+        }
+        else
+        {
+            // the oldest byte still in flight. The free space stops right before it, so
+            // that a full ring can be told apart from an empty one
+            size_t tail = mFences.front().second;
+            if (mHead >= tail)
+            {
+                // free up to the end, then from the front
+                if (start + size > capacity)
+                {
+                    if (size >= tail)
+                        return -1;
+                    start = 0;
+                }
+            }
+            else if (start + size >= tail)
+            {
+                return -1;
+            }
+        }
+
+        if (mFences.empty() || mFences.back().first != frame)
+            mFences.push_back(std::make_pair(frame, start));
+
+        mHead = start + size;
+        return start;
+    }
+    //-----------------------------------------------------------------------------
+    static HardwareBufferManagerBase* getManager(HardwareBufferManagerBase* mgr)
+    {
+        return mgr ? mgr : HardwareBufferManager::getSingletonPtr();
+    }
+    //-----------------------------------------------------------------------------
+    UniformBufferRing::UniformBufferRing(size_t sizeBytes, size_t alignment, uint32 framesInFlight,
+                                         HardwareBufferManagerBase* mgr)
+        : HardwareBufferRing(getManager(mgr)->createUniformBuffer(sizeBytes, HBU_CPU_TO_GPU, false),
+                             framesInFlight),
+          mAlignment(std::max<size_t>(alignment, 1))
+    {
+    }
+    //-----------------------------------------------------------------------------
+    size_t UniformBufferRing::write(const void* data, size_t size, uint32 frame)
+    {
+        size_t offset = allocate(size, mAlignment, frame);
+        if (offset != size_t(-1))
+            getBuffer()->writeData(offset, size, data);
+        return offset;
+    }
+    //-----------------------------------------------------------------------------
+    VertexBufferRing::VertexBufferRing(size_t vertexSize, size_t numVertices, uint32 framesInFlight,
+                                       HardwareBufferManagerBase* mgr)
+        : HardwareBufferRing(getManager(mgr)->createVertexBuffer(vertexSize, numVertices, HBU_CPU_TO_GPU, false),
+                             framesInFlight)
+    {
+        mBuffer = static_pointer_cast<HardwareVertexBuffer>(HardwareBufferRing::getBuffer());
+    }
+    //-----------------------------------------------------------------------------
+    void* VertexBufferRing::lock(size_t numVertices, uint32 frame, size_t& vertexStart)
+    {
+        size_t vertexSize = mBuffer->getVertexSize();
+        size_t offset = allocate(numVertices * vertexSize, vertexSize, frame);
+        if (offset == size_t(-1))
+            return NULL;
+
+        vertexStart = offset / vertexSize;
+        return mBuffer->lock(offset, numVertices * vertexSize, HardwareBuffer::HBL_NO_OVERWRITE);
+    }
+    //-----------------------------------------------------------------------------
+    VertexBufferRing* HardwareBufferManagerBase::getDynamicVertexRing(size_t vertexSize)
+    {
+        if (!mDynamicVertexRingSize)
+            return NULL;
+
+        OGRE_LOCK_MUTEX(mTempBuffersMutex);
+        std::unique_ptr<VertexBufferRing>& ring = mDynamicVertexRings[vertexSize];
+        if (!ring)
+            ring.reset(new VertexBufferRing(vertexSize, std::max<size_t>(mDynamicVertexRingSize / vertexSize, 1),
+                                            mDynamicVertexRingFramesInFlight, this));
+        return ring.get();
+    }
+    //-----------------------------------------------------------------------------
     void TempBlendedBufferInfo::licenseExpired(HardwareBuffer* buffer)
     {
         assert(buffer == destPositionBuffer.get()
@@ -31,6 +31,29 @@ THE SOFTWARE.
 #include "OgreImageResampler.h"
 
 namespace Ogre {
+    namespace
+    {
+        /// Resample in bands of rows spread over the WorkQueue threads
+        template <class Resampler> void scaleRows(const PixelBox& src, const PixelBox& dst)
+        {
+            const uint32 bandRows = 16;
+            uint32 rows = dst.getHeight();
+            WorkQueue* wq = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL;
+
+            // small images are not worth the overhead
+            if (!wq || size_t(dst.getWidth()) * dst.getHeight() * dst.getDepth() < 256 * 256)
+            {
+                Resampler::scale(src, dst, 0, rows);
+                return;
+            }
+
+            wq->parallelFor((rows + bandRows - 1) / bandRows, [&](size_t i) {
+                uint32 rowBegin = uint32(i) * bandRows;
+                Resampler::scale(src, dst, rowBegin, std::min(rowBegin + bandRows, rows));
+            });
+        }
+    }
+
     ImageCodec::~ImageCodec() {
     }
 
@@ -515,14 +538,14 @@ namespace Ogre {
             // super-optimized: no conversion
             switch (PixelUtil::getNumElemBytes(src.format)) 
             {
-            case 1: NearestResampler<1>::scale(src, temp); break;
-            case 2: NearestResampler<2>::scale(src, temp); break;
-            case 3: NearestResampler<3>::scale(src, temp); break;
-            case 4: NearestResampler<4>::scale(src, temp); break;
-            case 6: NearestResampler<6>::scale(src, temp); break;
-            case 8: NearestResampler<8>::scale(src, temp); break;
-            case 12: NearestResampler<12>::scale(src, temp); break;
-            case 16: NearestResampler<16>::scale(src, temp); break;
+            case 1: scaleRows<NearestResampler<1>>(src, temp); break;
+            case 2: scaleRows<NearestResampler<2>>(src, temp); break;
+            case 3: scaleRows<NearestResampler<3>>(src, temp); break;
+            case 4: scaleRows<NearestResampler<4>>(src, temp); break;
+            case 6: scaleRows<NearestResampler<6>>(src, temp); break;
+            case 8: scaleRows<NearestResampler<8>>(src, temp); break;
+            case 12: scaleRows<NearestResampler<12>>(src, temp); break;
+            case 16: scaleRows<NearestResampler<16>>(src, temp); break;
             default:
                 // never reached
                 assert(false);
@@ -551,10 +574,10 @@ namespace Ogre {
                 // super-optimized: byte-oriented math, no conversion
                 switch (PixelUtil::getNumElemBytes(src.format)) 
                 {
-                case 1: LinearResampler_Byte<1>::scale(src, temp); break;
-                case 2: LinearResampler_Byte<2>::scale(src, temp); break;
-                case 3: LinearResampler_Byte<3>::scale(src, temp); break;
-                case 4: LinearResampler_Byte<4>::scale(src, temp); break;
+                case 1: scaleRows<LinearResampler_Byte<1>>(src, temp); break;
+                case 2: scaleRows<LinearResampler_Byte<2>>(src, temp); break;
+                case 3: scaleRows<LinearResampler_Byte<3>>(src, temp); break;
+                case 4: scaleRows<LinearResampler_Byte<4>>(src, temp); break;
                 default:
                     // never reached
                     assert(false);
@@ -570,13 +593,13 @@ namespace Ogre {
                 if (scaled.format == PF_FLOAT32_RGB || scaled.format == PF_FLOAT32_RGBA)
                 {
                     // float32 to float32, avoid unpack/repack overhead
-                    LinearResampler_Float32::scale(src, scaled);
+                    scaleRows<LinearResampler_Float32>(src, scaled);
                     break;
                 }
                 // else, fall through
             default:
                 // non-optimized: floating-point math, performs conversion but always works
-                LinearResampler::scale(src, scaled);
+                scaleRows<LinearResampler>(src, scaled);
             }
             break;
         }
@@ -47,17 +47,19 @@ namespace Ogre {
 // sx2 = upper-bound integer x-position in source
 // sxf = fractional weight between sx1 and sx2
 // x,y,z = location of output pixel in destination
+// rowBegin, rowEnd = range of destination rows to compute in each slice,
+//                    so that bands of rows can be resampled in parallel
 
 // nearest-neighbor resampler, does not convert formats.
 // templated on bytes-per-pixel to allow compiler optimizations, such
 // as simplifying memcpy() and replacing multiplies with bitshifts
 template<unsigned int elemsize> struct NearestResampler {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, uint32 rowBegin, uint32 rowEnd) {
         // assert(src.format == dst.format);
 
         // srcdata stays at beginning, pdst is a moving pointer
         uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
-        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+        uchar* dstdata = (uchar*)dst.getTopLeftFrontPixelPtr();
 
         // sx_48,sy_48,sz_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
@@ -70,9 +72,10 @@ template<unsigned int elemsize> struct NearestResampler {
         uint64 sz_48 = (stepz >> 1) - 1;
         for (size_t z = dst.front; z < dst.back; z++, sz_48 += stepz) {
             size_t srczoff = (size_t)(sz_48 >> 48) * src.slicePitch;
-            
-            uint64 sy_48 = (stepy >> 1) - 1;
-            for (size_t y = dst.top; y < dst.bottom; y++, sy_48 += stepy) {
+            uchar* pdst = dstdata + elemsize*((z - dst.front)*dst.slicePitch + rowBegin*dst.rowPitch);
+
+            uint64 sy_48 = (stepy >> 1) - 1 + rowBegin*stepy;
+            for (size_t y = dst.top + rowBegin; y < dst.top + rowEnd; y++, sy_48 += stepy) {
                 size_t srcyoff = (size_t)(sy_48 >> 48) * src.rowPitch;
             
                 uint64 sx_48 = (stepx >> 1) - 1;
@@ -84,7 +87,6 @@ template<unsigned int elemsize> struct NearestResampler {
                 }
                 pdst += elemsize*dst.getRowSkip();
             }
-            pdst += elemsize*dst.getSliceSkip();
         }
     }
 };
@@ -92,13 +94,13 @@ template<unsigned int elemsize> struct NearestResampler {
 
 // default floating-point linear resampler, does format conversion
 struct LinearResampler {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, uint32 rowBegin, uint32 rowEnd) {
         size_t srcelemsize = PixelUtil::getNumElemBytes(src.format);
         size_t dstelemsize = PixelUtil::getNumElemBytes(dst.format);
 
         // srcdata stays at beginning, pdst is a moving pointer
         uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
-        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+        uchar* dstdata = (uchar*)dst.getTopLeftFrontPixelPtr();
         
         // sx_48,sy_48,sz_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
@@ -121,8 +123,9 @@ struct LinearResampler {
             uint32 sz2 = std::min(sz1+1,src.getDepth()-1);// src z, sample #2
             float szf = (temp & 0xFFFF) / 65536.f; // weight of sample #2
 
-            uint64 sy_48 = (stepy >> 1) - 1;
-            for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+            uchar* pdst = dstdata + dstelemsize*((z - dst.front)*dst.slicePitch + rowBegin*dst.rowPitch);
+            uint64 sy_48 = (stepy >> 1) - 1 + rowBegin*stepy;
+            for (size_t y = dst.top + rowBegin; y < dst.top + rowEnd; y++, sy_48+=stepy) {
                 temp = static_cast<unsigned int>(sy_48 >> 32);
                 temp = (temp > 0x8000)? temp - 0x8000 : 0;
                 uint32 sy1 = temp >> 16;                    // src y #1
@@ -165,7 +168,6 @@ struct LinearResampler {
                 }
                 pdst += dstelemsize*dst.getRowSkip();
             }
-            pdst += dstelemsize*dst.getSliceSkip();
         }
     }
 };
@@ -174,7 +176,7 @@ struct LinearResampler {
 // float32 linear resampler, converts FLOAT32_RGB/FLOAT32_RGBA only.
 // avoids overhead of pixel unpack/repack function calls
 struct LinearResampler_Float32 {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, uint32 rowBegin, uint32 rowEnd) {
         size_t srcchannels = PixelUtil::getNumElemBytes(src.format) / sizeof(float);
         size_t dstchannels = PixelUtil::getNumElemBytes(dst.format) / sizeof(float);
         // assert(srcchannels == 3 || srcchannels == 4);
@@ -182,7 +184,7 @@ struct LinearResampler_Float32 {
 
         // srcdata stays at beginning, pdst is a moving pointer
         float* srcdata = (float*)src.getTopLeftFrontPixelPtr();
-        float* pdst = (float*)dst.getTopLeftFrontPixelPtr();
+        float* dstdata = (float*)dst.getTopLeftFrontPixelPtr();
         
         // sx_48,sy_48,sz_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
@@ -205,8 +207,9 @@ struct LinearResampler_Float32 {
             uint32 sz2 = std::min(sz1+1,src.getDepth()-1);// src z, sample #2
             float szf = (temp & 0xFFFF) / 65536.f; // weight of sample #2
 
-            uint64 sy_48 = (stepy >> 1) - 1;
-            for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+            float* pdst = dstdata + dstchannels*((z - dst.front)*dst.slicePitch + rowBegin*dst.rowPitch);
+            uint64 sy_48 = (stepy >> 1) - 1 + rowBegin*stepy;
+            for (size_t y = dst.top + rowBegin; y < dst.top + rowEnd; y++, sy_48+=stepy) {
                 temp = static_cast<unsigned int>(sy_48 >> 32);
                 temp = (temp > 0x8000)? temp - 0x8000 : 0;
                 uint32 sy1 = temp >> 16;                    // src y #1
@@ -268,7 +271,6 @@ struct LinearResampler_Float32 {
                 }
                 pdst += dstchannels*dst.getRowSkip();
             }
-            pdst += dstchannels*dst.getSliceSkip();
         }
     }
 };
@@ -281,26 +283,26 @@ struct LinearResampler_Float32 {
 // templated on bytes-per-pixel to allow compiler optimizations, such
 // as unrolling loops and replacing multiplies with bitshifts
 template<unsigned int channels> struct LinearResampler_Byte {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, uint32 rowBegin, uint32 rowEnd) {
         // assert(src.format == dst.format);
 
         // only optimized for 2D
         if (src.getDepth() > 1 || dst.getDepth() > 1) {
-            LinearResampler::scale(src, dst);
+            LinearResampler::scale(src, dst, rowBegin, rowEnd);
             return;
         }
 
         // srcdata stays at beginning of slice, pdst is a moving pointer
         uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
-        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr() + channels*rowBegin*dst.rowPitch;
 
         // sx_48,sy_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
         uint64 stepx = ((uint64)src.getWidth() << 48) / dst.getWidth();
         uint64 stepy = ((uint64)src.getHeight() << 48) / dst.getHeight();
         
-        uint64 sy_48 = (stepy >> 1) - 1;
-        for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+        uint64 sy_48 = (stepy >> 1) - 1 + rowBegin*stepy;
+        for (size_t y = dst.top + rowBegin; y < dst.top + rowEnd; y++, sy_48+=stepy) {
             // bottom 28 bits of temp are 16/12 bit fixed precision, used to
             // adjust a source coordinate backwards by half a pixel so that the
             // integer bits represent the first sample (eg, sx1) and the
@@ -124,6 +124,27 @@ namespace Ogre
     }
     //-----------------------------------------------------------------------
     void InstanceBatch::_updateBounds(void)
+    {
+        _calculateBounds();
+        if (mParentNode) {
+            mParentNode->needUpdate();
+        }
+    }
+    //-----------------------------------------------------------------------
+    void InstanceBatch::_updateInstanceNodes(void)
+    {
+        InstancedEntityVec::const_iterator itor = mInstancedEntities.begin();
+        InstancedEntityVec::const_iterator end  = mInstancedEntities.end();
+
+        while( itor != end )
+        {
+            if( (*itor)->isInScene() && (*itor)->getParentNode() )
+                (*itor)->getParentNode()->_getDerivedPosition();
+            ++itor;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void InstanceBatch::_calculateBounds(void)
     {
         mFullBoundingBox.setNull();
 
@@ -150,10 +171,7 @@ namespace Ogre
 
 
         mBoundingRadius = Math::boundingRadiusFromAABBCentered( mFullBoundingBox );
-        if (mParentNode) {
-            mParentNode->needUpdate();
-        }
-	mBoundsUpdated  = true;
+        mBoundsUpdated  = true;
         mBoundsDirty    = false;
     }
 
@@ -29,9 +29,13 @@ THE SOFTWARE.
 #include "OgreInstanceBatchHW.h"
 #include "OgreRenderOperation.h"
 #include "OgreInstancedEntity.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre
 {
+    /// Instances culled and written by one call of the parallel vertex buffer update
+    static const size_t PARALLEL_CHUNK_SIZE = 1024;
+
     InstanceBatchHW::InstanceBatchHW( InstanceManager *creator, MeshPtr &meshReference,
                                         const MaterialPtr &material, size_t instancesPerBatch,
                                         const Mesh::IndexMap *indexToBoneMap, const String &batchName ) :
@@ -186,6 +190,13 @@ namespace Ogre
         HardwareBufferLockGuard vertexLock(binding->getBuffer(bufferIdx), HardwareBuffer::HBL_DISCARD);
         float *pDest = static_cast<float*>(vertexLock.pData);
 
+        //Custom culling frusta are user code that may not be safe to call concurrently
+        if( mInstancedEntities.size() > PARALLEL_CHUNK_SIZE &&
+            !(currentCamera && currentCamera->getCullingFrustum()) )
+        {
+            return updateVertexBufferParallel( currentCamera, pDest );
+        }
+
         InstancedEntityVec::const_iterator itor = mInstancedEntities.begin();
         InstancedEntityVec::const_iterator end  = mInstancedEntities.end();
 
@@ -224,6 +235,69 @@ namespace Ogre
         return retVal;
     }
     //-----------------------------------------------------------------------
+    size_t InstanceBatchHW::updateVertexBufferParallel( Camera *currentCamera, float *pDest )
+    {
+        //Without skeletal animation, every visible instance takes the same space
+        const unsigned char numCustomParams = mCreator->getNumCustomParams();
+        const size_t floatsPerInstance      = 12 + numCustomParams * 4;
+        const size_t numChunks = (mInstancedEntities.size() + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+        mInstanceVisible.resize( mInstancedEntities.size() );
+        mChunkVisibleCounts.assign( numChunks, 0 );
+
+        //Make the lazy frustum plane update here, so the workers only read them
+        if( currentCamera )
+            currentCamera->getFrustumPlanes();
+
+        WorkQueue *workQueue = Root::getSingleton().getWorkQueue();
+
+        //First count the visible instances of each chunk, to know where each chunk writes to
+        workQueue->parallelFor( numChunks, [this, currentCamera]( size_t chunk )
+        {
+            size_t end = std::min( (chunk + 1) * PARALLEL_CHUNK_SIZE, mInstancedEntities.size() );
+            for( size_t i=chunk * PARALLEL_CHUNK_SIZE; i<end; ++i )
+            {
+                mInstanceVisible[i] = mInstancedEntities[i]->findVisible( currentCamera );
+                mChunkVisibleCounts[chunk] += mInstanceVisible[i];
+            }
+        } );
+
+        size_t retVal = 0;
+        for( size_t &count : mChunkVisibleCounts )
+        {
+            size_t first = retVal;
+            retVal += count;
+            count = first;
+        }
+
+        //Then write each chunk into its own region of the buffer
+        workQueue->parallelFor( numChunks, [this, pDest, numCustomParams, floatsPerInstance]( size_t chunk )
+        {
+            float *pChunkDest = pDest + mChunkVisibleCounts[chunk] * floatsPerInstance;
+            size_t end = std::min( (chunk + 1) * PARALLEL_CHUNK_SIZE, mInstancedEntities.size() );
+            for( size_t i=chunk * PARALLEL_CHUNK_SIZE; i<end; ++i )
+            {
+                if( !mInstanceVisible[i] )
+                    continue;
+
+                mInstancedEntities[i]->getTransforms3x4( (Matrix3x4f*)pChunkDest );
+                if( mManager->getCameraRelativeRendering() )
+                    makeMatrixCameraRelative3x4( (Matrix3x4f*)pChunkDest, 1 );
+                pChunkDest += 12;
+
+                const Vector4 *customParams = mCustomParams.data() + i * numCustomParams;
+                for( unsigned char j=0; j<numCustomParams; ++j )
+                {
+                    *pChunkDest++ = customParams[j].x;
+                    *pChunkDest++ = customParams[j].y;
+                    *pChunkDest++ = customParams[j].z;
+                    *pChunkDest++ = customParams[j].w;
+                }
+            }
+        } );
+
+        return retVal;
+    }
+    //-----------------------------------------------------------------------
     void InstanceBatchHW::_boundsDirty(void)
     {
         //Don't update if we're static, but still mark we're dirty
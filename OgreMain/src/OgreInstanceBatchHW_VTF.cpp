@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include "OgreInstanceBatchHW_VTF.h"
 #include "OgreHardwarePixelBuffer.h"
 #include "OgreInstancedEntity.h"
+#include "OgreSkeletonInstance.h"
+#include "OgreAnimation.h"
 
 namespace Ogre
 {
@@ -41,14 +43,207 @@ namespace Ogre
         const Mesh::IndexMap *indexToBoneMap, const String &batchName )
             : BaseInstanceBatchVTF( creator, meshReference, material, 
                                     instancesPerBatch, indexToBoneMap, batchName),
-              mKeepStatic( false )
+              mKeepStatic( false ),
+              mUseBakedAnimation( false ),
+              mBakedAnimationFrameRate( 30 )
     {
     }
     //-----------------------------------------------------------------------
     InstanceBatchHW_VTF::~InstanceBatchHW_VTF()
     {
+        //The baked vertex texture is shared by all batches, the InstanceManager removes it
+        if( mUseBakedAnimation )
+            mMatrixTexture.reset();
     }   
     //-----------------------------------------------------------------------
+    void InstanceBatchHW_VTF::setBakedAnimation( bool enable, Real framesPerSecond )
+    {
+        OgreAssert( mInstancedEntities.empty(), "can only be changed before building the batch" );
+        OgreAssert( framesPerSecond > 0, "frame rate must be positive" );
+        mUseBakedAnimation       = enable;
+        mBakedAnimationFrameRate = framesPerSecond;
+
+        //Instances use the same per instance data as with bone matrix lookup
+        if( enable )
+            mUseBoneMatrixLookup = true;
+    }
+    //-----------------------------------------------------------------------
+    void InstanceBatchHW_VTF::createVertexTexture( const SubMesh* baseSubMesh )
+    {
+        if( !mUseBakedAnimation )
+        {
+            BaseInstanceBatchVTF::createVertexTexture( baseSubMesh );
+            return;
+        }
+
+        mMatricesPerInstance = std::max<size_t>( 1, baseSubMesh->blendIndexToBoneIndexMap.size() );
+
+        //The layout only depends on the skeleton, so every batch can compute it on its own
+        const size_t numPalettes = calculateBakedClips( mBakedClips );
+        mNumWorldMatrices = numPalettes * mMatricesPerInstance;
+
+        size_t texWidth, texHeight;
+        calculateVertexTextureSize( mNumWorldMatrices, texWidth, texHeight );
+        if( texHeight > c_maxTexHeightHW )
+        {
+            OGRE_EXCEPT( Exception::ERR_INVALIDPARAMS,
+                         "Baked animations of '" + mMeshReference->getName() + "' don't fit in the "
+                         "vertex texture. Reduce the baked animation frame rate",
+                         "InstanceBatchHW_VTF::createVertexTexture" );
+        }
+
+        TextureManager &textureManager = TextureManager::getSingleton();
+        const String textureName = mCreator->getName() + "/BakedVTF";
+
+        mMatrixTexture = textureManager.getByName( textureName, mMeshReference->getGroup() );
+        if( !mMatrixTexture )
+        {
+            mMatrixTexture = textureManager.createManual( textureName, mMeshReference->getGroup(),
+                                                          TEX_TYPE_2D, (uint)texWidth, (uint)texHeight,
+                                                          0, PF_FLOAT32_RGBA, TU_STATIC_WRITE_ONLY );
+            OgreAssert(mMatrixTexture->getFormat() == PF_FLOAT32_RGBA, "float texture support required");
+            bakeAnimations( numPalettes );
+        }
+
+        setupMaterialToUseVTF( TEX_TYPE_2D, mMaterial );
+    }
+    //-----------------------------------------------------------------------
+    size_t InstanceBatchHW_VTF::calculateBakedClips( BakedClipMap &outClips ) const
+    {
+        outClips.clear();
+        size_t numPalettes = 1; //Binding pose
+        const SkeletonPtr &skeleton = mMeshReference->getSkeleton();
+        if( mMeshReference->hasSkeleton() && skeleton )
+        {
+            for( unsigned short i = 0; i < skeleton->getNumAnimations(); ++i )
+            {
+                const Animation *animation = skeleton->getAnimation( i );
+
+                BakedClip clip;
+                clip.firstRow  = numPalettes;
+                clip.numFrames = std::max<size_t>( 1, static_cast<size_t>(
+                                        Math::Ceil( animation->getLength() * mBakedAnimationFrameRate ) ) );
+                outClips[animation->getName()] = clip;
+                numPalettes += clip.numFrames;
+            }
+        }
+
+        return numPalettes;
+    }
+    //-----------------------------------------------------------------------
+    void InstanceBatchHW_VTF::bakeAnimations( size_t numPalettes )
+    {
+        //Which animation and time position each palette row holds
+        typedef std::pair<Animation*, Real> PaletteSource;
+        std::vector<PaletteSource> rows( numPalettes, PaletteSource( (Animation*)0, Real(0) ) );
+
+        SkeletonInstance *skeleton = 0;
+        std::vector<Affine3> boneMatrices;
+        if( !mBakedClips.empty() )
+        {
+            skeleton = OGRE_NEW SkeletonInstance( mMeshReference->getSkeleton() );
+            skeleton->load();
+            boneMatrices.resize( skeleton->getNumBones() );
+
+            BakedClipMap::const_iterator itor = mBakedClips.begin();
+            BakedClipMap::const_iterator end  = mBakedClips.end();
+            while( itor != end )
+            {
+                Animation *animation = skeleton->getAnimation( itor->first );
+                for( size_t i = 0; i < itor->second.numFrames; ++i )
+                {
+                    rows[itor->second.firstRow + i] = PaletteSource( animation,
+                                    std::min( i / mBakedAnimationFrameRate, animation->getLength() ) );
+                }
+                ++itor;
+            }
+        }
+
+        HardwareBufferLockGuard matTexLock(mMatrixTexture->getBuffer(), HardwareBuffer::HBL_DISCARD);
+        const PixelBox &pixelBox = mMatrixTexture->getBuffer()->getCurrentLock();
+        float *pSource = reinterpret_cast<float*>(pixelBox.data);
+
+        const size_t floatPerPalette    = mMatricesPerInstance * mRowLength * 4;
+        const size_t palettesPerPadding = (size_t)(mMaxFloatsPerLine / floatPerPalette);
+
+        std::vector<Matrix3x4f> palette( mMatricesPerInstance, Matrix3x4f( Affine3::IDENTITY[0] ) );
+
+        for( size_t row = 0; row < numPalettes; ++row )
+        {
+            if( rows[row].first )
+            {
+                skeleton->reset();
+                rows[row].first->apply( skeleton, rows[row].second );
+                skeleton->_getBoneMatrices( boneMatrices.data() );
+
+                //Same order InstancedEntity::getTransforms3x4 writes them
+                size_t i = 0;
+                Mesh::IndexMap::const_iterator itor = mIndexToBoneMap->begin();
+                Mesh::IndexMap::const_iterator end  = mIndexToBoneMap->end();
+                while( itor != end && i < mMatricesPerInstance )
+                    palette[i++] = Matrix3x4f( boneMatrices[*itor++][0] );
+            }
+
+            float* pDest = pSource + floatPerPalette * row + (row / palettesPerPadding) * mWidthFloatsPadding;
+            if( mUseBoneDualQuaternions )
+                convert3x4MatricesToDualQuaternions( palette.data(), mMatricesPerInstance, pDest );
+            else
+                memcpy( pDest, palette.data(), mMatricesPerInstance * sizeof(Matrix3x4f) );
+        }
+
+        OGRE_DELETE skeleton;
+    }
+    //-----------------------------------------------------------------------
+    size_t InstanceBatchHW_VTF::getBakedAnimationRow( const InstancedEntity *entity ) const
+    {
+        const AnimationStateSet *animations = entity->getAllAnimationStates();
+        if( !animations )
+            return 0;
+
+        //Baked palettes can't be blended, pick the most relevant animation
+        const AnimationState *state = 0;
+        for( const AnimationState *enabled : animations->getEnabledAnimationStates() )
+        {
+            if( !state || enabled->getWeight() > state->getWeight() )
+                state = enabled;
+        }
+
+        if( !state )
+            return 0;
+
+        BakedClipMap::const_iterator itor = mBakedClips.find( state->getAnimationName() );
+        if( itor == mBakedClips.end() )
+            return 0;
+
+        size_t frame = static_cast<size_t>( state->getTimePosition() * mBakedAnimationFrameRate );
+        if( state->getLoop() )
+            frame %= itor->second.numFrames;
+        else
+            frame = std::min( frame, itor->second.numFrames - 1 );
+
+        return itor->second.firstRow + frame;
+    }
+    //-----------------------------------------------------------------------
+    void InstanceBatchHW_VTF::updateSharedLookupIndexes()
+    {
+        if( mUseBakedAnimation )
+        {
+            //Every instance looks up its own frame, nothing is shared
+            mTransformSharingDirty = false;
+            return;
+        }
+
+        BaseInstanceBatchVTF::updateSharedLookupIndexes();
+    }
+    //-----------------------------------------------------------------------
+    InstancedEntity* InstanceBatchHW_VTF::generateInstancedEntity( size_t num )
+    {
+        if( mUseBakedAnimation )
+            return InstanceBatch::generateInstancedEntity( num );
+
+        return BaseInstanceBatchVTF::generateInstancedEntity( num );
+    }
+    //-----------------------------------------------------------------------
     void InstanceBatchHW_VTF::setupVertices( const SubMesh* baseSubMesh )
     {
         mRenderOperation.vertexData = OGRE_NEW VertexData();
@@ -293,7 +488,8 @@ namespace Ogre
                     //and static mode).
                     (entity->findVisible(currentCamera)))
                 {
-                    size_t matrixIndex = useMatrixLookup ? entity->mTransformLookupNumber : i;
+                    size_t matrixIndex = mUseBakedAnimation ? getBakedAnimationRow( entity ) :
+                                         useMatrixLookup ? entity->mTransformLookupNumber : i;
                     size_t instanceIdx = matrixIndex * mMatricesPerInstance * mRowLength;
                     *thisVec = ((instanceIdx % maxPixelsPerLine) / texWidth) - (float)(texelOffsets.x);
                     *(thisVec + 1) = ((instanceIdx / maxPixelsPerLine) / texHeight) - (float)(texelOffsets.y);
@@ -372,6 +568,15 @@ namespace Ogre
 
             const size_t maxUsableWidth = c_maxTexWidthHW - (c_maxTexWidthHW % (numBones * mRowLength));
 
+            if( mUseBakedAnimation )
+            {
+                //Baked animations don't take room per instance in the vertex texture, but all
+                //the palettes must fit in it. See InstanceBatchHW::calculateMaxNumInstances for the 65535
+                BakedClipMap clips;
+                const size_t maxPalettes = maxUsableWidth * c_maxTexHeightHW / mRowLength / numBones;
+                return calculateBakedClips( clips ) <= maxPalettes ? 65535 : 0;
+            }
+
             //See InstanceBatchHW::calculateMaxNumInstances for the 65535
             retVal = std::min<size_t>( 65535, maxUsableWidth * c_maxTexHeightHW / mRowLength / numBones );
 
@@ -399,6 +604,13 @@ namespace Ogre
     //-----------------------------------------------------------------------
     size_t InstanceBatchHW_VTF::updateVertexTexture( Camera *currentCamera )
     {
+        if( mUseBakedAnimation )
+        {
+            //The vertex texture never changes, only the frame each instance looks up does
+            mDirtyAnimation = false;
+            return updateInstanceDataBuffer( false, currentCamera );
+        }
+
         size_t renderedInstances = 0;
         bool useMatrixLookup = useBoneMatrixLookup();
         if (useMatrixLookup)
@@ -251,20 +251,40 @@ namespace Ogre
         
         mNumWorldMatrices = uniqueAnimations * mMatricesPerInstance;
 
+        size_t texWidth, texHeight;
+        calculateVertexTextureSize( mNumWorldMatrices, texWidth, texHeight );
+
+        //Don't use 1D textures, as OGL goes crazy because the shader should be calling texture1D()...
+        TextureType texType = TEX_TYPE_2D;
+
+        mMatrixTexture = TextureManager::getSingleton().createManual(
+                                        mName + "/VTF", mMeshReference->getGroup(), texType,
+                                        (uint)texWidth, (uint)texHeight,
+                                        0, PF_FLOAT32_RGBA, TU_DYNAMIC_WRITE_ONLY_DISCARDABLE );
+
+        OgreAssert(mMatrixTexture->getFormat() == PF_FLOAT32_RGBA, "float texture support required");
+        //Set our cloned material to use this custom texture!
+        setupMaterialToUseVTF( texType, mMaterial );
+    }
+
+    //-----------------------------------------------------------------------
+    void BaseInstanceBatchVTF::calculateVertexTextureSize( size_t numWorldMatrices, size_t &outWidth,
+                                                           size_t &outHeight )
+    {
         //Calculate the width & height required to hold all the matrices. Start by filling the width
         //first (i.e. 4096x1 4096x2 4096x3, etc)
         
-        size_t texWidth         = std::min<size_t>( mNumWorldMatrices * mRowLength, c_maxTexWidth );
-        size_t maxUsableWidth   = texWidth;
+        outWidth                = std::min<size_t>( numWorldMatrices * mRowLength, c_maxTexWidth );
+        size_t maxUsableWidth   = outWidth;
         if( matricesTogetherPerRow() )
         {
             //The technique requires all matrices from the same instance in the same row
             //i.e. 4094 -> 4095 -> skip 4096 -> 0 (next row) contains data from a new instance 
-            mWidthFloatsPadding = texWidth % (mMatricesPerInstance * mRowLength);
+            mWidthFloatsPadding = outWidth % (mMatricesPerInstance * mRowLength);
 
             if( mWidthFloatsPadding )
             {
-                mMaxFloatsPerLine = texWidth - mWidthFloatsPadding;
+                mMaxFloatsPerLine = outWidth - mWidthFloatsPadding;
 
                 maxUsableWidth = mMaxFloatsPerLine;
 
@@ -274,24 +294,11 @@ namespace Ogre
             }
         }
 
-        size_t texHeight = mNumWorldMatrices * mRowLength / maxUsableWidth;
-
-        if( (mNumWorldMatrices * mRowLength) % maxUsableWidth )
-            texHeight += 1;
-
-        //Don't use 1D textures, as OGL goes crazy because the shader should be calling texture1D()...
-        TextureType texType = TEX_TYPE_2D;
-
-        mMatrixTexture = TextureManager::getSingleton().createManual(
-                                        mName + "/VTF", mMeshReference->getGroup(), texType,
-                                        (uint)texWidth, (uint)texHeight,
-                                        0, PF_FLOAT32_RGBA, TU_DYNAMIC_WRITE_ONLY_DISCARDABLE );
+        outHeight = numWorldMatrices * mRowLength / maxUsableWidth;
 
-        OgreAssert(mMatrixTexture->getFormat() == PF_FLOAT32_RGBA, "float texture support required");
-        //Set our cloned material to use this custom texture!
-        setupMaterialToUseVTF( texType, mMaterial );
+        if( (numWorldMatrices * mRowLength) % maxUsableWidth )
+            outHeight += 1;
     }
-
     //-----------------------------------------------------------------------
     size_t BaseInstanceBatchVTF::convert3x4MatricesToDualQuaternions(Matrix3x4f* matrices, size_t numOfMatrices, float* outDualQuaternions)
     {
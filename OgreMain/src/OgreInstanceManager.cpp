@@ -46,6 +46,7 @@ namespace Ogre
                 mSubMeshIdx( subMeshIdx ),
                 mSceneManager( sceneManager ),
                 mMaxLookupTableInstances(16),
+                mBakedAnimationFrameRate(30),
                 mNumCustomParams( 0 )
     {
         mMeshReference = MeshManager::getSingleton().load( meshName, groupName );
@@ -73,6 +74,12 @@ namespace Ogre
 
             ++itor;
         }
+
+        //The baked animation texture is shared by all our batches
+        //There is no TextureManager without a RenderSystem
+        TextureManager *textureManager = TextureManager::getSingletonPtr();
+        if( textureManager && textureManager->resourceExists( mName + "/BakedVTF", mMeshReference->getGroup() ) )
+            textureManager->remove( mName + "/BakedVTF", mMeshReference->getGroup() );
     }
     //----------------------------------------------------------------------
     void InstanceManager::setInstancesPerBatch( size_t instancesPerBatch )
@@ -88,6 +95,13 @@ namespace Ogre
         mMaxLookupTableInstances = maxLookupTableInstances;
     }
     
+    //----------------------------------------------------------------------
+    void InstanceManager::setBakedAnimationFrameRate( Real framesPerSecond )
+    {
+        OgreAssert(mInstanceBatches.empty(), "can only be changed before building the batch");
+        mBakedAnimationFrameRate = framesPerSecond;
+    }
+
     //----------------------------------------------------------------------
     void InstanceManager::setNumCustomParams( unsigned char numCustomParams )
     {
@@ -131,6 +145,7 @@ namespace Ogre
             static_cast<InstanceBatchHW_VTF*>(batch)->setBoneDualQuaternions((mInstancingFlags & IM_USEBONEDUALQUATERNIONS) != 0);
             static_cast<InstanceBatchHW_VTF*>(batch)->setUseOneWeight((mInstancingFlags & IM_USEONEWEIGHT) != 0);
             static_cast<InstanceBatchHW_VTF*>(batch)->setForceOneWeight((mInstancingFlags & IM_FORCEONEWEIGHT) != 0);
+            static_cast<InstanceBatchHW_VTF*>(batch)->setBakedAnimation((mInstancingFlags & IM_VTFBAKEDANIMATION) != 0, mBakedAnimationFrameRate);
             break;
         default:
             OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
@@ -221,6 +236,7 @@ namespace Ogre
             static_cast<InstanceBatchHW_VTF*>(batch)->setBoneDualQuaternions((mInstancingFlags & IM_USEBONEDUALQUATERNIONS) != 0);
             static_cast<InstanceBatchHW_VTF*>(batch)->setUseOneWeight((mInstancingFlags & IM_USEONEWEIGHT) != 0);
             static_cast<InstanceBatchHW_VTF*>(batch)->setForceOneWeight((mInstancingFlags & IM_FORCEONEWEIGHT) != 0);
+            static_cast<InstanceBatchHW_VTF*>(batch)->setBakedAnimation((mInstancingFlags & IM_VTFBAKEDANIMATION) != 0, mBakedAnimationFrameRate);
             break;
         default:
             OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
@@ -482,12 +498,26 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void InstanceManager::_updateDirtyBatches(void)
     {
+        //Lazy node updates may flag more batches as dirty, so they must happen on this
+        //thread and we can't hold iterators while doing them
+        for( size_t i=0; i<mDirtyBatches.size(); ++i )
+            mDirtyBatches[i]->_updateInstanceNodes();
+
+        //Each batch only touches its own instances, so they can be spread over the workers
+        Root::getSingleton().getWorkQueue()->parallelFor( mDirtyBatches.size(),
+                                                          [this]( size_t i )
+        {
+            mDirtyBatches[i]->_calculateBounds();
+        } );
+
+        //Notifying the scene graph isn't thread safe
         InstanceBatchVec::const_iterator itor = mDirtyBatches.begin();
         InstanceBatchVec::const_iterator end  = mDirtyBatches.end();
 
         while( itor != end )
         {
-            (*itor)->_updateBounds();
+            if( (*itor)->getParentNode() )
+                (*itor)->getParentNode()->needUpdate();
             ++itor;
         }
 
@@ -546,6 +576,9 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void InstanceManager::unshareVertices(const Ogre::MeshPtr &mesh)
     {
+        // the LOD index data is rewritten below
+        mesh->loadStreamedLodLevels();
+
         // Retrieve data to copy bone assignments
         const Mesh::VertexBoneAssignmentList& boneAssignments = mesh->getBoneAssignments();
         Mesh::VertexBoneAssignmentList::const_iterator it = boneAssignments.begin();
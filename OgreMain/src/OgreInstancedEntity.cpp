@@ -86,7 +86,8 @@ namespace Ogre
     {
         if( !this->mBatchOwner->_getMeshRef()->hasSkeleton() ||
             !this->mBatchOwner->_getMeshRef()->getSkeleton() ||
-            !this->mBatchOwner->_supportsSkeletalAnimation() )
+            !this->mBatchOwner->_supportsSkeletalAnimation() ||
+            this->mBatchOwner->useBakedAnimation() )
         {
             return false;
         }
@@ -254,6 +255,13 @@ namespace Ogre
             mBatchOwner->_getMeshRef()->getSkeleton() &&
             mBatchOwner->_supportsSkeletalAnimation() )
         {
+            mAnimationState = OGRE_NEW AnimationStateSet();
+            mBatchOwner->_getMeshRef()->_initAnimationState( mAnimationState );
+
+            //Baked animations are looked up by the animation states alone
+            if( mBatchOwner->useBakedAnimation() )
+                return;
+
             mSkeletonInstance = OGRE_NEW SkeletonInstance( mBatchOwner->_getMeshRef()->getSkeleton() );
             mSkeletonInstance->load();
 
@@ -267,9 +275,6 @@ namespace Ogre
                                                                     MEMCATEGORY_ANIMATION));
                 std::fill(mBoneWorldMatrices, mBoneWorldMatrices + mSkeletonInstance->getNumBones(), Affine3::IDENTITY);
             }
-
-            mAnimationState = OGRE_NEW AnimationStateSet();
-            mBatchOwner->_getMeshRef()->_initAnimationState( mAnimationState );
         }
     }
     //-----------------------------------------------------------------------
@@ -286,15 +291,16 @@ namespace Ogre
             mSharingPartners.clear();
 
             OGRE_DELETE mSkeletonInstance;
-            OGRE_DELETE mAnimationState;
             OGRE_FREE_SIMD( mBoneMatrices, MEMCATEGORY_ANIMATION );
             OGRE_FREE_SIMD( mBoneWorldMatrices, MEMCATEGORY_ANIMATION );
 
             mSkeletonInstance   = 0;
-            mAnimationState     = 0;
             mBoneMatrices       = 0;
             mBoneWorldMatrices  = 0;
         }
+
+        OGRE_DELETE mAnimationState;
+        mAnimationState = 0;
     }
     //-----------------------------------------------------------------------
     void InstancedEntity::stopSharingTransformAsSlave( bool notifyMaster )
@@ -392,7 +398,7 @@ namespace Ogre
         {
             return mSharedTransformEntity->_updateAnimation();
         }
-        else
+        else if( mSkeletonInstance )
         {
             const bool animationDirty =
                 (mFrameAnimationLastUpdated != mAnimationState->getDirtyFrameNumber()) ||
@@ -65,6 +65,12 @@ ManualObject::ManualObject(const String& name)
         mAnyIndexed = false;
 
         clearShadowRenderableList(mShadowRenderables);
+
+        // Tell parent if present
+        if (mParentNode)
+        {
+            mParentNode->needUpdate();
+        }
     }
     //-----------------------------------------------------------------------------
     void ManualObject::resetTempAreas(void)
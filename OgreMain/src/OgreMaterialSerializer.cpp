@@ -1812,6 +1812,8 @@ namespace Ogre
                             paramstr.clear();
                         if ((name == "uses_vertex_texture_fetch") && (paramstr == "false"))
                             paramstr.clear();
+                        if ((name == "includes_instancing") && (paramstr == "false"))
+                            paramstr.clear();
 
                         if ((language != "asm") && (name == "syntax"))
                             paramstr.clear();
@@ -48,6 +48,8 @@ namespace Ogre {
         mLodStrategy(LodStrategyManager::getSingleton().getDefaultStrategy()),
         mHasManualLodLevel(false),
         mNumLods(1),
+        mStreamLodLevels(false),
+        mLodStreamFlipEndian(false),
         mBufferManager(0),
         mVertexBufferUsage(HardwareBuffer::HBU_STATIC_WRITE_ONLY),
         mIndexBufferUsage(HardwareBuffer::HBU_STATIC_WRITE_ONLY),
@@ -203,6 +205,14 @@ namespace Ogre {
             ResourceGroupManager::getSingleton().openResource(
                 mName, mGroup, this);
  
+        // a mapped file is already addressable, so only take a view with an own read position
+        if (auto mapped = dynamic_cast<MemoryMappedDataStream*>(mFreshFromDisk.get()))
+        {
+            size_t offset = mapped->tell();
+            mFreshFromDisk.reset(OGRE_NEW MemoryMappedDataStream(mName, *mapped, offset, mapped->size() - offset));
+            return;
+        }
+
         // fully prebuffer into host RAM
         mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
     }
@@ -230,7 +240,18 @@ namespace Ogre {
         if (!codec)
             OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "No codec found to load " + mName);
 
-        codec->decode(data, this);
+        // LOD levels can only be streamed, if their data can be read again from the resource
+        mStreamLodLevels = MeshManager::getSingleton().getLodStreaming();
+        try
+        {
+            codec->decode(data, this);
+        }
+        catch (...)
+        {
+            mStreamLodLevels = false;
+            throw;
+        }
+        mStreamLodLevels = false;
     }
 
     //-----------------------------------------------------------------------
@@ -297,6 +318,9 @@ namespace Ogre {
         String theGroup = newGroup.empty() ? this->getGroup() : newGroup;
         MeshPtr newMesh = MeshManager::getSingleton().createManual(newName, theGroup);
 
+        // the clone is manual, so it can not stream its LOD levels
+        loadStreamedLodLevels();
+
         if(!newMesh) // interception by collision handler
             return newMesh;
 
@@ -1176,6 +1200,7 @@ namespace Ogre {
 
         mNumLods = numLevels;
         mMeshLodUsageList.resize(numLevels);
+        mStreamedLodLevels.clear();
         // Resize submesh face data lists too
         for (SubMeshList::iterator i = mSubMeshList.begin(); i != mSubMeshList.end(); ++i)
         {
@@ -1223,6 +1248,123 @@ namespace Ogre {
 #endif
     }
     //---------------------------------------------------------------------
+    bool Mesh::isLodLevelResident(ushort index) const
+    {
+        return index >= mStreamedLodLevels.size() || mStreamedLodLevels[index].resident;
+    }
+    //---------------------------------------------------------------------
+    ushort Mesh::_getResidentLodIndex(ushort index)
+    {
+        if (index >= mStreamedLodLevels.size())
+            return index;
+
+        unsigned long frame = Root::getSingleton().getNextFrameNumber();
+        StreamedLodLevel& level = mStreamedLodLevels[index];
+        level.lastUsedFrame = frame;
+        if (level.resident)
+            return index;
+
+        if (!level.pending && !level.failed)
+        {
+            level.pending = true;
+            MeshManager::getSingleton()._requestLodStreaming(this, index);
+        }
+
+        // fall back to a coarser level meanwhile, the coarsest one is never streamed
+        while (!mStreamedLodLevels[index].resident)
+            ++index;
+        mStreamedLodLevels[index].lastUsedFrame = frame;
+        return index;
+    }
+    //---------------------------------------------------------------------
+    void Mesh::loadStreamedLodLevels()
+    {
+        DataStreamPtr stream;
+        for (ushort i = 1; i < mStreamedLodLevels.size(); ++i)
+        {
+            if (mStreamedLodLevels[i].resident)
+                continue;
+
+            if (!stream)
+                stream = ResourceGroupManager::getSingleton().openResource(mName, mGroup, this);
+            loadStreamedLodLevel(i, stream, true);
+        }
+    }
+    //---------------------------------------------------------------------
+    HardwareIndexBufferPtr Mesh::readLodIndexBuffer(const StreamedLodLevel::Source& src,
+                                                    const DataStreamPtr& stream)
+    {
+        HardwareIndexBufferPtr ibuf = getHardwareBufferManager()->createIndexBuffer(
+            src.idx32Bit ? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT,
+            src.indexCount, mIndexBufferUsage, mIndexBufferShadowBuffer);
+
+        HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::HBL_DISCARD);
+        size_t size = ibuf->getSizeInBytes();
+        if (stream->read(ibufLock.pData, size) != size)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Unexpected end of LOD index data in " + mName);
+
+        if (mLodStreamFlipEndian)
+            Bitwise::bswapChunks(ibufLock.pData, ibuf->getIndexSize(), src.indexCount);
+
+        return ibuf;
+    }
+    //---------------------------------------------------------------------
+    void Mesh::loadStreamedLodLevel(ushort index, const DataStreamPtr& stream, bool seekToSource)
+    {
+        StreamedLodLevel& level = mStreamedLodLevels[index];
+        for (size_t i = 0; i < level.sources.size(); ++i)
+        {
+            const StreamedLodLevel::Source& src = level.sources[i];
+            SubMesh* sm = mSubMeshList[i];
+            if (src.owner != index && mStreamedLodLevels[src.owner].resident)
+            {
+                // merged buffer, that the owning level already loaded
+                sm->mLodFaceList[index - 1]->indexBuffer = sm->mLodFaceList[src.owner - 1]->indexBuffer;
+                if (!seekToSource)
+                    stream->skip(src.indexCount * (src.idx32Bit ? 4 : 2));
+                continue;
+            }
+
+            if (seekToSource)
+                stream->seek(src.offset);
+            sm->mLodFaceList[index - 1]->indexBuffer = readLodIndexBuffer(src, stream);
+        }
+
+        level.resident = true;
+        level.pending = false;
+        level.failed = false;
+    }
+    //---------------------------------------------------------------------
+    void Mesh::evictStreamedLodLevel(ushort index)
+    {
+        for (SubMesh* sm : mSubMeshList)
+            sm->mLodFaceList[index - 1]->indexBuffer.reset();
+        mStreamedLodLevels[index].resident = false;
+
+        // render commands might have been recorded with the level
+        for (const auto& sm : Root::getSingleton().getSceneManagers())
+        {
+            if (sm.second->_hasRenderRecordings())
+                sm.second->_notifySceneChanged(AxisAlignedBox::BOX_INFINITE);
+        }
+    }
+    //---------------------------------------------------------------------
+    size_t Mesh::getStreamedLodLevelSize(ushort index) const
+    {
+        const StreamedLodLevel& level = mStreamedLodLevels[index];
+        size_t size = 0;
+        for (size_t i = 0; i < level.sources.size(); ++i)
+        {
+            const SubMesh::LODFaceList& lods = mSubMeshList[i]->mLodFaceList;
+            const HardwareIndexBufferPtr& ibuf = lods[index - 1]->indexBuffer;
+            // merged buffers count towards their owner
+            ushort owner = level.sources[i].owner;
+            if (ibuf && (owner == index || ibuf != lods[owner - 1]->indexBuffer))
+                size += ibuf->getSizeInBytes();
+        }
+        return size;
+    }
+    //---------------------------------------------------------------------
     ushort Mesh::_getSubMeshIndex(const String& name) const
     {
         SubMeshNameMap::const_iterator i = mSubMeshNameMap.find(name) ;
@@ -1251,6 +1393,7 @@ namespace Ogre {
         mNumLods = 1;
         mMeshLodUsageList.resize(1);
         mMeshLodUsageList[0].edgeData = NULL;
+        mStreamedLodLevels.clear();
 
         if(edgeListWasBuilt)
             buildEdgeList();
@@ -1660,6 +1803,8 @@ namespace Ogre {
         if (mEdgeListsBuilt)
             return;
 #if !OGRE_NO_MESHLOD
+        loadStreamedLodLevels();
+
         // Loop over LODs
         for (unsigned short lodIndex = 0; lodIndex < (unsigned short)mMeshLodUsageList.size(); ++lodIndex)
         {
@@ -2134,6 +2279,71 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void Mesh::softwareVertexPoseBlend(const PoseWeightList& poses, VertexData* targetVertexData)
+    {
+        const VertexElement* posElem =
+            targetVertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+        const VertexElement* normElem =
+            targetVertexData->vertexDeclaration->findElementBySemantic(VES_NORMAL);
+        assert(posElem);
+        bool normalsInBuffer = normElem && posElem->getSource() == normElem->getSource();
+        HardwareVertexBufferSharedPtr destBuf =
+            targetVertexData->vertexBufferBinding->getBuffer(
+            posElem->getSource());
+
+        size_t elemsPerVertex = destBuf->getVertexSize()/sizeof(float);
+
+        // Have to lock in normal mode since this is incremental
+        HardwareBufferLockGuard destLock;
+        float* pPosBase = 0;
+        float* pNormBase = 0;
+
+        for (const auto& p : poses)
+        {
+            const float weight = float(p.second);
+            // Do nothing if no weight
+            if (weight == 0.0f)
+                continue;
+
+            const std::vector<uint32>& indices = p.first->_getPackedIndices();
+            if (indices.empty())
+                continue;
+
+            if (!pPosBase)
+            {
+                destLock.lock(destBuf, HardwareBuffer::HBL_NORMAL);
+                posElem->baseVertexPointerToElement(destLock.pData, &pPosBase);
+                if (normalsInBuffer)
+                    normElem->baseVertexPointerToElement(destLock.pData, &pNormBase);
+            }
+
+            const uint32* pIdx = indices.data();
+            const float* pOffset = p.first->_getPackedOffsets().data();
+            const size_t count = indices.size();
+            for (size_t i = 0; i < count; ++i, pOffset += 3)
+            {
+                float* pdst = pPosBase + pIdx[i] * elemsPerVertex;
+                pdst[0] += pOffset[0] * weight;
+                pdst[1] += pOffset[1] * weight;
+                pdst[2] += pOffset[2] * weight;
+            }
+
+            // Support normals if they're in the same buffer as positions and pose includes them
+            const std::vector<float>& normals = p.first->_getPackedNormals();
+            if (pNormBase && normals.size() == count * 3)
+            {
+                const float* pNormal = normals.data();
+                for (size_t i = 0; i < count; ++i, pNormal += 3)
+                {
+                    float* pdst = pNormBase + pIdx[i] * elemsPerVertex;
+                    pdst[0] += pNormal[0] * weight;
+                    pdst[1] += pNormal[1] * weight;
+                    pdst[2] += pNormal[2] * weight;
+                }
+            }
+        }
+    }
+    //---------------------------------------------------------------------
     size_t Mesh::calculateSize(void) const
     {
         // calculate GPU size
@@ -29,6 +29,7 @@ THE SOFTWARE.
 
 #include "OgrePatchMesh.h"
 #include "OgrePrefabFactory.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre
 {
@@ -45,6 +46,101 @@ namespace Ogre
         }
     };
 
+
+    namespace
+    {
+        struct LodStreamingRequest
+        {
+            MeshPtr mesh;
+            ushort index;
+            size_t stateCount;
+            /// offset and size of the index buffers in the mesh file
+            std::vector<std::pair<size_t, size_t>> ranges;
+        };
+
+        struct LodStreamingResponse
+        {
+            MeshPtr mesh;
+            ushort index;
+            size_t stateCount;
+            DataStreamPtr data;
+        };
+    }
+    /// reads the index data of streamed LOD levels on the WorkQueue
+    class MeshManager::LodStreamingHandler : public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler
+    {
+        MeshManager* mManager;
+        uint16 mChannel;
+    public:
+        LodStreamingHandler(MeshManager* manager) : mManager(manager)
+        {
+            WorkQueue* wq = Root::getSingleton().getWorkQueue();
+            mChannel = wq->getChannel("Ogre/MeshLodStreaming");
+            wq->addRequestHandler(mChannel, this);
+            wq->addResponseHandler(mChannel, this);
+        }
+
+        ~LodStreamingHandler()
+        {
+            if (!Root::getSingletonPtr())
+                return;
+            WorkQueue* wq = Root::getSingleton().getWorkQueue();
+            wq->abortRequestsByChannel(mChannel);
+            wq->removeRequestHandler(mChannel, this);
+            wq->removeResponseHandler(mChannel, this);
+        }
+
+        void request(const LodStreamingRequest& req)
+        {
+            Root::getSingleton().getWorkQueue()->addRequest(mChannel, 0, req);
+        }
+
+        WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ) override
+        {
+            LodStreamingRequest sreq = any_cast<LodStreamingRequest>(req->getData());
+            LodStreamingResponse sres = {sreq.mesh, sreq.index, sreq.stateCount, DataStreamPtr()};
+
+            try
+            {
+                size_t total = 0;
+                for (const auto& r : sreq.ranges)
+                    total += r.second;
+
+                // only the index buffers of the level, back to back
+                DataStreamPtr file = ResourceGroupManager::getSingleton().openResource(
+                    sreq.mesh->getName(), sreq.mesh->getGroup(), sreq.mesh.get());
+                auto data = std::make_shared<MemoryDataStream>(total);
+                uchar* dst = data->getPtr();
+                for (const auto& r : sreq.ranges)
+                {
+                    file->seek(r.first);
+                    if (file->read(dst, r.second) != r.second)
+                        OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Unexpected end of LOD index data");
+                    dst += r.second;
+                }
+                sres.data = data;
+            }
+            catch (const Exception& e)
+            {
+                return OGRE_NEW WorkQueue::Response(req, false, sres, e.getFullDescription());
+            }
+
+            return OGRE_NEW WorkQueue::Response(req, true, sres);
+        }
+
+        void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ) override
+        {
+            LodStreamingResponse sres = any_cast<LodStreamingResponse>(res->getData());
+            if (!res->succeeded())
+            {
+                LogManager::getSingleton().logError("Streaming LOD " + StringConverter::toString(sres.index) +
+                                                    " of mesh '" + sres.mesh->getName() +
+                                                    "' failed: " + res->getMessages());
+            }
+
+            mManager->finishLodStreaming(sres.mesh.get(), sres.index, sres.stateCount, sres.data);
+        }
+    };
     //-----------------------------------------------------------------------
     template<> MeshManager* Singleton<MeshManager>::msSingleton = 0;
     MeshManager* MeshManager::getSingletonPtr(void)
@@ -57,7 +153,7 @@ namespace Ogre
     }
     //-----------------------------------------------------------------------
     MeshManager::MeshManager():
-    mBoundsPaddingFactor(0.01), mListener(0)
+    mBoundsPaddingFactor(0.01), mListener(0), mLodStreaming(false), mLodStreamingBudget(0)
     {
         mBlendWeightsBaseElementType = VET_FLOAT1;
         mPrepAllMeshesForShadowVolumes = false;
@@ -360,6 +456,114 @@ namespace Ogre
         return mListener;
     }
     //-----------------------------------------------------------------------
+    void MeshManager::_requestLodStreaming(Mesh* mesh, ushort index)
+    {
+        MeshPtr meshPtr = static_pointer_cast<Mesh>(getByHandle(mesh->getHandle()));
+        if (!meshPtr)
+        {
+            // not managed, so there is no file to read from
+            mesh->mStreamedLodLevels[index].pending = false;
+            mesh->mStreamedLodLevels[index].failed = true;
+            return;
+        }
+
+        LodStreamingRequest req = {meshPtr, index, mesh->getStateCount(), {}};
+        for (const auto& src : mesh->mStreamedLodLevels[index].sources)
+            req.ranges.push_back({src.offset, src.indexCount * (src.idx32Bit ? 4 : 2)});
+
+        if (!mLodStreamingHandler)
+            mLodStreamingHandler.reset(new LodStreamingHandler(this));
+        mLodStreamingHandler->request(req);
+    }
+    //-----------------------------------------------------------------------
+    void MeshManager::finishLodStreaming(Mesh* mesh, ushort index, size_t stateCount, const DataStreamPtr& data)
+    {
+        // the mesh might have been reloaded or had its LOD levels replaced meanwhile
+        if (!mesh->isLoaded() || mesh->getStateCount() != stateCount || index >= mesh->mStreamedLodLevels.size())
+            return;
+
+        Mesh::StreamedLodLevel& level = mesh->mStreamedLodLevels[index];
+        level.pending = false;
+        if (level.resident)
+            return;
+
+        // keep rendering the fallback level instead of retrying every frame
+        level.failed = true;
+        if (!data)
+            return;
+
+        try
+        {
+            mesh->loadStreamedLodLevel(index, data, false);
+        }
+        catch (const Exception& e)
+        {
+            LogManager::getSingleton().logError("Streaming LOD " + StringConverter::toString(index) +
+                                                " of mesh '" + mesh->getName() + "' failed: " + e.getDescription());
+            return;
+        }
+
+        // not rendered yet, so it must not be the first to go
+        level.lastUsedFrame = Root::getSingleton().getNextFrameNumber();
+        enforceLodStreamingBudget();
+    }
+    //-----------------------------------------------------------------------
+    void MeshManager::enforceLodStreamingBudget()
+    {
+        if (!mLodStreamingBudget)
+            return;
+
+        struct Streamed
+        {
+            Mesh* mesh;
+            ushort index;
+            unsigned long lastUsedFrame;
+            size_t size;
+        };
+        std::vector<Streamed> streamed;
+        size_t total = 0;
+        {
+            OGRE_LOCK_AUTO_MUTEX;
+            for (const auto& r : mResourcesByHandle)
+            {
+                auto mesh = static_cast<Mesh*>(r.second.get());
+                if (!mesh->isLoaded())
+                    continue;
+
+                for (ushort i = 1; i < mesh->mStreamedLodLevels.size(); ++i)
+                {
+                    const Mesh::StreamedLodLevel& level = mesh->mStreamedLodLevels[i];
+                    if (level.sources.empty() || !level.resident)
+                        continue;
+
+                    Streamed s = {mesh, i, level.lastUsedFrame, mesh->getStreamedLodLevelSize(i)};
+                    streamed.push_back(s);
+                    total += s.size;
+                }
+            }
+        }
+
+        if (total <= mLodStreamingBudget)
+            return;
+
+        // unload the least recently rendered levels first, but never the ones on screen right now
+        std::sort(streamed.begin(), streamed.end(), [](const Streamed& a, const Streamed& b) {
+            return a.lastUsedFrame < b.lastUsedFrame;
+        });
+
+        // responses are processed after the frame number was incremented, so the levels of the
+        // frame rendered last carry the previous number
+        unsigned long frame = Root::getSingleton().getNextFrameNumber();
+        for (const auto& s : streamed)
+        {
+            if (total <= mLodStreamingBudget || s.lastUsedFrame + 1 >= frame)
+                break;
+
+            total -= s.size;
+            s.mesh->evictStreamedLodLevel(s.index);
+        }
+    }
+    //-----------------------------------------------------------------------
     void MeshManager::PrefabLoader::loadResource(Resource* res)
     {
         Mesh* msh = static_cast<Mesh*>(res);
@@ -151,7 +151,10 @@ namespace Ogre {
             OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Cannot find serializer implementation for "
                     "specified version", "MeshSerializer::exportMesh");
 
-                    
+
+        // streamed LOD levels are written as well
+        const_cast<Mesh*>(pMesh)->loadStreamedLodLevels();
+
         impl->exportMesh(pMesh, stream, endianMode);
     }
     //---------------------------------------------------------------------
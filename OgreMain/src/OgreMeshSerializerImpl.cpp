@@ -813,15 +813,18 @@ namespace Ogre {
             dest->vertexCount,
             pMesh->mVertexBufferUsage,
             pMesh->mVertexBufferShadowBuffer);
-        HardwareBufferLockGuard vbufLock(vbuf, HardwareBuffer::HBL_DISCARD);
-        stream->read(vbufLock.pData, dest->vertexCount * vertexSize);
-
-        // endian conversion for OSX
-        flipFromLittleEndian(
-            vbufLock.pData,
-            dest->vertexCount,
-            vertexSize,
-            dest->vertexDeclaration->findElementsBySource(bindIndex));
+        if (!readBufferInPlace(stream, vbuf.get()))
+        {
+            HardwareBufferLockGuard vbufLock(vbuf, HardwareBuffer::HBL_DISCARD);
+            stream->read(vbufLock.pData, dest->vertexCount * vertexSize);
+
+            // endian conversion for OSX
+            flipFromLittleEndian(
+                vbufLock.pData,
+                dest->vertexCount,
+                vertexSize,
+                dest->vertexDeclaration->findElementsBySource(bindIndex));
+        }
 
         // Set binding
         dest->vertexBufferBinding->setBinding(bindIndex, vbuf);
@@ -1018,9 +1021,11 @@ namespace Ogre {
                         sm->indexData->indexCount,
                         pMesh->mIndexBufferUsage,
                         pMesh->mIndexBufferShadowBuffer);
-                HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::HBL_DISCARD);
-                readInts(stream, static_cast<unsigned int*>(ibufLock.pData), sm->indexData->indexCount);
-
+                if (!readBufferInPlace(stream, ibuf.get()))
+                {
+                    HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::HBL_DISCARD);
+                    readInts(stream, static_cast<unsigned int*>(ibufLock.pData), sm->indexData->indexCount);
+                }
             }
             else // 16-bit
             {
@@ -1029,8 +1034,11 @@ namespace Ogre {
                         sm->indexData->indexCount,
                         pMesh->mIndexBufferUsage,
                         pMesh->mIndexBufferShadowBuffer);
-                HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::HBL_DISCARD);
-                readShorts(stream, static_cast<unsigned short*>(ibufLock.pData), sm->indexData->indexCount);
+                if (!readBufferInPlace(stream, ibuf.get()))
+                {
+                    HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::HBL_DISCARD);
+                    readShorts(stream, static_cast<unsigned short*>(ibufLock.pData), sm->indexData->indexCount);
+                }
             }
         }
         sm->indexData->indexBuffer = ibuf;
@@ -1501,6 +1509,11 @@ namespace Ogre {
         readShorts(stream, &(pMesh->mNumLods), 1);
 
         pMesh->mMeshLodUsageList.resize(pMesh->mNumLods);
+        if (pMesh->mStreamLodLevels)
+        {
+            pMesh->mStreamedLodLevels.resize(pMesh->mNumLods);
+            pMesh->mLodStreamFlipEndian = mFlipEndian;
+        }
         ushort numSubs, i;
         numSubs = pMesh->getNumSubMeshes();
         for (i = 0; i < numSubs; ++i)
@@ -1556,6 +1569,15 @@ namespace Ogre {
     {
         usage.manualName = "";
 
+        // With LOD streaming, only the location of the index data is recorded for the levels
+        // between the full detail and the coarsest one. See Mesh::_getResidentLodIndex
+        Mesh::StreamedLodLevel* streamed = NULL;
+        if (pMesh->mStreamLodLevels && lodNum < pMesh->mNumLods - 1)
+        {
+            streamed = &pMesh->mStreamedLodLevels[lodNum];
+            streamed->resident = false;
+        }
+
         // Get one set of detail per SubMesh
         unsigned short numSubs, i;
         numSubs = pMesh->getNumSubMeshes();
@@ -1580,7 +1602,22 @@ namespace Ogre {
             if(bufferIndex != (unsigned int)-1) {
                 // copy buffer pointer
                 indexData->indexBuffer = sm->mLodFaceList[bufferIndex-1]->indexBuffer;
-                assert(indexData->indexBuffer);
+                if (!indexData->indexBuffer)
+                {
+                    // the buffer belongs to a streamed level
+                    const Mesh::StreamedLodLevel::Source& src =
+                        pMesh->mStreamedLodLevels[bufferIndex].sources[i];
+                    if (streamed)
+                    {
+                        streamed->sources.push_back(src);
+                        continue;
+                    }
+
+                    size_t pos = stream->tell();
+                    stream->seek(src.offset);
+                    indexData->indexBuffer = pMesh->readLodIndexBuffer(src, stream);
+                    stream->seek(pos);
+                }
             } else {
                 // generate buffers
 
@@ -1591,23 +1628,48 @@ namespace Ogre {
                 unsigned int buffIndexCount;
                 readInts(stream, &buffIndexCount, 1);
 
+                if (streamed)
+                {
+                    Mesh::StreamedLodLevel::Source src = {stream->tell(), buffIndexCount, idx32Bit,
+                                                          lodNum};
+                    streamed->sources.push_back(src);
+                    stream->skip(buffIndexCount * (idx32Bit ? 4 : 2));
+                    continue;
+                }
+
                 indexData->indexBuffer = pMesh->getHardwareBufferManager()->createIndexBuffer(
                     idx32Bit ? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT,
                     buffIndexCount, pMesh->mIndexBufferUsage, pMesh->mIndexBufferShadowBuffer);
-                HardwareBufferLockGuard ibufLock(indexData->indexBuffer, HardwareBuffer::HBL_DISCARD);
-
-                if (idx32Bit)
+                if (!readBufferInPlace(stream, indexData->indexBuffer.get()))
                 {
-                    readInts(stream, (uint32*)ibufLock.pData, buffIndexCount);
-                }
-                else
-                {
-                    readShorts(stream, (uint16*)ibufLock.pData, buffIndexCount);
+                    HardwareBufferLockGuard ibufLock(indexData->indexBuffer, HardwareBuffer::HBL_DISCARD);
+
+                    if (idx32Bit)
+                    {
+                        readInts(stream, (uint32*)ibufLock.pData, buffIndexCount);
+                    }
+                    else
+                    {
+                        readShorts(stream, (uint16*)ibufLock.pData, buffIndexCount);
+                    }
                 }
             }
         }
     }
 #endif
+    //---------------------------------------------------------------------
+    bool MeshSerializerImpl::readBufferInPlace(const DataStreamPtr& stream, HardwareBuffer* buf)
+    {
+        auto memory = dynamic_cast<MemoryDataStream*>(stream.get());
+        size_t size = buf->getSizeInBytes();
+        if (mFlipEndian || !memory || memory->size() - memory->tell() < size)
+            return false;
+
+        // e.g. a memory mapped file, so this is the only copy of the data
+        buf->writeData(0, size, memory->getCurrentPtr(), true);
+        memory->skip(long(size));
+        return true;
+    }
     //---------------------------------------------------------------------
     void MeshSerializerImpl::flipFromLittleEndian(void* pData, size_t vertexCount,
         size_t vertexSize, const VertexDeclaration::VertexElementList& elems)
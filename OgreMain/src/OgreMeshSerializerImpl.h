@@ -182,6 +182,10 @@ namespace Ogre {
         /// Flip the endianness of an entire vertex buffer, passed in as a 
         /// pointer to locked or temporary memory 
         virtual void flipEndian(void* pData, size_t vertexCount, size_t vertexSize, const VertexDeclaration::VertexElementList& elems);
+        /** Fill the whole buffer directly from the memory of the stream, skipping the staging copy of a lock.
+        @return false if the stream is not in memory or the data needs endian conversion
+        */
+        bool readBufferInPlace(const DataStreamPtr& stream, HardwareBuffer* buf);
         
         /// This function can be overloaded to disable validation in debug builds.
         virtual void enableValidation();
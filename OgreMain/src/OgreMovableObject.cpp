@@ -261,6 +261,17 @@ namespace Ogre {
         mRenderingDisabled = mListener && !mListener->objectRendering(this, cam);
     }
     //-----------------------------------------------------------------------
+    void MovableObject::setVisible(bool visible)
+    {
+        if (visible == mVisible)
+            return;
+        mVisible = visible;
+
+        // render commands recorded with the old visibility are stale now
+        if (mManager && mManager->_hasRenderRecordings() && isInScene())
+            mManager->_notifySceneChanged(getWorldBoundingBox(true));
+    }
+    //-----------------------------------------------------------------------
     void MovableObject::setRenderQueueGroup(uint8 queueID)
     {
         assert(queueID <= RENDER_QUEUE_MAX && "Render queue out of range!");
@@ -93,6 +93,17 @@ namespace Ogre {
         ScriptCompilerManager::getSingleton().parseScript(stream, groupName);
     }
     //-----------------------------------------------------------------------
+    Any ParticleSystemManager::prepareScript(DataStreamPtr& stream, const String& groupName)
+    {
+        return ScriptCompilerManager::getSingleton().prepareScript(stream, groupName);
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystemManager::parsePreparedScript(DataStreamPtr& stream, const String& groupName,
+                                                    const Any& prepared)
+    {
+        ScriptCompilerManager::getSingleton().parsePreparedScript(stream, groupName, prepared);
+    }
+    //-----------------------------------------------------------------------
     void ParticleSystemManager::addEmitterFactory(ParticleEmitterFactory* factory)
     {
         OGRE_LOCK_AUTO_MUTEX;
@@ -78,11 +78,73 @@ namespace Ogre {
         }
     };
     MinGpuProgramChangeHashFunc sMinGpuProgramChangeHashFunc;
+
+    /** Hands out the same ID for the same state, starting at 1
+
+        The state is keyed by content and resource handles, which are not reused,
+        so an ID never refers to a destroyed object. States are forgotten once no pass uses
+        them anymore, but their IDs are not handed out again.
+    */
+    struct StateIdPool
+    {
+        /// the ID of each state, along with the number of passes using it
+        typedef std::map<std::vector<size_t>, std::pair<uint32, uint32> > StateMap;
+        StateMap states;
+        std::unordered_map<uint32, StateMap::iterator> byId;
+        uint32 nextId = 1;
+
+        uint32 intern(const std::vector<size_t>& state)
+        {
+            auto ret = states.emplace(state, std::make_pair(nextId, 0u));
+            if (ret.second)
+            {
+                byId[nextId] = ret.first;
+                nextId = std::max(nextId + 1, 1u);
+            }
+            ret.first->second.second++;
+            return ret.first->second.first;
+        }
+
+        void release(uint32 id)
+        {
+            auto it = byId.find(id);
+            if (it == byId.end())
+                return;
+
+            if (--it->second->second.second == 0)
+            {
+                states.erase(it->second);
+                byId.erase(it);
+            }
+        }
+    };
+    StateIdPool sProgramIds, sTextureIds, sBlendIds, sDepthIds, sRasterIds;
+
+    static size_t floatBits(float f)
+    {
+        uint32 bits;
+        memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    static void appendSamplerState(std::vector<size_t>& state, const Sampler& sampler)
+    {
+        const Sampler::UVWAddressingMode& uvw = sampler.getAddressingMode();
+        const ColourValue& border = sampler.getBorderColour();
+        state.insert(state.end(), {size_t(sampler.getFiltering(FT_MIN)), size_t(sampler.getFiltering(FT_MAG)),
+                                   size_t(sampler.getFiltering(FT_MIP)), size_t(uvw.u), size_t(uvw.v),
+                                   size_t(uvw.w), size_t(sampler.getAnisotropy()),
+                                   floatBits(sampler.getMipmapBias()), size_t(sampler.getCompareEnabled()),
+                                   size_t(sampler.getCompareFunction()), floatBits(border.r), floatBits(border.g),
+                                   floatBits(border.b), floatBits(border.a)});
+    }
     //-----------------------------------------------------------------------------
     Pass::PassSet Pass::msDirtyHashList;
     Pass::PassSet Pass::msPassGraveyard;
+    uint32 Pass::msDeletionCounter = 0;
     OGRE_STATIC_MUTEX_INSTANCE(Pass::msDirtyHashListMutex);
     OGRE_STATIC_MUTEX_INSTANCE(Pass::msPassGraveyardMutex);
+    OGRE_STATIC_MUTEX_INSTANCE(Pass::msStateIdsMutex);
 
     Pass::HashFunc* Pass::msHashFunc = &sMinGpuProgramChangeHashFunc;
     //-----------------------------------------------------------------------------
@@ -119,6 +181,8 @@ namespace Ogre {
     Pass::Pass(Technique* parent, unsigned short index)
         : mParent(parent)
         , mHash(0)
+        , mSortKey(0)
+        , mChangeCount(0)
         , mAmbient(ColourValue::White)
         , mDiffuse(ColourValue::White)
         , mSpecular(ColourValue::Black)
@@ -177,7 +241,7 @@ namespace Ogre {
 
     //-----------------------------------------------------------------------------
     Pass::Pass(Technique *parent, unsigned short index, const Pass& oth)
-        : mParent(parent), mQueuedForDeletion(false), mIndex(index), mPassIterationCount(1)
+        : mParent(parent), mChangeCount(0), mQueuedForDeletion(false), mIndex(index), mPassIterationCount(1)
     {
         *this = oth;
         mParent = parent;
@@ -187,12 +251,16 @@ namespace Ogre {
         // init the hash inline
         _recalculateHash();
     }
-    Pass::~Pass() = default; // ensure unique_ptr destructors are in cpp
+    Pass::~Pass()
+    {
+        releaseStateIds();
+    }
     //-----------------------------------------------------------------------------
     Pass& Pass::operator=(const Pass& oth)
     {
         mName = oth.mName;
         mHash = oth.mHash;
+        mSortKey = oth.mSortKey;
         mAmbient = oth.mAmbient;
         mDiffuse = oth.mDiffuse;
         mSpecular = oth.mSpecular;
@@ -761,6 +829,17 @@ namespace Ogre {
         {
             _dirtyHash();
         }
+        else
+        {
+            // state may have been set before loading without dirtying the hash
+            uint64 sortKey = mSortKey;
+            compileStateIds();
+            if (mSortKey != sortKey)
+            {
+                mSortKey = sortKey; // until the hash is recalculated
+                _dirtyHash();
+            }
+        }
 
     }
     //-----------------------------------------------------------------------
@@ -821,10 +900,8 @@ namespace Ogre {
         // Needs recompilation
         _notifyNeedsRecompile();
 
-        if( Pass::getHashFunction() == Pass::getBuiltinHashFunction( Pass::MIN_GPU_PROGRAM_CHANGE ) )
-        {
-            _dirtyHash();
-        }
+        // the program IDs change regardless of the hash function
+        _dirtyHash();
     }
 
     void Pass::setGpuProgram(GpuProgramType type, const String& name, bool resetParams)
@@ -977,10 +1054,91 @@ namespace Ogre {
 
         // overwrite the 4 upper bits with pass index
         mHash = (uint32(mIndex) << 28) | (mHash >> 4);
+
+        compileStateIds();
+    }
+    //-----------------------------------------------------------------------
+    void Pass::compileStateIds(void)
+    {
+        std::vector<size_t> programs;
+        {
+            OGRE_LOCK_MUTEX(mGpuProgramChangeMutex);
+            for (const auto& u : mProgramUsage)
+                programs.push_back(u && u->getProgram() ? size_t(u->getProgram()->getHandle()) : 0);
+        }
+
+        std::vector<size_t> textures;
+        {
+            OGRE_LOCK_MUTEX(mTexUnitChangeMutex);
+            for (const TextureUnitState* tus : mTextureUnitStates)
+            {
+                textures.push_back(tus->getNumFrames());
+                for (unsigned int i = 0; i < tus->getNumFrames(); ++i)
+                    textures.push_back(std::hash<String>()(tus->getFrameTextureName(i)));
+                appendSamplerState(textures, *tus->getSampler());
+                textures.push_back(tus->getTextureCoordSet());
+                textures.push_back(tus->getContentType());
+            }
+        }
+
+        std::vector<size_t> blend = {mBlendState.writeR,
+                                     mBlendState.writeG,
+                                     mBlendState.writeB,
+                                     mBlendState.writeA,
+                                     mBlendState.sourceFactor,
+                                     mBlendState.destFactor,
+                                     mBlendState.sourceFactorAlpha,
+                                     mBlendState.destFactorAlpha,
+                                     mBlendState.operation,
+                                     mBlendState.alphaOperation,
+                                     mAlphaRejectFunc,
+                                     mAlphaRejectVal,
+                                     mAlphaToCoverageEnabled};
+        std::vector<size_t> depth = {mDepthCheck, mDepthWrite, mDepthFunc, floatBits(mDepthBiasConstant),
+                                     floatBits(mDepthBiasSlopeScale)};
+        std::vector<size_t> raster = {mCullMode, mPolygonMode, mShadeOptions};
+
+        StateIds ids;
+        {
+            OGRE_LOCK_MUTEX(msStateIdsMutex);
+            ids.programs = sProgramIds.intern(programs);
+            ids.textures = sTextureIds.intern(textures);
+            ids.blend = sBlendIds.intern(blend);
+            ids.depth = sDepthIds.intern(depth);
+            ids.raster = sRasterIds.intern(raster);
+        }
+        releaseStateIds();
+        mStateIds = ids;
+
+        /* Sort key format is 64-bit, divided as follows (high to low bits)
+           bits   purpose
+           20     GPU programs
+           20     Textures
+            8     Blend state
+            8     Depth state
+            8     Raster state
+       */
+        mSortKey = (uint64(mStateIds.programs & 0xFFFFF) << 44) | (uint64(mStateIds.textures & 0xFFFFF) << 24) |
+                   ((mStateIds.blend & 0xFF) << 16) | ((mStateIds.depth & 0xFF) << 8) | (mStateIds.raster & 0xFF);
+    }
+    //-----------------------------------------------------------------------
+    void Pass::releaseStateIds(void)
+    {
+        OGRE_LOCK_MUTEX(msStateIdsMutex);
+        sProgramIds.release(mStateIds.programs);
+        sTextureIds.release(mStateIds.textures);
+        sBlendIds.release(mStateIds.blend);
+        sDepthIds.release(mStateIds.depth);
+        sRasterIds.release(mStateIds.raster);
+        mStateIds = StateIds();
     }
     //-----------------------------------------------------------------------
     void Pass::_dirtyHash(void)
     {
+        // the state is unknown until the hash is recalculated
+        releaseStateIds();
+        ++mChangeCount;
+
         if (mQueuedForDeletion)
             return;
 
@@ -1090,6 +1248,7 @@ namespace Ogre {
         {
             OGRE_LOCK_MUTEX(msPassGraveyardMutex);
             msPassGraveyard.insert(this);
+            ++msDeletionCounter;
         }
     }
     //-----------------------------------------------------------------------
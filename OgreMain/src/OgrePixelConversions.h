@@ -77,6 +77,39 @@ template <class U> struct PixelBoxConverter
     }
 };
 
+/**
+ * Like PixelBoxConverter, but hands whole rows to the policy class, so that it
+ * can convert several pixels at once with SIMD instructions.
+ *
+ * @remarks The policy class has a static method, rowConvert, that converts
+ *    count consecutive SrcType pixels into DstType pixels.
+ */
+template <class U> struct PixelBoxRowConverter
+{
+    static const int ID = U::ID;
+    static void conversion(const Ogre::PixelBox &src, const Ogre::PixelBox &dst)
+    {
+        typename U::SrcType *srcptr = reinterpret_cast<typename U::SrcType*>(src.data)
+            + (src.left + src.top * src.rowPitch + src.front * src.slicePitch);
+        typename U::DstType *dstptr = reinterpret_cast<typename U::DstType*>(dst.data)
+            + (dst.left + dst.top * dst.rowPitch + dst.front * dst.slicePitch);
+        const size_t srcSliceSkip = src.getSliceSkip();
+        const size_t dstSliceSkip = dst.getSliceSkip();
+        const size_t k = src.right - src.left;
+        for(size_t z=src.front; z<src.back; z++)
+        {
+            for(size_t y=src.top; y<src.bottom; y++)
+            {
+                U::rowConvert(srcptr, dstptr, k);
+                srcptr += src.rowPitch;
+                dstptr += dst.rowPitch;
+            }
+            srcptr += srcSliceSkip;
+            dstptr += dstSliceSkip;
+        }
+    }
+};
+
 template <typename T, typename U, int id> struct PixelConverter {
     static const int ID = id;
     typedef T SrcType;
@@ -104,6 +137,53 @@ struct Col4f {
         r(inR), g(inG), b(inB), a(inA) { }
     float r,g,b,a;
 };
+/** Type for the PF_FLOAT16 and PF_FLOAT32 formats with the given number of channels */
+template <typename T, int channels> struct ColN {
+    T c[channels];
+};
+
+/** Converts count halfs to floats, four at a time with SSE2.
+ *
+ * @remarks Matches Ogre::Bitwise::halfToFloat bit for bit. Denormals are
+ *    renormalised with a float subtraction of normal numbers, so the
+ *    result does not depend on the denormals-are-zero mode of the CPU.
+ */
+inline void halfToFloatRow(const Ogre::uint16* src, float* dst, size_t count)
+{
+    size_t i = 0;
+#if OGRE_PIXELCONV_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i maskNoSign = _mm_set1_epi32(0x7fff);
+    const __m128i shiftedExp = _mm_set1_epi32(0x7c00 << 13);
+    const __m128i expAdjust = _mm_set1_epi32((127 - 15) << 23);
+    const __m128i infNanAdjust = _mm_set1_epi32((128 - 16) << 23);
+    const __m128i denormAdjust = _mm_set1_epi32(1 << 23);
+    const __m128 denormMagic = _mm_castsi128_ps(_mm_set1_epi32(113 << 23));
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i h = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)), zero);
+        __m128i expmant = _mm_and_si128(h, maskNoSign);
+        __m128i o = _mm_slli_epi32(expmant, 13);
+        __m128i exp = _mm_and_si128(o, shiftedExp);
+        o = _mm_add_epi32(o, expAdjust);
+
+        // inf and nan keep their mantissa, but get the largest exponent
+        __m128i isInfNan = _mm_cmpeq_epi32(exp, shiftedExp);
+        o = _mm_add_epi32(o, _mm_and_si128(isInfNan, infNanAdjust));
+
+        // zero and denormals: renormalise
+        __m128i isDenorm = _mm_cmpeq_epi32(exp, zero);
+        __m128i denorm = _mm_castps_si128(
+            _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(o, denormAdjust)), denormMagic));
+        o = _mm_or_si128(_mm_and_si128(isDenorm, denorm), _mm_andnot_si128(isDenorm, o));
+
+        __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, expmant), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(o, sign));
+    }
+#endif
+    for (; i < count; i++)
+        dst[i] = Ogre::Bitwise::halfToFloat(src[i]);
+}
 
 struct A8R8G8B8toA8B8G8R8: public PixelConverter <Ogre::uint32, Ogre::uint32, FMTCONVERTERID(Ogre::PF_A8R8G8B8, Ogre::PF_A8B8G8R8)>
 {
@@ -297,6 +377,38 @@ struct L8toB8G8R8A8: public PixelConverter <Ogre::uint8, Ogre::uint32, FMTCONVER
     }
 };
 
+struct R8toR8G8B8A8: public PixelConverter <Ogre::uint8, Ogre::uint32, FMTCONVERTERID(Ogre::PF_R8, Ogre::PF_R8G8B8A8)>
+{
+    inline static DstType pixelConvert(SrcType inp)
+    {
+        return 0x000000FF|(((unsigned int)inp)<<24);
+    }
+};
+
+struct R8G8B8A8toR8: public PixelConverter <Ogre::uint32, Ogre::uint8, FMTCONVERTERID(Ogre::PF_R8G8B8A8, Ogre::PF_R8)>
+{
+    inline static DstType pixelConvert(SrcType inp)
+    {
+        return (Ogre::uint8)((inp&0xFF000000)>>24);
+    }
+};
+
+struct L8toR8G8B8A8: public PixelConverter <Ogre::uint8, Ogre::uint32, FMTCONVERTERID(Ogre::PF_L8, Ogre::PF_R8G8B8A8)>
+{
+    inline static DstType pixelConvert(SrcType inp)
+    {
+        return 0x000000FF|(((unsigned int)inp)<<8)|(((unsigned int)inp)<<16)|(((unsigned int)inp)<<24);
+    }
+};
+
+struct R8G8B8A8toL8: public PixelConverter <Ogre::uint32, Ogre::uint8, FMTCONVERTERID(Ogre::PF_R8G8B8A8, Ogre::PF_L8)>
+{
+    inline static DstType pixelConvert(SrcType inp)
+    {
+        return (Ogre::uint8)((inp&0xFF000000)>>24);
+    }
+};
+
 struct L8toL16: public PixelConverter <Ogre::uint8, Ogre::uint16, FMTCONVERTERID(Ogre::PF_L8, Ogre::PF_L16)>
 {
     inline static DstType pixelConvert(SrcType inp)
@@ -349,6 +461,8 @@ struct R8G8B8toA8B8G8R8: public Col3btoUint32swizzler<FMTCONVERTERID(Ogre::PF_R8
 struct B8G8R8toA8B8G8R8: public Col3btoUint32swizzler<FMTCONVERTERID(Ogre::PF_B8G8R8, Ogre::PF_A8B8G8R8), 16, 8, 0, 24> { };
 struct R8G8B8toB8G8R8A8: public Col3btoUint32swizzler<FMTCONVERTERID(Ogre::PF_R8G8B8, Ogre::PF_B8G8R8A8), 8, 16, 24, 0> { };
 struct B8G8R8toB8G8R8A8: public Col3btoUint32swizzler<FMTCONVERTERID(Ogre::PF_B8G8R8, Ogre::PF_B8G8R8A8), 24, 16, 8, 0> { };
+struct R8G8B8toR8G8B8A8: public Col3btoUint32swizzler<FMTCONVERTERID(Ogre::PF_R8G8B8, Ogre::PF_R8G8B8A8), 24, 16, 8, 0> { };
+struct B8G8R8toR8G8B8A8: public Col3btoUint32swizzler<FMTCONVERTERID(Ogre::PF_B8G8R8, Ogre::PF_R8G8B8A8), 8, 16, 24, 0> { };
 
 struct A8R8G8B8toR8G8B8: public PixelConverter <Ogre::uint32, Col3b, FMTCONVERTERID(Ogre::PF_A8R8G8B8, Ogre::PF_BYTE_RGB)>
 {
@@ -427,7 +541,55 @@ struct X8B8G8R8toR8G8B8A8: public PixelConverter <Ogre::uint32, Ogre::uint32, FM
 };
 
 
+struct FLOAT32_RGBtoFLOAT32_RGBA: public PixelConverter <Col3f, Col4f, FMTCONVERTERID(Ogre::PF_FLOAT32_RGB, Ogre::PF_FLOAT32_RGBA)>
+{
+    inline static DstType pixelConvert(const SrcType &inp)
+    {
+        return Col4f(inp.r, inp.g, inp.b, 1.0f);
+    }
+};
+
+struct FLOAT32_RGBAtoFLOAT32_RGB: public PixelConverter <Col4f, Col3f, FMTCONVERTERID(Ogre::PF_FLOAT32_RGBA, Ogre::PF_FLOAT32_RGB)>
+{
+    inline static DstType pixelConvert(const SrcType &inp)
+    {
+        return Col3f(inp.r, inp.g, inp.b);
+    }
+};
+
+// half <-> float conversions between formats with the same channel layout
+template <int id, int channels> struct HalfToFloatConverter:
+    public PixelConverter <ColN<Ogre::uint16, channels>, ColN<float, channels>, id>
+{
+    inline static void rowConvert(const ColN<Ogre::uint16, channels>* src, ColN<float, channels>* dst, size_t count)
+    {
+        halfToFloatRow(src->c, dst->c, count * channels);
+    }
+};
+
+template <int id, int channels> struct FloatToHalfConverter:
+    public PixelConverter <ColN<float, channels>, ColN<Ogre::uint16, channels>, id>
+{
+    inline static ColN<Ogre::uint16, channels> pixelConvert(const ColN<float, channels> &inp)
+    {
+        ColN<Ogre::uint16, channels> ret;
+        for (int i = 0; i < channels; i++)
+            ret.c[i] = Ogre::Bitwise::floatToHalf(inp.c[i]);
+        return ret;
+    }
+};
+
+struct FLOAT16_RtoFLOAT32_R: public HalfToFloatConverter<FMTCONVERTERID(Ogre::PF_FLOAT16_R, Ogre::PF_FLOAT32_R), 1> { };
+struct FLOAT16_GRtoFLOAT32_GR: public HalfToFloatConverter<FMTCONVERTERID(Ogre::PF_FLOAT16_GR, Ogre::PF_FLOAT32_GR), 2> { };
+struct FLOAT16_RGBtoFLOAT32_RGB: public HalfToFloatConverter<FMTCONVERTERID(Ogre::PF_FLOAT16_RGB, Ogre::PF_FLOAT32_RGB), 3> { };
+struct FLOAT16_RGBAtoFLOAT32_RGBA: public HalfToFloatConverter<FMTCONVERTERID(Ogre::PF_FLOAT16_RGBA, Ogre::PF_FLOAT32_RGBA), 4> { };
+struct FLOAT32_RtoFLOAT16_R: public FloatToHalfConverter<FMTCONVERTERID(Ogre::PF_FLOAT32_R, Ogre::PF_FLOAT16_R), 1> { };
+struct FLOAT32_GRtoFLOAT16_GR: public FloatToHalfConverter<FMTCONVERTERID(Ogre::PF_FLOAT32_GR, Ogre::PF_FLOAT16_GR), 2> { };
+struct FLOAT32_RGBtoFLOAT16_RGB: public FloatToHalfConverter<FMTCONVERTERID(Ogre::PF_FLOAT32_RGB, Ogre::PF_FLOAT16_RGB), 3> { };
+struct FLOAT32_RGBAtoFLOAT16_RGBA: public FloatToHalfConverter<FMTCONVERTERID(Ogre::PF_FLOAT32_RGBA, Ogre::PF_FLOAT16_RGBA), 4> { };
+
 #define CASECONVERTER(type) case type::ID : PixelBoxConverter<type>::conversion(src, dst); return 1;
+#define CASEROWCONVERTER(type) case type::ID : PixelBoxRowConverter<type>::conversion(src, dst); return 1;
 
 inline int doOptimizedConversion(const Ogre::PixelBox &src, const Ogre::PixelBox &dst)
 {;
@@ -478,12 +640,29 @@ inline int doOptimizedConversion(const Ogre::PixelBox &src, const Ogre::PixelBox
         CASECONVERTER(X8B8G8R8toA8B8G8R8);
         CASECONVERTER(X8B8G8R8toB8G8R8A8);
         CASECONVERTER(X8B8G8R8toR8G8B8A8);
+        CASECONVERTER(R8toR8G8B8A8);
+        CASECONVERTER(R8G8B8A8toR8);
+        CASECONVERTER(L8toR8G8B8A8);
+        CASECONVERTER(R8G8B8A8toL8);
+        CASECONVERTER(R8G8B8toR8G8B8A8);
+        CASECONVERTER(B8G8R8toR8G8B8A8);
+        CASECONVERTER(FLOAT32_RGBtoFLOAT32_RGBA);
+        CASECONVERTER(FLOAT32_RGBAtoFLOAT32_RGB);
+        CASEROWCONVERTER(FLOAT16_RtoFLOAT32_R);
+        CASEROWCONVERTER(FLOAT16_GRtoFLOAT32_GR);
+        CASEROWCONVERTER(FLOAT16_RGBtoFLOAT32_RGB);
+        CASEROWCONVERTER(FLOAT16_RGBAtoFLOAT32_RGBA);
+        CASECONVERTER(FLOAT32_RtoFLOAT16_R);
+        CASECONVERTER(FLOAT32_GRtoFLOAT16_GR);
+        CASECONVERTER(FLOAT32_RGBtoFLOAT16_RGB);
+        CASECONVERTER(FLOAT32_RGBAtoFLOAT16_RGBA);
 
         default:
             return 0;
     }
 }
 #undef CASECONVERTER
+#undef CASEROWCONVERTER
 /** @} */
 /** @} */
 
@@ -28,6 +28,15 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgrePixelFormat.h"
 #include "OgrePixelFormatDescriptions.h"
+#include "OgrePlatformInformation.h"
+
+// SSE2 is part of x86-64, so no runtime check is needed there
+#if __OGRE_HAVE_SSE && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define OGRE_PIXELCONV_SSE2 1
+#include <emmintrin.h>
+#else
+#define OGRE_PIXELCONV_SSE2 0
+#endif
 
 namespace {
 #include "OgrePixelConversions.h"
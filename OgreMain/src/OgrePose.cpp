@@ -31,7 +31,7 @@ THE SOFTWARE.
 namespace Ogre {
     //---------------------------------------------------------------------
     Pose::Pose(ushort target, const String& name)
-        : mTarget(target), mName(name)
+        : mTarget(target), mName(name), mPackedDataDirty(true)
     {
     }
     //---------------------------------------------------------------------
@@ -46,7 +46,7 @@ namespace Ogre {
         }
 
         mVertexOffsetMap[index] = offset;
-        mBuffer.reset();
+        invalidateDerivedData();
     }
     //---------------------------------------------------------------------
     void Pose::addVertex(size_t index, const Vector3& offset, const Vector3& normal)
@@ -61,7 +61,7 @@ namespace Ogre {
 
         mVertexOffsetMap[index] = offset;
         mNormalsMap[index] = normal;
-        mBuffer.reset();
+        invalidateDerivedData();
     }
     //---------------------------------------------------------------------
     void Pose::removeVertex(size_t index)
@@ -70,12 +70,13 @@ namespace Ogre {
         if (i != mVertexOffsetMap.end())
         {
             mVertexOffsetMap.erase(i);
-            mBuffer.reset();
+            invalidateDerivedData();
         }
         NormalsMap::iterator j = mNormalsMap.find(index);
         if (j != mNormalsMap.end())
         {
             mNormalsMap.erase(j);
+            invalidateDerivedData();
         }
     }
     //---------------------------------------------------------------------
@@ -83,7 +84,7 @@ namespace Ogre {
     {
         mVertexOffsetMap.clear();
         mNormalsMap.clear();
-        mBuffer.reset();
+        invalidateDerivedData();
     }
     //---------------------------------------------------------------------
     Pose::ConstVertexOffsetIterator 
@@ -95,6 +96,7 @@ namespace Ogre {
     Pose::VertexOffsetIterator 
         Pose::getVertexOffsetIterator(void)
     {
+        mPackedDataDirty = true;
         return VertexOffsetIterator(mVertexOffsetMap.begin(), mVertexOffsetMap.end());
     }
     //---------------------------------------------------------------------
@@ -105,6 +107,7 @@ namespace Ogre {
     //---------------------------------------------------------------------
     Pose::NormalsIterator Pose::getNormalsIterator(void)
     {
+        mPackedDataDirty = true;
         return NormalsIterator(mNormalsMap.begin(), mNormalsMap.end());
     }
     //---------------------------------------------------------------------
@@ -178,6 +181,54 @@ namespace Ogre {
         return mBuffer;
     }
     //---------------------------------------------------------------------
+    void Pose::invalidateDerivedData()
+    {
+        mBuffer.reset();
+        mPackedDataDirty = true;
+    }
+    //---------------------------------------------------------------------
+    void Pose::updatePackedData() const
+    {
+        if (!mPackedDataDirty)
+            return;
+        mPackedDataDirty = false;
+
+        mPackedIndices.clear();
+        mPackedOffsets.clear();
+        mPackedNormals.clear();
+        mPackedIndices.reserve(mVertexOffsetMap.size());
+        mPackedOffsets.reserve(mVertexOffsetMap.size() * 3);
+        mPackedNormals.reserve(mNormalsMap.size() * 3);
+
+        for (const auto& v : mVertexOffsetMap)
+        {
+            mPackedIndices.push_back(uint32(v.first));
+            mPackedOffsets.insert(mPackedOffsets.end(), v.second.ptr(), v.second.ptr() + 3);
+        }
+        for (const auto& n : mNormalsMap)
+        {
+            mPackedNormals.insert(mPackedNormals.end(), n.second.ptr(), n.second.ptr() + 3);
+        }
+    }
+    //---------------------------------------------------------------------
+    const std::vector<uint32>& Pose::_getPackedIndices() const
+    {
+        updatePackedData();
+        return mPackedIndices;
+    }
+    //---------------------------------------------------------------------
+    const std::vector<float>& Pose::_getPackedOffsets() const
+    {
+        updatePackedData();
+        return mPackedOffsets;
+    }
+    //---------------------------------------------------------------------
+    const std::vector<float>& Pose::_getPackedNormals() const
+    {
+        updatePackedData();
+        return mPackedNormals;
+    }
+    //---------------------------------------------------------------------
     Pose* Pose::clone(void) const
     {
         Pose* newPose = OGRE_NEW Pose(mTarget, mName);
@@ -40,6 +40,7 @@ namespace Ogre {
         , mSplitNoShadowPasses(false)
         , mShadowCastersCannotBeReceivers(false)
         , mRenderableListener(0)
+        , mVisibleObjects(0)
     {
         // Create the 'main' queue up-front since we'll always need that
         mGroups[RENDER_QUEUE_MAIN].reset(new RenderQueueGroup(
@@ -238,6 +239,9 @@ namespace Ogre {
         mo->_notifyCurrentCamera(cam);
         if (mo->isVisible())
         {
+            if (mVisibleObjects)
+                mVisibleObjects->push_back(mo);
+
             bool receiveShadows = getQueueGroup(mo->getRenderQueueGroup())->getShadowsEnabled()
                 && mo->getReceivesShadows();
 
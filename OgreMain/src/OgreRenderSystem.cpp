@@ -84,6 +84,9 @@ namespace Ogre {
         , mTexProjRelativeOrigin(Vector3::ZERO)
     {
         mEventNames.push_back("RenderSystemCapabilitiesCreated");
+
+        mStateChangeStats.issued = mStateChangeStats.filtered = 0;
+        _invalidateStateCache();
     }
 
     void RenderSystem::initFixedFunctionParams()
@@ -254,6 +257,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void RenderSystem::_updateAllRenderTargets(bool swapBuffers)
     {
+        mStateChangeStats.issued = mStateChangeStats.filtered = 0;
+
         // Update all in order of priority
         // This ensures render-to-texture targets get updated before render windows
         RenderTargetPriorityMap::iterator itarg, itargend;
@@ -459,7 +464,35 @@ namespace Ogre {
         // Set texture coordinate set
         _setTextureCoordSet(texUnit, tl.getTextureCoordSet());
 
-        _setSampler(texUnit, *tl.getSampler());
+        const Sampler& sampler = *tl.getSampler();
+        SamplerStateBlock samplerState;
+        samplerState.texture = tex.get();
+        samplerState.textureStateCount = tex->getStateCount();
+        samplerState.filtering[FT_MIN] = sampler.getFiltering(FT_MIN);
+        samplerState.filtering[FT_MAG] = sampler.getFiltering(FT_MAG);
+        samplerState.filtering[FT_MIP] = sampler.getFiltering(FT_MIP);
+        samplerState.addressMode = sampler.getAddressingMode();
+        samplerState.anisotropy = sampler.getAnisotropy();
+        samplerState.mipmapBias = sampler.getMipmapBias();
+        samplerState.compareEnabled = sampler.getCompareEnabled();
+        samplerState.compareFunction = sampler.getCompareFunction();
+        samplerState.borderColour = sampler.getBorderColour();
+
+        if (texUnit >= OGRE_MAX_TEXTURE_LAYERS)
+        {
+            _setSampler(texUnit, *tl.getSampler());
+        }
+        else if (!isRedundantStateChange(mSamplerStateCache[texUnit], samplerState))
+        {
+            // the texture may be bound to other units, which now have to set their sampler again
+            for (size_t i = 0; i < OGRE_MAX_TEXTURE_LAYERS; ++i)
+            {
+                if (i != texUnit && mSamplerStateCache[i].valid && mSamplerStateCache[i].state.texture == tex.get())
+                    mSamplerStateCache[i].valid = false;
+            }
+
+            _setSampler(texUnit, *tl.getSampler());
+        }
 
         // Set blend modes
         // Note, colour before alpha is important
@@ -544,6 +577,8 @@ namespace Ogre {
         for (size_t i = texUnit; i < disableTo; ++i)
         {
             _disableTextureUnit(i);
+            if (i < OGRE_MAX_TEXTURE_LAYERS)
+                mSamplerStateCache[i].valid = false;
         }
     }
     //-----------------------------------------------------------------------
@@ -712,6 +747,80 @@ namespace Ogre {
         return static_cast< unsigned int >( mVertexCount );
     }
     //-----------------------------------------------------------------------
+    bool RenderSystem::BlendStateBlock::operator==(const BlendStateBlock& rhs) const
+    {
+        return blend.writeR == rhs.blend.writeR && blend.writeG == rhs.blend.writeG &&
+               blend.writeB == rhs.blend.writeB && blend.writeA == rhs.blend.writeA &&
+               blend.sourceFactor == rhs.blend.sourceFactor && blend.destFactor == rhs.blend.destFactor &&
+               blend.sourceFactorAlpha == rhs.blend.sourceFactorAlpha &&
+               blend.destFactorAlpha == rhs.blend.destFactorAlpha && blend.operation == rhs.blend.operation &&
+               blend.alphaOperation == rhs.blend.alphaOperation && alphaRejectFunc == rhs.alphaRejectFunc &&
+               alphaRejectValue == rhs.alphaRejectValue && alphaToCoverage == rhs.alphaToCoverage;
+    }
+    //-----------------------------------------------------------------------
+    bool RenderSystem::DepthStateBlock::operator==(const DepthStateBlock& rhs) const
+    {
+        return depthTest == rhs.depthTest && depthWrite == rhs.depthWrite && depthFunction == rhs.depthFunction &&
+               constantBias == rhs.constantBias && slopeScaleBias == rhs.slopeScaleBias;
+    }
+    //-----------------------------------------------------------------------
+    bool RenderSystem::RasterStateBlock::operator==(const RasterStateBlock& rhs) const
+    {
+        return cullMode == rhs.cullMode && polygonMode == rhs.polygonMode && shading == rhs.shading;
+    }
+    //-----------------------------------------------------------------------
+    bool RenderSystem::SamplerStateBlock::operator==(const SamplerStateBlock& rhs) const
+    {
+        return texture == rhs.texture && textureStateCount == rhs.textureStateCount &&
+               std::equal(filtering, filtering + 3, rhs.filtering) && addressMode.u == rhs.addressMode.u &&
+               addressMode.v == rhs.addressMode.v && addressMode.w == rhs.addressMode.w &&
+               anisotropy == rhs.anisotropy && mipmapBias == rhs.mipmapBias &&
+               compareEnabled == rhs.compareEnabled && compareFunction == rhs.compareFunction &&
+               borderColour == rhs.borderColour;
+    }
+    //-----------------------------------------------------------------------
+    void RenderSystem::_applyBlendState(const ColourBlendState& state, CompareFunction alphaRejectFunc,
+                                        unsigned char alphaRejectValue, bool alphaToCoverage)
+    {
+        BlendStateBlock block = {state, alphaRejectFunc, alphaRejectValue, alphaToCoverage};
+        if (isRedundantStateChange(mBlendStateCache, block))
+            return;
+
+        setColourBlendState(state);
+        _setAlphaRejectSettings(alphaRejectFunc, alphaRejectValue, alphaToCoverage);
+    }
+    //-----------------------------------------------------------------------
+    void RenderSystem::_applyDepthState(bool depthTest, bool depthWrite, CompareFunction depthFunction,
+                                        float constantBias, float slopeScaleBias)
+    {
+        DepthStateBlock block = {depthTest, depthWrite, depthFunction, constantBias, slopeScaleBias};
+        if (isRedundantStateChange(mDepthStateCache, block))
+            return;
+
+        _setDepthBufferParams(depthTest, depthWrite, depthFunction);
+        _setDepthBias(constantBias, slopeScaleBias);
+    }
+    //-----------------------------------------------------------------------
+    void RenderSystem::_applyRasterState(CullingMode cullMode, PolygonMode polygonMode, ShadeOptions shading)
+    {
+        RasterStateBlock block = {cullMode, polygonMode, shading};
+        if (isRedundantStateChange(mRasterStateCache, block))
+            return;
+
+        _setCullingMode(cullMode);
+        _setPolygonMode(polygonMode);
+        setShadingType(shading);
+    }
+    //-----------------------------------------------------------------------
+    void RenderSystem::_invalidateStateCache(void)
+    {
+        mBlendStateCache.valid = false;
+        mDepthStateCache.valid = false;
+        mRasterStateCache.valid = false;
+        for (auto& sampler : mSamplerStateCache)
+            sampler.valid = false;
+    }
+    //-----------------------------------------------------------------------
     void RenderSystem::_render(const RenderOperation& op)
     {
         // Update stats
@@ -802,6 +911,7 @@ namespace Ogre {
         {
             _setDepthBias(mDerivedDepthBiasBase + mDerivedDepthBiasMultiplier * mCurrentPassIterationNum,
                           mDerivedDepthBiasSlopeScale);
+            mDepthStateCache.valid = false;
         }
 
         --mCurrentPassIterationCount;
@@ -69,6 +69,11 @@ namespace Ogre {
         NameValuePairList* loadParams;
         ResourceBackgroundQueue::Listener* listener;
         BackgroundProcessResult result;
+        /// Set when preparing a resource of a group operation
+        ResourcePtr resource;
+        BackgroundProcessTicket groupTicket;
+
+        ResourceRequest() : groupTicket(0) {}
     };
     /// Struct that holds details of queued notifications
     struct ResourceResponse
@@ -79,9 +84,12 @@ namespace Ogre {
 
         ResourcePtr resource;
         ResourceRequest request;
+        /// Contents of the group for group prepare / load requests
+        std::vector<std::vector<ResourcePtr> > stages;
     };
     //------------------------------------------------------------------------
-    ResourceBackgroundQueue::ResourceBackgroundQueue() : mWorkQueueChannel(0)
+    ResourceBackgroundQueue::ResourceBackgroundQueue()
+        : mWorkQueueChannel(0), mMaxConcurrentPrepares(OGRE_THREAD_HARDWARE_CONCURRENCY)
     {
     }
     //------------------------------------------------------------------------
@@ -104,6 +112,10 @@ namespace Ogre {
         wq->abortRequestsByChannel(mWorkQueueChannel);
         wq->removeRequestHandler(mWorkQueueChannel, this);
         wq->removeResponseHandler(mWorkQueueChannel, this);
+
+        for (GroupOperationMap::iterator i = mGroupOperations.begin(); i != mGroupOperations.end(); ++i)
+            mOutstandingRequestSet.erase(i->first);
+        mGroupOperations.clear();
     }
     //------------------------------------------------------------------------
     BackgroundProcessTicket ResourceBackgroundQueue::initialiseResourceGroup(
@@ -302,6 +314,19 @@ namespace Ogre {
     {
         WorkQueue* queue = Root::getSingleton().getWorkQueue();
 
+        GroupOperationMap::iterator i = mGroupOperations.find(ticket);
+        if (i != mGroupOperations.end())
+        {
+            // the group request itself is done, abort its resources instead
+            const std::set<WorkQueue::RequestID>& inFlight = i->second.inFlight;
+            for (std::set<WorkQueue::RequestID>::const_iterator r = inFlight.begin(); r != inFlight.end(); ++r)
+                queue->abortRequest(*r);
+
+            mGroupOperations.erase(i);
+            mOutstandingRequestSet.erase(ticket);
+            return;
+        }
+
         queue->abortRequest( ticket );
     }
     //------------------------------------------------------------------------
@@ -344,6 +369,7 @@ namespace Ogre {
 
         ResourceManager* rm = 0;
         ResourcePtr resource;
+        std::vector<std::vector<ResourcePtr> > stages;
         try
         {
 
@@ -357,23 +383,22 @@ namespace Ogre {
                 ResourceGroupManager::getSingleton().initialiseAllResourceGroups();
                 break;
             case RT_PREPARE_GROUP:
-                ResourceGroupManager::getSingleton().prepareResourceGroup(
-                    resreq.groupName);
-                break;
             case RT_LOAD_GROUP:
-    #if OGRE_THREAD_SUPPORT == 2
-                ResourceGroupManager::getSingleton().prepareResourceGroup(
-                    resreq.groupName);
-    #else
-                ResourceGroupManager::getSingleton().loadResourceGroup(
-                    resreq.groupName);
-    #endif
+                // the resources are processed by separate requests, see startGroupOperation
+                ResourceGroupManager::getSingleton()._getResourceGroupLoadStages(
+                    resreq.groupName, stages);
                 break;
             case RT_UNLOAD_GROUP:
                 ResourceGroupManager::getSingleton().unloadResourceGroup(
                     resreq.groupName);
                 break;
             case RT_PREPARE_RESOURCE:
+                if (resreq.resource)
+                {
+                    resource = resreq.resource;
+                    resource->prepare(true);
+                    break;
+                }
                 rm = ResourceGroupManager::getSingleton()._getResourceManager(
                     resreq.resourceType);
                 resource = rm->prepare(resreq.resourceName, resreq.groupName, resreq.isManual, 
@@ -424,6 +449,7 @@ namespace Ogre {
         }
         resreq.result.error = false;
         ResourceResponse resresp(resource, resreq);
+        resresp.stages.swap(stages);
         return OGRE_NEW WorkQueue::Response(req, true, resresp);
 
     }
@@ -443,9 +469,21 @@ namespace Ogre {
 
         ResourceResponse resresp = any_cast<ResourceResponse>(res->getData());
 
+        if (resresp.request.groupTicket)
+        {
+            handleGroupResponse(res, resresp);
+            return;
+        }
+
         // Complete full loading in main thread if semithreading
         const ResourceRequest& req = resresp.request;
 
+        if (res->succeeded() && (req.type == RT_PREPARE_GROUP || req.type == RT_LOAD_GROUP))
+        {
+            startGroupOperation(res->getRequest()->getID(), resresp);
+            return;
+        }
+
         if (res->succeeded())
         {
 #if OGRE_THREAD_SUPPORT == 2
@@ -456,10 +494,6 @@ namespace Ogre {
                     ._getResourceManager(req.resourceType);
                 rm->load(req.resourceName, req.groupName, req.isManual, req.loader, req.loadParams, true);
             } 
-            else if (req.type == RT_LOAD_GROUP) 
-            {
-                ResourceGroupManager::getSingleton().loadResourceGroup(req.groupName);
-            }
 #endif
             mOutstandingRequestSet.erase(res->getRequest()->getID());
 
@@ -482,6 +516,166 @@ namespace Ogre {
             req.listener->operationCompleted(res->getRequest()->getID(), req.result);
     }
     //------------------------------------------------------------------------
+    void ResourceBackgroundQueue::startGroupOperation(BackgroundProcessTicket ticket,
+                                                      ResourceResponse& resresp)
+    {
+        const ResourceRequest& req = resresp.request;
+
+        GroupOperation& op = mGroupOperations[ticket];
+        op.load = req.type == RT_LOAD_GROUP;
+        op.groupName = req.groupName;
+        op.listener = req.listener;
+        op.stages.swap(resresp.stages);
+        op.stage = 0;
+        op.next = 0;
+        op.completed = 0;
+        op.total = 0;
+        for (size_t i = 0; i < op.stages.size(); ++i)
+            op.total += op.stages[i].size();
+
+        ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+        if (op.load)
+        {
+            // like loadResourceGroup, the custom stages are announced for the listeners
+            ResourceGroupManager::ResourceGroup* grp = rgm.getResourceGroup(op.groupName);
+            op.eventCount = op.total + (grp ? grp->customStageCount : 0);
+            rgm.fireResourceGroupLoadStarted(op.groupName, op.eventCount);
+        }
+        else
+        {
+            op.eventCount = op.total;
+            rgm.fireResourceGroupPrepareStarted(op.groupName, op.eventCount);
+        }
+
+        updateGroupOperation(ticket);
+    }
+    //------------------------------------------------------------------------
+    void ResourceBackgroundQueue::updateGroupOperation(BackgroundProcessTicket ticket)
+    {
+        GroupOperationMap::iterator i = mGroupOperations.find(ticket);
+        if (i == mGroupOperations.end())
+            return; // aborted
+
+        GroupOperation& op = i->second;
+        WorkQueue* queue = Root::getSingleton().getWorkQueue();
+
+        // after a failure, only wait for the resources in flight
+        while (op.stage < op.stages.size() && !op.result.error)
+        {
+            const std::vector<ResourcePtr>& stage = op.stages[op.stage];
+            while (op.next < stage.size() &&
+                   (!mMaxConcurrentPrepares || op.inFlight.size() < mMaxConcurrentPrepares))
+            {
+                ResourceRequest req;
+                req.type = RT_PREPARE_RESOURCE;
+                req.groupName = op.groupName;
+                req.loadParams = 0;
+                req.listener = 0;
+                req.resource = stage[op.next++];
+                req.groupTicket = ticket;
+
+                WorkQueue::RequestID id = queue->addRequest(mWorkQueueChannel, (uint16)req.type, Any(req));
+                if (id)
+                {
+                    op.inFlight.insert(id);
+                }
+                else
+                {
+                    op.result.error = true;
+                    op.result.message = "WorkQueue is not accepting requests";
+                    ++op.completed;
+                }
+            }
+
+            // finish the current loading order before starting the next one
+            if (op.next < stage.size() || !op.inFlight.empty())
+                return;
+
+            ++op.stage;
+            op.next = 0;
+        }
+
+        if (!op.inFlight.empty())
+            return;
+
+        if (!op.result.error)
+        {
+            ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+            if (op.load)
+            {
+                rgm.fireResourceGroupLoadEnded(op.groupName);
+                if (ResourceGroupManager::ResourceGroup* grp = rgm.getResourceGroup(op.groupName))
+                {
+                    OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex
+                    grp->groupStatus = ResourceGroupManager::ResourceGroup::LOADED;
+                }
+            }
+            else
+            {
+                rgm.fireResourceGroupPrepareEnded(op.groupName);
+            }
+        }
+
+        Listener* listener = op.listener;
+        BackgroundProcessResult result = op.result;
+        mGroupOperations.erase(i);
+        mOutstandingRequestSet.erase(ticket);
+
+        if (listener)
+            listener->operationCompleted(ticket, result);
+    }
+    //------------------------------------------------------------------------
+    void ResourceBackgroundQueue::handleGroupResponse(const WorkQueue::Response* res,
+                                                      ResourceResponse& resresp)
+    {
+        BackgroundProcessTicket ticket = resresp.request.groupTicket;
+        GroupOperationMap::iterator i = mGroupOperations.find(ticket);
+        if (i == mGroupOperations.end())
+            return; // aborted
+
+        GroupOperation& op = i->second;
+        op.inFlight.erase(res->getRequest()->getID());
+
+        const ResourcePtr& resource = resresp.request.resource;
+        if (!res->succeeded())
+        {
+            op.result.error = true;
+            op.result.message = resresp.request.result.message;
+        }
+        else if (!op.result.error)
+        {
+            ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+            if (op.load)
+            {
+                // finalise in the main thread, bounded by the response time limit
+                rgm.fireResourceLoadStarted(resource);
+                try
+                {
+                    resource->load(true);
+                    resource->_fireLoadingComplete(true);
+                }
+                catch (Exception& e)
+                {
+                    op.result.error = true;
+                    op.result.message = e.getFullDescription();
+                }
+                rgm.fireResourceLoadEnded();
+            }
+            else
+            {
+                rgm.fireResourcePrepareStarted(resource);
+                rgm.fireResourcePrepareEnded();
+                resource->_firePreparingComplete(true);
+            }
+        }
+
+        ++op.completed;
+        if (op.listener)
+            op.listener->operationProgress(ticket, op.completed, op.total);
+
+        updateGroupOperation(ticket);
+    }
+    //------------------------------------------------------------------------
 
 }
 
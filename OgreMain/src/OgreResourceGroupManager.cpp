@@ -27,6 +27,7 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 #include "OgreScriptLoader.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
 
@@ -454,6 +455,27 @@ namespace Ogre {
         return (grp->groupStatus == ResourceGroup::LOADED);
     }
     //-----------------------------------------------------------------------
+    void ResourceGroupManager::_getResourceGroupLoadStages(
+        const String& name, std::vector<std::vector<ResourcePtr> >& stages) const
+    {
+        ResourceGroup* grp = getResourceGroup(name);
+        if (!grp)
+        {
+            OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND,
+                "Cannot find a group named " + name,
+                "ResourceGroupManager::_getResourceGroupLoadStages");
+        }
+
+        OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex
+        stages.clear();
+        ResourceGroup::LoadResourceOrderMap::const_iterator oi;
+        for (oi = grp->loadResourceOrderMap.begin(); oi != grp->loadResourceOrderMap.end(); ++oi)
+        {
+            if (!oi->second.empty())
+                stages.push_back(std::vector<ResourcePtr>(oi->second.begin(), oi->second.end()));
+        }
+    }
+    //-----------------------------------------------------------------------
     bool ResourceGroupManager::resourceGroupExists(const String& name) const
     {
         return getResourceGroup(name) ? true : false;
@@ -942,42 +964,108 @@ namespace Ogre {
         // Fire scripting event
         fireResourceGroupScriptingStarted(grp->name, scriptCount);
 
+        WorkQueue* workQueue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL;
+
         // Iterate over scripts and parse
         // Note we respect original ordering
         for (ScriptLoaderFileList::iterator slfli = scriptLoaderFileList.begin();
             slfli != scriptLoaderFileList.end(); ++slfli)
         {
             ScriptLoader* su = slfli->first;
-            // Iterate over each item in the list
-            for (FileInfoList::iterator fii = slfli->second.begin(); fii != slfli->second.end(); ++fii)
+            FileInfoList& files = slfli->second;
+
+            // Without a loading listener, which may replace the streams as they are opened, the
+            // thread safe part of parsing is spread over the worker threads, a few scripts per
+            // thread at a time. Each script is read right before it is prepared.
+            size_t batchSize = 1;
+            if (workQueue && !mLoadingListener)
+                batchSize = std::max<size_t>(OGRE_THREAD_HARDWARE_CONCURRENCY, 1) * 2;
+
+            for (size_t first = 0; first < files.size(); first += batchSize)
             {
-                bool skipScript = false;
-                fireScriptStarted(fii->filename, skipScript);
-                if(skipScript)
+                size_t count = std::min(batchSize, files.size() - first);
+                std::vector<DataStreamPtr> streams(count);
+                std::vector<Any> prepared(count);
+                if (count > 1)
                 {
-                    LogManager::getSingleton().logMessage(
-                        "Skipping script " + fii->filename);
+                    // other archives may share a handle between their streams, so are read here
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        const FileInfo& fi = files[first + i];
+                        if (fi.archive->isThreadSafe())
+                            continue;
+                        try
+                        {
+                            if (DataStreamPtr stream = fi.archive->open(fi.filename))
+                                streams[i].reset(OGRE_NEW MemoryDataStream(stream->getName(), stream));
+                        }
+                        catch (std::exception&)
+                        {
+                            // opened again below, so the error is reported in order
+                        }
+                    }
+
+                    const String& groupName = grp->name;
+                    workQueue->parallelFor(count, [&](size_t i)
+                    {
+                        const FileInfo& fi = files[first + i];
+                        try
+                        {
+                            if (fi.archive->isThreadSafe())
+                            {
+                                DataStreamPtr stream = fi.archive->open(fi.filename);
+                                if (stream)
+                                    streams[i].reset(OGRE_NEW MemoryDataStream(stream->getName(), stream));
+                            }
+                            if (!streams[i])
+                                return;
+                            prepared[i] = su->prepareScript(streams[i], groupName);
+                        }
+                        catch (std::exception&)
+                        {
+                            // parsed again below, so the error is reported in order
+                            prepared[i] = Any();
+                        }
+                        if (streams[i])
+                            streams[i]->seek(0);
+                    });
                 }
-                else
+
+                for (size_t i = 0; i < count; ++i)
                 {
-                    LogManager::getSingleton().logMessage(
-                        "Parsing script " + fii->filename);
-                    DataStreamPtr stream = fii->archive->open(fii->filename);
-                    if (stream)
+                    const FileInfo& fi = files[first + i];
+                    bool skipScript = false;
+                    fireScriptStarted(fi.filename, skipScript);
+                    if(skipScript)
                     {
-                        if (mLoadingListener)
-                            mLoadingListener->resourceStreamOpened(fii->filename, grp->name, 0, stream);
-
-                        if(fii->archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024)
+                        LogManager::getSingleton().logMessage(
+                            "Skipping script " + fi.filename);
+                    }
+                    else
+                    {
+                        LogManager::getSingleton().logMessage(
+                            "Parsing script " + fi.filename);
+                        DataStreamPtr stream = streams[i];
+                        if (!stream)
                         {
-                            DataStreamPtr cachedCopy(OGRE_NEW MemoryDataStream(stream->getName(), stream));
-                            su->parseScript(cachedCopy, grp->name);
+                            stream = fi.archive->open(fi.filename);
+                            if (stream)
+                            {
+                                if (mLoadingListener)
+                                    mLoadingListener->resourceStreamOpened(fi.filename, grp->name, 0, stream);
+
+                                if(fi.archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024)
+                                    stream.reset(OGRE_NEW MemoryDataStream(stream->getName(), stream));
+                            }
                         }
-                        else
-                            su->parseScript(stream, grp->name);
+                        if (stream)
+                            su->parsePreparedScript(stream, grp->name, prepared[i]);
                     }
+                    // free the memory as we go
+                    streams[i].reset();
+                    prepared[i] = Any();
+                    fireScriptEnded(fi.filename, skipScript);
                 }
-                fireScriptEnded(fii->filename, skipScript);
             }
         }
 
@@ -758,6 +758,10 @@ namespace Ogre {
         // Tell the queue to process responses
         mWorkQueue->processResponses();
 
+        // Upload the texture mipmaps that were decoded in the background
+        if (TextureManager::getSingletonPtr())
+            TextureManager::getSingleton()._updateStreaming();
+
         OgreProfileEndGroup("Frame", OGREPROF_GENERAL);
 
         return ret;
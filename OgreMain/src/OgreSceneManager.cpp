@@ -52,6 +52,63 @@ THE SOFTWARE.
 #include <cstdio>
 
 namespace Ogre {
+//-----------------------------------------------------------------------
+/** Stands in for the first renderable of a run, so the run is drawn as instances of it
+
+    The world matrices of the instances are passed in the vertex stream, so the world
+    matrix seen by the auto constants is identity.
+*/
+class SceneManager::AutoInstanceBatch : public Renderable
+{
+    Renderable* mBase;
+    uint32 mCount;
+    Affine3 mBaseWorldTransform;
+public:
+    HardwareVertexBufferSharedPtr mTransforms;
+    std::unique_ptr<VertexBufferRing> mTransformRing;
+    VertexDeclaration* mDeclaration;
+
+    AutoInstanceBatch() : mBase(NULL), mCount(0), mDeclaration(NULL) {}
+    ~AutoInstanceBatch()
+    {
+        auto hbm = HardwareBufferManager::getSingletonPtr();
+        if (mDeclaration && hbm)
+            hbm->destroyVertexDeclaration(mDeclaration);
+    }
+
+    void reset(Renderable* base, uint32 count)
+    {
+        mBase = base;
+        mCount = count;
+
+        Matrix4 xform;
+        base->getWorldTransforms(&xform);
+        mBaseWorldTransform = Affine3(xform);
+        mPolygonModeOverrideable = base->getPolygonModeOverrideable();
+    }
+
+    /// The world transform of the first renderable, representative for all of them
+    const Affine3& getBaseWorldTransform() const { return mBaseWorldTransform; }
+
+    const MaterialPtr& getMaterial(void) const override { return mBase->getMaterial(); }
+    Technique* getTechnique(void) const override { return mBase->getTechnique(); }
+    void getRenderOperation(RenderOperation& op) override
+    {
+        mBase->getRenderOperation(op);
+        op.numberOfInstances = mCount;
+    }
+    bool preRender(SceneManager* sm, RenderSystem* rsys) override { return mBase->preRender(sm, rsys); }
+    void postRender(SceneManager* sm, RenderSystem* rsys) override { mBase->postRender(sm, rsys); }
+    void getWorldTransforms(Matrix4* xform) const override { *xform = Matrix4::IDENTITY; }
+    Real getSquaredViewDepth(const Camera* cam) const override { return mBase->getSquaredViewDepth(cam); }
+    const LightList& getLights(void) const override { return mBase->getLights(); }
+    bool getCastsShadows(void) const override { return mBase->getCastsShadows(); }
+    void _updateCustomGpuParameter(const GpuProgramParameters::AutoConstantEntry& constantEntry,
+                                   GpuProgramParameters* params) const override
+    {
+        mBase->_updateCustomGpuParameter(constantEntry, params);
+    }
+};
 static const String INVOCATION_SHADOWS = "SHADOWS";
 //-----------------------------------------------------------------------
 SceneManager::SceneManager(const String& name) :
@@ -86,6 +143,7 @@ mVisibilityMask(0xFFFFFFFF),
 mFindVisibleObjects(true),
 mCameraRelativeRendering(false),
 mLastLightHash(0),
+mLastProgramsId(0),
 mGpuParamsDirty((uint16)GPV_ALL)
 {
     Root *root = Root::getSingletonPtr();
@@ -103,11 +161,22 @@ mGpuParamsDirty((uint16)GPV_ALL)
 
     // create the auto param data source instance
     mAutoParamDataSource.reset(createAutoParamDataSource());
+
+    mAutoInstanceBatch.reset(new AutoInstanceBatch());
 }
 //-----------------------------------------------------------------------
 SceneManager::~SceneManager()
 {
     fireSceneManagerDestroyed();
+
+    // recordings may outlive the scene they were recorded from
+    for (RenderCommandList* recording : mRenderRecordings)
+    {
+        recording->sceneManager = NULL;
+        recording->valid = false;
+    }
+    mRenderRecordings.clear();
+
     clearScene();
     destroyAllCameras();
 
@@ -844,86 +913,20 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
     mAutoParamDataSource->setCurrentPass(pass);
 
     GpuProgram* vprog = pass->hasVertexProgram() ? pass->getVertexProgram().get() : 0;
-    GpuProgram* fprog = pass->hasFragmentProgram() ? pass->getFragmentProgram().get() : 0;
 
     bool passSurfaceAndLightParams = !vprog || vprog->getPassSurfaceAndLightStates();
 
-    if (vprog)
-    {
-        bindGpuProgram(vprog->_getBindingDelegate());
-    }
-    else if (!mDestRenderSystem->getCapabilities()->hasCapability(RSC_FIXED_FUNCTION))
-    {
-        OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
-                    "RenderSystem does not support FixedFunction, "
-                    "but technique of '" +
-                        pass->getParent()->getParent()->getName() +
-                        "' has no Vertex Shader. Use the RTSS or write custom shaders.",
-                    "SceneManager::_setPass");
-    }
-    else
-    {
-        // Unbind program?
-        if (mDestRenderSystem->isGpuProgramBound(GPT_VERTEX_PROGRAM))
-        {
-            mDestRenderSystem->unbindGpuProgram(GPT_VERTEX_PROGRAM);
-        }
-        // Set fixed-function vertex parameters
-    }
-
-    if (pass->hasGeometryProgram())
-    {
-        bindGpuProgram(pass->getGeometryProgram()->_getBindingDelegate());
-        // bind parameters later
-    }
-    else
-    {
-        // Unbind program?
-        if (mDestRenderSystem->isGpuProgramBound(GPT_GEOMETRY_PROGRAM))
-        {
-            mDestRenderSystem->unbindGpuProgram(GPT_GEOMETRY_PROGRAM);
-        }
-    }
-    if (pass->hasTessellationHullProgram())
-    {
-        bindGpuProgram(pass->getTessellationHullProgram()->_getBindingDelegate());
-        // bind parameters later
-    }
-    else
-    {
-        // Unbind program?
-        if (mDestRenderSystem->isGpuProgramBound(GPT_HULL_PROGRAM))
-        {
-            mDestRenderSystem->unbindGpuProgram(GPT_HULL_PROGRAM);
-        }
-    }
-
-    if (pass->hasTessellationDomainProgram())
-    {
-        bindGpuProgram(pass->getTessellationDomainProgram()->_getBindingDelegate());
-        // bind parameters later
-    }
-    else
-    {
-        // Unbind program?
-        if (mDestRenderSystem->isGpuProgramBound(GPT_DOMAIN_PROGRAM))
-        {
-            mDestRenderSystem->unbindGpuProgram(GPT_DOMAIN_PROGRAM);
-        }
-    }
-
-    if (pass->hasComputeProgram())
+    const Pass::StateIds& stateIds = pass->getStateIds();
+    if (stateIds.programs && stateIds.programs == mLastProgramsId)
     {
-        bindGpuProgram(pass->getComputeProgram()->_getBindingDelegate());
-        // bind parameters later
+        // same programs as before, but the parameters of this pass still need binding
+        mLastLightHash = 1;
+        mGpuParamsDirty = (uint16)GPV_ALL;
     }
     else
     {
-        // Unbind program?
-        if (mDestRenderSystem->isGpuProgramBound(GPT_COMPUTE_PROGRAM))
-        {
-            mDestRenderSystem->unbindGpuProgram(GPT_COMPUTE_PROGRAM);
-        }
+        bindPassGpuPrograms(pass);
+        mLastProgramsId = stateIds.programs;
     }
 
     if (passSurfaceAndLightParams)
@@ -932,31 +935,6 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
         mDestRenderSystem->setLightingEnabled(pass->getLightingEnabled());
     }
 
-    // Using a fragment program?
-    if (fprog)
-    {
-        bindGpuProgram(fprog->_getBindingDelegate());
-    }
-    else if (!mDestRenderSystem->getCapabilities()->hasCapability(RSC_FIXED_FUNCTION) &&
-             !pass->hasGeometryProgram())
-    {
-        OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
-                    "RenderSystem does not support FixedFunction, "
-                    "but technique of '" +
-                        pass->getParent()->getParent()->getName() +
-                        "' has no Fragment Shader. Use the RTSS or write custom shaders.",
-                    "SceneManager::_setPass");
-    }
-    else
-    {
-        // Unbind program?
-        if (mDestRenderSystem->isGpuProgramBound(GPT_FRAGMENT_PROGRAM))
-        {
-            mDestRenderSystem->unbindGpuProgram(GPT_FRAGMENT_PROGRAM);
-        }
-        // Set fixed-function fragment settings
-    }
-
     // fog params can either be from scene or from material
     const auto& newFogColour = pass->getFogOverride() ? pass->getFogColour() : mFogColour;
     FogMode newFogMode;
@@ -987,8 +965,9 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
         mFixedFunctionParams = mDestRenderSystem->getFixedFunctionParams(pass->getVertexColourTracking(), newFogMode);
     }
 
-    // Set scene blending
-    mDestRenderSystem->setColourBlendState(pass->getBlendState());
+    // Set scene blending and alpha rejection
+    mDestRenderSystem->_applyBlendState(pass->getBlendState(), pass->getAlphaRejectFunction(),
+                                        pass->getAlphaRejectValue(), pass->isAlphaToCoverageEnabled());
 
     // Line width
     if (mDestRenderSystem->getCapabilities()->hasCapability(RSC_WIDE_LINES))
@@ -1068,13 +1047,9 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 
     // Set up non-texture related material settings
     // Depth buffer settings
-    mDestRenderSystem->_setDepthBufferParams(pass->getDepthCheckEnabled(), pass->getDepthWriteEnabled(),
-                                             pass->getDepthFunction());
-    mDestRenderSystem->_setDepthBias(pass->getDepthBiasConstant(), pass->getDepthBiasSlopeScale());
-    // Alpha-reject settings
-    mDestRenderSystem->_setAlphaRejectSettings(pass->getAlphaRejectFunction(),
-                                               pass->getAlphaRejectValue(),
-                                               pass->isAlphaToCoverageEnabled());
+    mDestRenderSystem->_applyDepthState(pass->getDepthCheckEnabled(), pass->getDepthWriteEnabled(),
+                                        pass->getDepthFunction(), pass->getDepthBiasConstant(),
+                                        pass->getDepthBiasSlopeScale());
 
     // Culling mode
     if (isShadowTechniqueTextureBased() && mIlluminationStage == IRS_RENDER_TO_TEXTURE &&
@@ -1087,9 +1062,7 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
     {
         mPassCullingMode = pass->getCullingMode();
     }
-    mDestRenderSystem->_setCullingMode(mPassCullingMode);
-    mDestRenderSystem->setShadingType(pass->getShadingMode());
-    mDestRenderSystem->_setPolygonMode(pass->getPolygonMode());
+    mDestRenderSystem->_applyRasterState(mPassCullingMode, pass->getPolygonMode(), pass->getShadingMode());
 
     mAutoParamDataSource->setPassNumber( pass->getIndex() );
     // mark global params as dirty
@@ -1098,6 +1071,115 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
     return pass;
 }
 //-----------------------------------------------------------------------
+void SceneManager::bindPassGpuPrograms(const Pass* pass)
+{
+    GpuProgram* vprog = pass->hasVertexProgram() ? pass->getVertexProgram().get() : 0;
+    GpuProgram* fprog = pass->hasFragmentProgram() ? pass->getFragmentProgram().get() : 0;
+
+    if (vprog)
+    {
+        bindGpuProgram(vprog->_getBindingDelegate());
+    }
+    else if (!mDestRenderSystem->getCapabilities()->hasCapability(RSC_FIXED_FUNCTION))
+    {
+        OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
+                    "RenderSystem does not support FixedFunction, "
+                    "but technique of '" +
+                        pass->getParent()->getParent()->getName() +
+                        "' has no Vertex Shader. Use the RTSS or write custom shaders.",
+                    "SceneManager::_setPass");
+    }
+    else
+    {
+        // Unbind program?
+        if (mDestRenderSystem->isGpuProgramBound(GPT_VERTEX_PROGRAM))
+        {
+            mDestRenderSystem->unbindGpuProgram(GPT_VERTEX_PROGRAM);
+        }
+        // Set fixed-function vertex parameters
+    }
+
+    if (pass->hasGeometryProgram())
+    {
+        bindGpuProgram(pass->getGeometryProgram()->_getBindingDelegate());
+        // bind parameters later
+    }
+    else
+    {
+        // Unbind program?
+        if (mDestRenderSystem->isGpuProgramBound(GPT_GEOMETRY_PROGRAM))
+        {
+            mDestRenderSystem->unbindGpuProgram(GPT_GEOMETRY_PROGRAM);
+        }
+    }
+    if (pass->hasTessellationHullProgram())
+    {
+        bindGpuProgram(pass->getTessellationHullProgram()->_getBindingDelegate());
+        // bind parameters later
+    }
+    else
+    {
+        // Unbind program?
+        if (mDestRenderSystem->isGpuProgramBound(GPT_HULL_PROGRAM))
+        {
+            mDestRenderSystem->unbindGpuProgram(GPT_HULL_PROGRAM);
+        }
+    }
+
+    if (pass->hasTessellationDomainProgram())
+    {
+        bindGpuProgram(pass->getTessellationDomainProgram()->_getBindingDelegate());
+        // bind parameters later
+    }
+    else
+    {
+        // Unbind program?
+        if (mDestRenderSystem->isGpuProgramBound(GPT_DOMAIN_PROGRAM))
+        {
+            mDestRenderSystem->unbindGpuProgram(GPT_DOMAIN_PROGRAM);
+        }
+    }
+
+    if (pass->hasComputeProgram())
+    {
+        bindGpuProgram(pass->getComputeProgram()->_getBindingDelegate());
+        // bind parameters later
+    }
+    else
+    {
+        // Unbind program?
+        if (mDestRenderSystem->isGpuProgramBound(GPT_COMPUTE_PROGRAM))
+        {
+            mDestRenderSystem->unbindGpuProgram(GPT_COMPUTE_PROGRAM);
+        }
+    }
+
+    // Using a fragment program?
+    if (fprog)
+    {
+        bindGpuProgram(fprog->_getBindingDelegate());
+    }
+    else if (!mDestRenderSystem->getCapabilities()->hasCapability(RSC_FIXED_FUNCTION) &&
+             !pass->hasGeometryProgram())
+    {
+        OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
+                    "RenderSystem does not support FixedFunction, "
+                    "but technique of '" +
+                        pass->getParent()->getParent()->getName() +
+                        "' has no Fragment Shader. Use the RTSS or write custom shaders.",
+                    "SceneManager::_setPass");
+    }
+    else
+    {
+        // Unbind program?
+        if (mDestRenderSystem->isGpuProgramBound(GPT_FRAGMENT_PROGRAM))
+        {
+            mDestRenderSystem->unbindGpuProgram(GPT_FRAGMENT_PROGRAM);
+        }
+        // Set fixed-function fragment settings
+    }
+}
+//-----------------------------------------------------------------------
 void SceneManager::prepareRenderQueue(void)
 {
     RenderQueue* q = getRenderQueue();
@@ -1182,6 +1264,11 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
         mLastFrameNumber = thisFrameNumber;
     }
 
+    // the render operations may change with the camera, e.g. by LOD
+    mAutoInstanceInfos.clear();
+
+    RenderCommandList* recording = NULL;
+    bool replayRecording = false;
     {
         // Lock scene graph mutex, no more changes until we're ready to render
             OGRE_LOCK_MUTEX(sceneGraphMutex);
@@ -1253,6 +1340,19 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
             mDestRenderSystem->setClipPlanes(camera->isWindowSet() ? camera->getWindowPlanes() : PlaneList());
         }
 
+        // Use the render commands recorded for this viewport, unless shadows need the queue
+        if (vp->_getRenderRecording() && mIlluminationStage == IRS_NONE && mFindVisibleObjects &&
+            mActiveQueuedRenderableVisitor == &mDefaultQueuedRenderableVisitor &&
+            !(isShadowTechniqueInUse() && vp->getShadowsEnabled()))
+        {
+            recording = vp->_getRenderRecording();
+            replayRecording = isRenderRecordingValid(*recording, camera, vp);
+
+            // recordings that are invalidated before being replayed only cost time, so retry less often
+            if (!replayRecording && thisFrameNumber < recording->nextRecordingFrame)
+                recording = NULL;
+        }
+
         // Prepare render queue for receiving new objects
         {
             OgreProfileGroup("prepareRenderQueue", OGREPROF_GENERAL);
@@ -1271,14 +1371,36 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
                 "Should never fail to find a visible object bound for a camera, "
                 "did you override SceneManager::createCamera or something?");
 
-            // reset the bounds
-            camVisObjIt->second.reset();
+            // the bounds found when recording are still valid
+            if (!replayRecording)
+            {
+                // reset the bounds
+                camVisObjIt->second.reset();
 
-            // Parse the scene and tag visibles
-            firePreFindVisibleObjects(vp);
-            _findVisibleObjects(camera, &(camVisObjIt->second),
-                mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
-            firePostFindVisibleObjects(vp);
+                if (recording)
+                {
+                    recording->objects.clear();
+                    getRenderQueue()->_setVisibleObjectList(&recording->objects);
+                }
+
+                // Parse the scene and tag visibles
+                firePreFindVisibleObjects(vp);
+                _findVisibleObjects(camera, &(camVisObjIt->second),
+                    mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
+                firePostFindVisibleObjects(vp);
+
+                if (recording)
+                {
+                    getRenderQueue()->_setVisibleObjectList(NULL);
+                    recordRenderCommands(*recording, camera, vp);
+                }
+            }
+            else
+            {
+                // the objects are not culled again, but their LOD and texture usage is refreshed
+                for (MovableObject* mo : recording->objects)
+                    mo->_notifyCurrentCamera(camera);
+            }
 
             mAutoParamDataSource->setMainCamBoundsInfo(&(camVisObjIt->second));
         }
@@ -1298,13 +1420,21 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 
     // Set rasterisation mode
     mDestRenderSystem->_setPolygonMode(camera->getPolygonMode());
+    mDestRenderSystem->_invalidateStateCache();
+    mLastProgramsId = 0;
 
     mDestRenderSystem->_setTextureProjectionRelativeTo(mCameraRelativeRendering, camera->getDerivedPosition());
 
     // Render scene content
     {
         OgreProfileGroup("_renderVisibleObjects", OGREPROF_RENDERING);
-        _renderVisibleObjects();
+        if (replayRecording)
+        {
+            recording->replayed = true;
+            renderRecordedCommands(*recording);
+        }
+        else
+            _renderVisibleObjects();
     }
 
     // End frame
@@ -1558,6 +1688,264 @@ void SceneManager::renderVisibleObjectsDefaultSequence(void)
 
 }
 //-----------------------------------------------------------------------
+RenderCommandList::RenderCommandList()
+    : sceneManager(NULL), valid(false), replayed(false), wastedRecordings(0), nextRecordingFrame(0),
+      camera(NULL)
+{
+}
+//-----------------------------------------------------------------------
+RenderCommandList::~RenderCommandList()
+{
+    if (sceneManager)
+        sceneManager->_removeRenderRecording(this);
+}
+//-----------------------------------------------------------------------
+namespace
+{
+/// Appends the visited renderables to a RenderCommandList
+struct RenderCommandRecorder : public QueuedRenderableVisitor
+{
+    RenderCommandList::CommandList& commands;
+    uint8 queueId;
+
+    RenderCommandRecorder(RenderCommandList::CommandList& cmds) : commands(cmds), queueId(0) {}
+
+    void visit(RenderablePass* rp) override
+    {
+        RenderCommandList::Command cmd = {rp->renderable, rp->pass, queueId};
+        commands.push_back(cmd);
+    }
+    void visit(const Pass* p, RenderableList& rs) override
+    {
+        for (Renderable* r : rs)
+        {
+            RenderCommandList::Command cmd = {r, p, queueId};
+            commands.push_back(cmd);
+        }
+    }
+};
+
+/// Whether renderSingleObject derives the same state for a renderable every frame
+bool isStaticRenderState(const Pass* pass)
+{
+    for (const TextureUnitState* tus : pass->getTextureUnitStates())
+    {
+        if (tus->hasViewRelativeTextureCoordinateGeneration())
+            return false;
+    }
+
+    // the light list may still change, but not the way it is iterated
+    return !pass->getIteratePerLight() && pass->getStartLight() == 0 &&
+           pass->getMaxSimultaneousLights() == OGRE_MAX_SIMULTANEOUS_LIGHTS &&
+           pass->getLightMask() == 0xFFFFFFFF && pass->getIterationDepthBias() == 0.0f;
+}
+}
+void SceneManager::recordRenderCommands(RenderCommandList& recording, Camera* cam, Viewport* vp)
+{
+    unsigned long frame = Root::getSingleton().getNextFrameNumber();
+    if (recording.sceneManager && !recording.replayed)
+    {
+        recording.wastedRecordings = std::min(recording.wastedRecordings + 1, 6);
+        recording.nextRecordingFrame = frame + (1ul << recording.wastedRecordings);
+    }
+    else
+    {
+        recording.wastedRecordings = 0;
+    }
+
+    if (recording.sceneManager != this)
+    {
+        if (recording.sceneManager)
+            recording.sceneManager->_removeRenderRecording(&recording);
+        mRenderRecordings.push_back(&recording);
+        recording.sceneManager = this;
+    }
+
+    recording.commands.clear();
+    RenderCommandRecorder recorder(recording.commands);
+
+    // same order as renderVisibleObjectsDefaultSequence and renderBasicQueueGroupObjects
+    const RenderQueue::RenderQueueGroupMap& groups = getRenderQueue()->_getQueueGroups();
+    for (uint8 qId = 0; qId < RENDER_QUEUE_COUNT; ++qId)
+    {
+        if(!groups[qId])
+            continue;
+
+        recorder.queueId = qId;
+        for (const auto& pg : groups[qId]->getPriorityGroups())
+        {
+            RenderPriorityGroup* pPriorityGrp = pg.second;
+            pPriorityGrp->sort(cam);
+
+            pPriorityGrp->getSolidsBasic().acceptVisitor(&recorder, QueuedRenderableCollection::OM_PASS_GROUP);
+            pPriorityGrp->getTransparentsUnsorted().acceptVisitor(&recorder,
+                                                                  QueuedRenderableCollection::OM_PASS_GROUP);
+            pPriorityGrp->getTransparents().acceptVisitor(&recorder,
+                                                          QueuedRenderableCollection::OM_SORT_DESCENDING);
+        }
+    }
+
+    // derive what renderSingleObject would every frame, dropping what would not be rendered
+    recording.passes.clear();
+    const Pass* lastPass = NULL;
+    bool passValid = false;
+    bool staticState = false;
+    RenderCommandList::CommandList::iterator dest = recording.commands.begin();
+    for (RenderCommandList::Command& cmd : recording.commands)
+    {
+        if (cmd.pass != lastPass)
+        {
+            lastPass = cmd.pass;
+            passValid = validatePassForRendering(lastPass);
+            staticState = isStaticRenderState(lastPass) && !isAutoInstancingPass(lastPass) &&
+                          !isLateMaterialResolving();
+            recording.passes.push_back(std::make_pair(lastPass, lastPass->getChangeCount()));
+        }
+
+        if (!passValid || !validateRenderableForRendering(cmd.pass, cmd.rend))
+            continue;
+
+        // the world matrix does not change while the recording is valid
+        cmd.derived = staticState && cmd.rend->getNumWorldTransforms() == 1;
+        if (cmd.derived)
+        {
+            Matrix4 world;
+            cmd.rend->getWorldTransforms(&world);
+            Matrix3 linear = Affine3(world).linear();
+            cmd.scaled = linear.hasScale();
+            cmd.negativeScale = linear.hasNegativeScale();
+            cmd.polygonModeOverrideable = cmd.rend->getPolygonModeOverrideable();
+        }
+        *dest++ = cmd;
+    }
+    recording.commands.erase(dest, recording.commands.end());
+
+    // changes outside of the far plane are not seen, unless it is infinite
+    const Plane* planes = cam->getFrustumPlanes();
+    recording.volume.planes.assign(planes, planes + (cam->getFarClipDistance() == 0 ? 5 : 6));
+    recording.volume.outside = Plane::NEGATIVE_SIDE;
+
+    recording.valid = true;
+    recording.replayed = false;
+    recording.camera = cam;
+    recording.viewMatrix = cam->getViewMatrix();
+    recording.projMatrix = cam->getProjectionMatrix();
+    recording.visibilityMask = vp->getVisibilityMask();
+    recording.materialScheme = vp->getMaterialScheme();
+    recording.passDeletionCounter = Pass::getDeletionCounter();
+}
+//-----------------------------------------------------------------------
+bool SceneManager::isRenderRecordingValid(const RenderCommandList& recording, Camera* cam,
+                                          Viewport* vp) const
+{
+    if (!recording.valid || recording.sceneManager != this || recording.camera != cam ||
+        recording.passDeletionCounter != Pass::getDeletionCounter() ||
+        recording.visibilityMask != vp->getVisibilityMask() ||
+        recording.materialScheme != vp->getMaterialScheme() ||
+        !(recording.viewMatrix == cam->getViewMatrix()) ||
+        !(recording.projMatrix == cam->getProjectionMatrix()))
+        return false;
+
+    for (const auto& p : recording.passes)
+    {
+        if (p.first->getChangeCount() != p.second)
+            return false;
+    }
+    return true;
+}
+//-----------------------------------------------------------------------
+void SceneManager::_notifySceneChanged(const AxisAlignedBox& bounds)
+{
+    for (RenderCommandList* recording : mRenderRecordings)
+    {
+        if (recording->valid && recording->volume.intersects(bounds))
+            recording->valid = false;
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::_removeRenderRecording(RenderCommandList* recording)
+{
+    RenderCommandListList::iterator i = std::find(mRenderRecordings.begin(), mRenderRecordings.end(), recording);
+    if (i != mRenderRecordings.end())
+        mRenderRecordings.erase(i);
+    recording->sceneManager = NULL;
+    recording->valid = false;
+    recording->objects.clear();
+}
+//-----------------------------------------------------------------------
+void SceneManager::renderRecordedCommands(const RenderCommandList& recording)
+{
+    firePreRenderQueues();
+
+    const RenderQueue::RenderQueueGroupMap& groups = getRenderQueue()->_getQueueGroups();
+    RenderCommandList::CommandList::const_iterator first = recording.commands.begin();
+
+    for (uint8 qId = 0; qId < RENDER_QUEUE_COUNT; ++qId)
+    {
+        RenderCommandList::CommandList::const_iterator last = first;
+        while (last != recording.commands.end() && last->queueId == qId)
+            ++last;
+
+        if ((first != last || groups[qId]) && isRenderQueueToBeProcessed(qId))
+        {
+            bool repeatQueue = false;
+            do // for repeating queues
+            {
+                // Fire queue started event
+                if (fireRenderQueueStarted(qId, BLANKSTRING))
+                {
+                    // Someone requested we skip this queue
+                    break;
+                }
+
+                // the passes were validated when recording
+                const Pass* lastPass = NULL;
+                const Pass* usedPass = NULL;
+                for (RenderCommandList::CommandList::const_iterator i = first; i != last; ++i)
+                {
+                    if (i->pass != lastPass)
+                    {
+                        lastPass = i->pass;
+                        usedPass = _setPass(lastPass);
+                    }
+
+                    if (i->derived)
+                        renderRecordedObject(*i);
+                    else
+                        renderSingleObject(i->rend, usedPass, true, true);
+                }
+
+                // Render anything the listeners queued, e.g. overlays
+                if (groups[qId])
+                    _renderQueueGroupObjects(groups[qId].get(), QueuedRenderableCollection::OM_PASS_GROUP);
+
+                // Fire queue ended event, someone may request we repeat this queue
+                repeatQueue = fireRenderQueueEnded(qId, BLANKSTRING);
+            } while (repeatQueue);
+        }
+
+        first = last;
+    }
+
+    firePostRenderQueues();
+}
+//-----------------------------------------------------------------------
+void SceneManager::renderRecordedObject(const RenderCommandList::Command& cmd)
+{
+    const Pass* pass = cmd.pass;
+    mAutoParamDataSource->setCurrentRenderable(cmd.rend);
+    setWorldTransform(cmd.rend);
+
+    // same as renderSingleObject, but with the world matrix already examined
+    applyObjectRasterState(pass, cmd.scaled, cmd.negativeScale, cmd.polygonModeOverrideable);
+    mDestRenderSystem->setDeriveDepthBias(false);
+
+    issueRenderWithLights(cmd.rend, pass, &cmd.rend->getLights(), true);
+
+    // Reset view / projection changes if any
+    resetViewProjMode();
+}
+//-----------------------------------------------------------------------
 void SceneManager::SceneMgrQueuedRenderableVisitor::visit(const Pass* p, RenderableList& rs)
 {
     // Give SM a chance to eliminate this pass
@@ -1567,6 +1955,12 @@ void SceneManager::SceneMgrQueuedRenderableVisitor::visit(const Pass* p, Rendera
     // Set pass, store the actual one used
     mUsedPass = targetSceneMgr->_setPass(p);
 
+    if (targetSceneMgr->isAutoInstancingPass(mUsedPass))
+    {
+        targetSceneMgr->renderAutoInstanced(rs, mUsedPass, scissoring, autoLights, manualLightList);
+        return;
+    }
+
     for (Renderable* r : rs)
     {
         // Give SM a chance to eliminate
@@ -1777,10 +2171,62 @@ void SceneManager::issueRenderWithLights(Renderable* rend, const Pass* pass,
          resetLightClip();
 }
 //-----------------------------------------------------------------------
+void SceneManager::applyObjectRasterState(const Pass* pass, bool scaled, bool negativeScale,
+                                          bool polygonModeOverrideable)
+{
+    // Sort out normalisation
+    mDestRenderSystem->setNormaliseNormals((pass->getNormaliseNormals() || mNormaliseNormalsOnScale) && scaled);
+
+    // Sort out negative scaling
+    // this also copes with returning from negative scale in previous render op
+    // for same pass
+    CullingMode cullMode = mPassCullingMode;
+    if (mFlipCullingOnNegativeScale && negativeScale)
+    {
+        switch(mPassCullingMode)
+        {
+        case CULL_CLOCKWISE:
+            cullMode = CULL_ANTICLOCKWISE;
+            break;
+        case CULL_ANTICLOCKWISE:
+            cullMode = CULL_CLOCKWISE;
+            break;
+        case CULL_NONE:
+            break;
+        };
+    }
+
+    // Set up the solid / wireframe override
+    // Precedence is Camera, Object, Material
+    // Camera might not override object if not overrideable
+    PolygonMode reqMode = pass->getPolygonMode();
+    if (pass->getPolygonModeOverrideable() && polygonModeOverrideable)
+    {
+        PolygonMode camPolyMode = mCameraInProgress->getPolygonMode();
+        // check camera detial only when render detail is overridable
+        if (reqMode > camPolyMode)
+        {
+            // only downgrade detail; if cam says wireframe we don't go up to solid
+            reqMode = camPolyMode;
+        }
+    }
+    mDestRenderSystem->_applyRasterState(cullMode, reqMode, pass->getShadingMode());
+}
+//-----------------------------------------------------------------------
 void SceneManager::renderSingleObject(Renderable* rend, const Pass* pass,
                                       bool lightScissoringClipping, bool doLightIteration,
                                       const LightList* manualLightList)
 {
+    if (rend != mAutoInstanceBatch.get() && isAutoInstancingPass(pass) &&
+        getAutoInstanceInfo(rend).instanceable)
+    {
+        // the program expects the world matrix in the vertex stream, so draw a single instance
+        mAutoInstanceRun.assign(1, rend);
+        renderAutoInstanceBatch(mAutoInstanceRun, pass, lightScissoringClipping, doLightIteration,
+                                manualLightList);
+        return;
+    }
+
     OgreProfileBeginGPUEvent(pass->getParent()->getParent()->getName());
 
     // Tell auto params object about the renderable change
@@ -1788,6 +2234,11 @@ void SceneManager::renderSingleObject(Renderable* rend, const Pass* pass,
 
     setWorldTransform(rend);
 
+    // the world matrix of the auto params is identity when drawing instances
+    const Affine3& worldMatrix = rend == mAutoInstanceBatch.get()
+                                     ? mAutoInstanceBatch->getBaseWorldTransform()
+                                     : mAutoParamDataSource->getWorldMatrix();
+
     // Reissue any texture gen settings which are dependent on view matrix
     size_t unit = 0;
     Pass::TextureUnitStates::const_iterator it;
@@ -1801,57 +2252,10 @@ void SceneManager::renderSingleObject(Renderable* rend, const Pass* pass,
         ++unit;
     }
 
-    // Sort out normalisation
     // Assume first world matrix representative - shaders that use multiple
     // matrices should control renormalisation themselves
-    if ((pass->getNormaliseNormals() || mNormaliseNormalsOnScale) &&
-        mAutoParamDataSource->getWorldMatrix().linear().hasScale())
-        mDestRenderSystem->setNormaliseNormals(true);
-    else
-        mDestRenderSystem->setNormaliseNormals(false);
-
-    // Sort out negative scaling
-    // Assume first world matrix representative
-    if (mFlipCullingOnNegativeScale)
-    {
-        CullingMode cullMode = mPassCullingMode;
-
-        if (mAutoParamDataSource->getWorldMatrix().linear().hasNegativeScale())
-        {
-            switch(mPassCullingMode)
-            {
-            case CULL_CLOCKWISE:
-                cullMode = CULL_ANTICLOCKWISE;
-                break;
-            case CULL_ANTICLOCKWISE:
-                cullMode = CULL_CLOCKWISE;
-                break;
-            case CULL_NONE:
-                break;
-            };
-        }
-
-        // this also copes with returning from negative scale in previous render op
-        // for same pass
-        if (cullMode != mDestRenderSystem->_getCullingMode())
-            mDestRenderSystem->_setCullingMode(cullMode);
-    }
-
-    // Set up the solid / wireframe override
-    // Precedence is Camera, Object, Material
-    // Camera might not override object if not overrideable
-    PolygonMode reqMode = pass->getPolygonMode();
-    if (pass->getPolygonModeOverrideable() && rend->getPolygonModeOverrideable())
-    {
-        PolygonMode camPolyMode = mCameraInProgress->getPolygonMode();
-        // check camera detial only when render detail is overridable
-        if (reqMode > camPolyMode)
-        {
-            // only downgrade detail; if cam says wireframe we don't go up to solid
-            reqMode = camPolyMode;
-        }
-    }
-    mDestRenderSystem->_setPolygonMode(reqMode);
+    Matrix3 linear = worldMatrix.linear();
+    applyObjectRasterState(pass, linear.hasScale(), linear.hasNegativeScale(), rend->getPolygonModeOverrideable());
 
     if (!doLightIteration)
     {
@@ -2023,7 +2427,9 @@ void SceneManager::renderSingleObject(Renderable* rend, const Pass* pass,
             // because of Pass state grouping. So set it always
 
             // Set modified depth bias right away
-            mDestRenderSystem->_setDepthBias(depthBiasBase, pass->getDepthBiasSlopeScale());
+            mDestRenderSystem->_applyDepthState(pass->getDepthCheckEnabled(), pass->getDepthWriteEnabled(),
+                                                pass->getDepthFunction(), depthBiasBase,
+                                                pass->getDepthBiasSlopeScale());
 
             // Set to increment internally too if rendersystem iterates
             mDestRenderSystem->setDeriveDepthBias(true,
@@ -2044,6 +2450,186 @@ void SceneManager::renderSingleObject(Renderable* rend, const Pass* pass,
     OgreProfileEndGPUEvent(pass->getParent()->getParent()->getName());
 }
 //-----------------------------------------------------------------------
+bool SceneManager::isAutoInstancingPass(const Pass* pass) const
+{
+    return pass->hasVertexProgram() && pass->getVertexProgram()->isInstancingIncluded() &&
+           mDestRenderSystem->getCapabilities()->hasCapability(RSC_VERTEX_BUFFER_INSTANCE_DATA) &&
+           // do not interfere with instancing set up by the user
+           !mDestRenderSystem->getGlobalInstanceVertexBuffer();
+}
+//-----------------------------------------------------------------------
+const SceneManager::AutoInstanceInfo& SceneManager::getAutoInstanceInfo(Renderable* rend)
+{
+    auto it = mAutoInstanceInfos.find(rend);
+    if (it != mAutoInstanceInfos.end())
+        return it->second;
+
+    AutoInstanceInfo& info = mAutoInstanceInfos[rend];
+    info.instanceable = false;
+    info.negativeScale = false;
+    if (rend->getNumWorldTransforms() != 1 || rend->getUseIdentityView() || rend->getUseIdentityProjection())
+        return info;
+
+    // not already instanced, e.g. by an InstanceManager
+    rend->getRenderOperation(info.op);
+    info.instanceable = !info.op.vertexData->vertexBufferBinding->hasInstanceData();
+
+    Matrix4 xform;
+    rend->getWorldTransforms(&xform);
+    info.negativeScale = xform.linear().hasNegativeScale();
+    return info;
+}
+//-----------------------------------------------------------------------
+void SceneManager::renderAutoInstanced(const RenderableList& rends, const Pass* pass,
+                                       bool lightScissoringClipping, bool doLightIteration,
+                                       const LightList* manualLightList)
+{
+    // custom parameters are per renderable, so they can not be shared by the instances
+    bool batchable = true;
+    for (int i = 0; i < GPT_COUNT && batchable; i++)
+    {
+        if (!pass->hasGpuProgram(GpuProgramType(i)))
+            continue;
+
+        for (const auto& ac : pass->getGpuProgramParameters(GpuProgramType(i))->getAutoConstantList())
+            batchable &= ac.paramType != GpuProgramParameters::ACT_CUSTOM;
+    }
+
+    const AutoInstanceInfo* runInfo = NULL;
+    mAutoInstanceRun.clear();
+
+    for (Renderable* r : rends)
+    {
+        // Give SM a chance to eliminate
+        if (!validateRenderableForRendering(pass, r))
+            continue;
+
+        const AutoInstanceInfo& info = getAutoInstanceInfo(r);
+        if (!info.instanceable)
+        {
+            if (!mAutoInstanceRun.empty())
+                renderAutoInstanceBatch(mAutoInstanceRun, pass, lightScissoringClipping, doLightIteration,
+                                        manualLightList);
+            mAutoInstanceRun.clear();
+
+            renderSingleObject(r, pass, lightScissoringClipping, doLightIteration, manualLightList);
+            continue;
+        }
+
+        const RenderOperation& op = info.op;
+        bool compatible = batchable && !mAutoInstanceRun.empty() &&
+                          op.vertexData == runInfo->op.vertexData && op.indexData == runInfo->op.indexData &&
+                          op.operationType == runInfo->op.operationType &&
+                          op.useIndexes == runInfo->op.useIndexes &&
+                          info.negativeScale == runInfo->negativeScale &&
+                          r->getPolygonModeOverrideable() ==
+                              mAutoInstanceRun.front()->getPolygonModeOverrideable() &&
+                          (!doLightIteration ||
+                           r->getLights().getHash() == mAutoInstanceRun.front()->getLights().getHash());
+
+        if (!compatible && !mAutoInstanceRun.empty())
+        {
+            renderAutoInstanceBatch(mAutoInstanceRun, pass, lightScissoringClipping, doLightIteration,
+                                    manualLightList);
+            mAutoInstanceRun.clear();
+        }
+
+        if (mAutoInstanceRun.empty())
+            runInfo = &info;
+        mAutoInstanceRun.push_back(r);
+    }
+
+    if (!mAutoInstanceRun.empty())
+        renderAutoInstanceBatch(mAutoInstanceRun, pass, lightScissoringClipping, doLightIteration, manualLightList);
+}
+//-----------------------------------------------------------------------
+void SceneManager::renderAutoInstanceBatch(const RenderableList& rends, const Pass* pass,
+                                           bool lightScissoringClipping, bool doLightIteration,
+                                           const LightList* manualLightList)
+{
+    Renderable* base = rends.front();
+    const RenderOperation& op = getAutoInstanceInfo(base).op;
+
+    AutoInstanceBatch& batch = *mAutoInstanceBatch;
+    HardwareBufferManager& hbm = HardwareBufferManager::getSingleton();
+
+    // a 3x4 world matrix per instance
+    size_t stride = 3 * VertexElement::getTypeSize(VET_FLOAT4);
+
+    // stream the matrices of all batches of a frame through a ring of instance data, if the
+    // dynamic vertex rings are enabled, instead of discarding the same buffer for every batch
+    if (!batch.mTransformRing && hbm.getDynamicVertexRingSize())
+    {
+        batch.mTransformRing.reset(new VertexBufferRing(
+            stride, std::max<size_t>(hbm.getDynamicVertexRingSize() / stride, 1),
+            hbm.getDynamicVertexRingFramesInFlight()));
+        batch.mTransformRing->getBuffer()->setIsInstanceData(true);
+        batch.mTransformRing->getBuffer()->setInstanceDataStepRate(1);
+    }
+
+    HardwareVertexBufferSharedPtr transforms;
+    size_t instanceStart = 0;
+    float* dst = NULL;
+    if (batch.mTransformRing)
+    {
+        dst = static_cast<float*>(batch.mTransformRing->lock(
+            rends.size(), Root::getSingleton().getNextFrameNumber(), instanceStart));
+        if (dst)
+            transforms = batch.mTransformRing->getBuffer();
+    }
+
+    if (!dst)
+    {
+        // out of ring space, fall back to a buffer of our own
+        if (!batch.mTransforms || batch.mTransforms->getNumVertices() < rends.size())
+        {
+            batch.mTransforms = hbm.createVertexBuffer(stride, Bitwise::firstPO2From(uint32(rends.size())),
+                                                       HBU_CPU_TO_GPU);
+            batch.mTransforms->setIsInstanceData(true);
+            batch.mTransforms->setInstanceDataStepRate(1);
+        }
+        transforms = batch.mTransforms;
+        instanceStart = 0;
+        dst = static_cast<float*>(transforms->lock(0, rends.size() * stride, HardwareBuffer::HBL_DISCARD));
+    }
+
+    for (Renderable* r : rends)
+    {
+        Matrix4 xform;
+        r->getWorldTransforms(&xform);
+        for (int row = 0; row < 3; row++)
+            for (int col = 0; col < 4; col++)
+                *dst++ = float(xform[row][col]);
+    }
+    transforms->unlock();
+
+    // where the program reads the matrix from, by default following the texture coordinates
+    // of the geometry, as with HWInstancingBasic
+    if (!batch.mDeclaration)
+        batch.mDeclaration = hbm.createVertexDeclaration();
+    batch.mDeclaration->removeAllElements();
+    int texCoordIndex = pass->getVertexProgram()->getInstancingTexCoordIndex();
+    unsigned short texCoord = texCoordIndex < 0
+                                  ? op.vertexData->vertexDeclaration->getNextFreeTextureCoordinate()
+                                  : (unsigned short)texCoordIndex;
+    for (unsigned short i = 0; i < 3; i++)
+    {
+        // the global instance buffer has no start of its own, so address the ring space via the offsets
+        batch.mDeclaration->addElement(0, instanceStart * stride + i * VertexElement::getTypeSize(VET_FLOAT4),
+                                       VET_FLOAT4, VES_TEXTURE_COORDINATES, texCoord + i);
+    }
+
+    mDestRenderSystem->setGlobalInstanceVertexBuffer(transforms);
+    mDestRenderSystem->setGlobalInstanceVertexBufferVertexDeclaration(batch.mDeclaration);
+    mDestRenderSystem->setGlobalNumberOfInstances(1);
+
+    batch.reset(base, uint32(rends.size()));
+    renderSingleObject(&batch, pass, lightScissoringClipping, doLightIteration, manualLightList);
+
+    mDestRenderSystem->setGlobalInstanceVertexBuffer(HardwareVertexBufferSharedPtr());
+    mDestRenderSystem->setGlobalInstanceVertexBufferVertexDeclaration(NULL);
+}
+//-----------------------------------------------------------------------
 void SceneManager::setAmbientLight(const ColourValue& colour)
 {
     mGpuParamsDirty |= GPV_GLOBAL;
@@ -2554,6 +3140,9 @@ void SceneManager::setViewport(Viewport* vp)
     mAutoParamDataSource->setCurrentViewport(vp);
     // Set viewport in render system
     mDestRenderSystem->_setViewport(vp);
+    // the target may have its own state, e.g. a different GL context
+    mDestRenderSystem->_invalidateStateCache();
+    mLastProgramsId = 0;
     // Set the active material scheme for this viewport
     MaterialManager::getSingleton().setActiveScheme(vp->getMaterialScheme());
 }
@@ -3118,6 +3707,8 @@ void SceneManager::_resumeRendering(SceneManager::RenderContext* context)
 
     // Set rasterisation mode
     mDestRenderSystem->_setPolygonMode(mCameraInProgress->getPolygonMode());
+    mDestRenderSystem->_invalidateStateCache();
+    mLastProgramsId = 0;
     
     mDestRenderSystem->_setTextureProjectionRelativeTo(mCameraRelativeRendering, mCameraInProgress->getDerivedPosition());
     delete context;
@@ -3798,6 +4389,7 @@ void SceneManager::bindGpuProgram(GpuProgram* prog)
     // Hash == 1 is almost impossible to achieve otherwise
     mLastLightHash = 1;
     mGpuParamsDirty = (uint16)GPV_ALL;
+    mLastProgramsId = 0;
     mDestRenderSystem->bindGpuProgram(prog);
 }
 //---------------------------------------------------------------------
@@ -82,6 +82,8 @@ namespace Ogre {
         if (inGraph != mIsInSceneGraph)
         {
             mIsInSceneGraph = inGraph;
+            if (mCreator && mCreator->_hasRenderRecordings())
+                mCreator->_notifySceneChanged(mWorldAABB);
             // Tell children
             for (auto child : getChildren())
             {
@@ -274,6 +276,14 @@ namespace Ogre {
         {
             o->_notifyMoved();
         }
+
+        // render commands recorded where the objects were or are now are stale
+        if (mCreator && mCreator->_hasRenderRecordings())
+        {
+            mCreator->_notifySceneChanged(mWorldAABB);
+            for (auto o : mObjectsByName)
+                mCreator->_notifySceneChanged(o->getWorldBoundingBox(true));
+        }
     }
     //-----------------------------------------------------------------------
     Node* SceneNode::createChildImpl(void)
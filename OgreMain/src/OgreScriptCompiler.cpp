@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "OgreScriptParser.h"
 #include "OgreBuiltinScriptTranslators.h"
 #include "OgreComponents.h"
+#include "OgreStreamSerialiser.h"
 
 #define DEBUG_AST 0
 
@@ -323,6 +324,31 @@ namespace Ogre
 #endif
 
     bool ScriptCompiler::compile(const ConcreteNodeListPtr &nodes, const String &group)
+    {
+        AbstractNodeListPtr ast = processAST(nodes, group);
+        mImportHashes.clear();
+        return translateAST(ast);
+    }
+
+    bool ScriptCompiler::_compile(const ConcreteNodeListPtr &nodes, const String &group,
+                                  AbstractNodeListPtr &ast, ImportHashMap &importHashes)
+    {
+        ast = processAST(nodes, group);
+        importHashes.swap(mImportHashes);
+        mImportHashes.clear();
+        return translateAST(ast);
+    }
+
+    bool ScriptCompiler::_compile(const AbstractNodeListPtr &ast, const String &group)
+    {
+        mGroup = group;
+        mErrors.clear();
+        mEnv.clear();
+
+        return translateAST(ast);
+    }
+
+    AbstractNodeListPtr ScriptCompiler::processAST(const ConcreteNodeListPtr &nodes, const String &group)
     {
         // Set up the compilation context
         mGroup = group;
@@ -345,6 +371,15 @@ namespace Ogre
         // Process variable expansion
         processVariables(*ast);
 
+        mImports.clear();
+        mImportRequests.clear();
+        mImportTable.clear();
+
+        return ast;
+    }
+
+    bool ScriptCompiler::translateAST(const AbstractNodeListPtr &ast)
+    {
         // Allows early bail-out through the listener
         if(mListener && !mListener->postConversion(this, ast))
             return mErrors.empty();
@@ -363,10 +398,6 @@ namespace Ogre
                 translator->translate(this, *i);
         }
 
-        mImports.clear();
-        mImportRequests.clear();
-        mImportTable.clear();
-
         return mErrors.empty();
     }
 
@@ -414,6 +445,261 @@ namespace Ogre
         return builder.getResult();
     }
 
+    namespace
+    {
+        /// Flattens an AST into 32bit words, storing every distinct string only once
+        struct ASTWriter
+        {
+            std::vector<uint32> words;
+            std::map<String, uint32> stringIds;
+            StringVector strings;
+
+            void write(uint32 val) { words.push_back(val); }
+            void write(const String& str)
+            {
+                auto it = stringIds.emplace(str, uint32(strings.size()));
+                if(it.second)
+                    strings.push_back(str);
+                words.push_back(it.first->second);
+            }
+            void write(const AbstractNodeList& nodes)
+            {
+                write(uint32(nodes.size()));
+                for(const auto& node : nodes)
+                    write(*node);
+            }
+            void write(const AbstractNode& node)
+            {
+                write(uint32(node.type));
+                write(node.file);
+                write(uint32(node.line));
+
+                switch(node.type)
+                {
+                case ANT_ATOM:
+                    write(static_cast<const AtomAbstractNode&>(node).value);
+                    break;
+                case ANT_OBJECT:
+                    {
+                        const ObjectAbstractNode& obj = static_cast<const ObjectAbstractNode&>(node);
+                        write(obj.name);
+                        write(obj.cls);
+                        write(uint32(obj.bases.size()));
+                        for(const auto& base : obj.bases)
+                            write(base);
+                        write(uint32(obj.abstract));
+                        write(uint32(obj.getVariables().size()));
+                        for(const auto& var : obj.getVariables())
+                        {
+                            write(var.first);
+                            write(var.second);
+                        }
+                        write(obj.children);
+                        write(obj.values);
+                    }
+                    break;
+                case ANT_PROPERTY:
+                    {
+                        const PropertyAbstractNode& prop = static_cast<const PropertyAbstractNode&>(node);
+                        write(prop.name);
+                        write(prop.values);
+                    }
+                    break;
+                case ANT_IMPORT:
+                    write(static_cast<const ImportAbstractNode&>(node).target);
+                    write(static_cast<const ImportAbstractNode&>(node).source);
+                    break;
+                case ANT_VARIABLE_ACCESS:
+                    write(static_cast<const VariableAccessAbstractNode&>(node).name);
+                    break;
+                default:
+                    break;
+                }
+            }
+        };
+
+        /// Restores the nodes written by ASTWriter, looking up the word ids again
+        struct ASTReader
+        {
+            const uchar* pos;
+            const uchar* end;
+            const ScriptCompiler::IdMap& ids;
+            StringVector strings;
+            String emptyString;
+            bool valid;
+
+            ASTReader(const uchar* data, size_t size, const ScriptCompiler::IdMap& idMap)
+                : pos(data), end(data + size), ids(idMap), valid(true)
+            {
+            }
+
+            uint32 readUInt()
+            {
+                uint32 val = 0;
+                if(size_t(end - pos) < sizeof(uint32))
+                {
+                    valid = false;
+                    return val;
+                }
+                memcpy(&val, pos, sizeof(uint32));
+                pos += sizeof(uint32);
+                return val;
+            }
+            const String& readString()
+            {
+                uint32 idx = readUInt();
+                if(idx >= strings.size())
+                {
+                    valid = false;
+                    return emptyString;
+                }
+                return strings[idx];
+            }
+            void readStrings()
+            {
+                uint32 count = readUInt();
+                for(uint32 i = 0; i < count && valid; ++i)
+                {
+                    uint32 length = readUInt();
+                    if(size_t(end - pos) < length)
+                    {
+                        valid = false;
+                        return;
+                    }
+                    strings.push_back(String(reinterpret_cast<const char*>(pos), length));
+                    pos += length;
+                }
+            }
+            uint32 findId(const String& word) const
+            {
+                auto it = ids.find(word);
+                return it != ids.end() ? it->second : 0;
+            }
+            void readNodes(AbstractNodeList& nodes, AbstractNode* parent)
+            {
+                uint32 count = readUInt();
+                for(uint32 i = 0; i < count && valid; ++i)
+                    nodes.push_back(readNode(parent));
+            }
+            AbstractNodePtr readNode(AbstractNode* parent)
+            {
+                uint32 type = readUInt();
+                String file = readString();
+                uint32 line = readUInt();
+
+                AbstractNodePtr node;
+                switch(type)
+                {
+                case ANT_ATOM:
+                    {
+                        AtomAbstractNode* impl = OGRE_NEW AtomAbstractNode(parent);
+                        node = AbstractNodePtr(impl);
+                        impl->value = readString();
+                        impl->id = findId(impl->value);
+                    }
+                    break;
+                case ANT_OBJECT:
+                    {
+                        ObjectAbstractNode* impl = OGRE_NEW ObjectAbstractNode(parent);
+                        node = AbstractNodePtr(impl);
+                        impl->name = readString();
+                        impl->cls = readString();
+                        // the translators were looked up by this id, so it must still be registered
+                        auto id = ids.find(impl->cls);
+                        if(id == ids.end())
+                        {
+                            valid = false;
+                            break;
+                        }
+                        impl->id = id->second;
+                        uint32 numBases = readUInt();
+                        for(uint32 i = 0; i < numBases && valid; ++i)
+                            impl->bases.push_back(readString());
+                        impl->abstract = readUInt() != 0;
+                        uint32 numVariables = readUInt();
+                        for(uint32 i = 0; i < numVariables && valid; ++i)
+                        {
+                            const String& name = readString();
+                            impl->setVariable(name, readString());
+                        }
+                        readNodes(impl->children, impl);
+                        readNodes(impl->values, impl);
+                    }
+                    break;
+                case ANT_PROPERTY:
+                    {
+                        PropertyAbstractNode* impl = OGRE_NEW PropertyAbstractNode(parent);
+                        node = AbstractNodePtr(impl);
+                        impl->name = readString();
+                        impl->id = findId(impl->name);
+                        readNodes(impl->values, impl);
+                    }
+                    break;
+                case ANT_IMPORT:
+                    {
+                        ImportAbstractNode* impl = OGRE_NEW ImportAbstractNode();
+                        node = AbstractNodePtr(impl);
+                        impl->parent = parent;
+                        impl->target = readString();
+                        impl->source = readString();
+                    }
+                    break;
+                case ANT_VARIABLE_ACCESS:
+                    {
+                        VariableAccessAbstractNode* impl = OGRE_NEW VariableAccessAbstractNode(parent);
+                        node = AbstractNodePtr(impl);
+                        impl->name = readString();
+                    }
+                    break;
+                default:
+                    valid = false;
+                    return node;
+                }
+
+                node->file = file;
+                node->line = line;
+                return node;
+            }
+        };
+    }
+
+    MemoryDataStreamPtr ScriptCompiler::_serialiseAST(const AbstractNodeList &nodes)
+    {
+        ASTWriter writer;
+        writer.write(nodes);
+
+        size_t size = sizeof(uint32) * (writer.words.size() + writer.strings.size() + 1);
+        for(const auto& str : writer.strings)
+            size += str.size();
+
+        MemoryDataStreamPtr data(OGRE_NEW MemoryDataStream(size));
+        uint32 numStrings = uint32(writer.strings.size());
+        data->write(&numStrings, sizeof(uint32));
+        for(const auto& str : writer.strings)
+        {
+            uint32 length = uint32(str.size());
+            data->write(&length, sizeof(uint32));
+            data->write(str.data(), length);
+        }
+        data->write(writer.words.data(), sizeof(uint32) * writer.words.size());
+        data->seek(0);
+
+        return data;
+    }
+
+    AbstractNodeListPtr ScriptCompiler::_deserialiseAST(const MemoryDataStreamPtr &data) const
+    {
+        ASTReader reader(data->getPtr(), data->size(), mIds);
+        reader.readStrings();
+
+        AbstractNodeListPtr ast(OGRE_NEW_T(AbstractNodeList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        reader.readNodes(*ast, NULL);
+
+        if(!reader.valid || reader.pos != reader.end)
+            return AbstractNodeListPtr();
+        return ast;
+    }
+
     void ScriptCompiler::processImports(AbstractNodeList &nodes)
     {
         // We only need to iterate over the top-level of nodes
@@ -516,7 +802,9 @@ namespace Ogre
             if (!stream)
                 return retval;
 
-            nodes = ScriptParser::parse(ScriptLexer::tokenize(stream->getAsString(), name), name);
+            String source = stream->getAsString();
+            mImportHashes[name] = FastHash(source.data(), source.size());
+            nodes = ScriptParser::parse(ScriptLexer::tokenize(source, name), name);
         }
 
         if(nodes)
@@ -1499,6 +1787,31 @@ namespace Ogre
     
 
     // ScriptCompilerManager
+    namespace
+    {
+        uint32 SCRIPT_CACHE_CHUNK_ID = StreamSerialiser::makeIdentifier("OSCC"); // Ogre Script Compiler cache
+        const uint16 SCRIPT_CACHE_VERSION = 2;
+
+        struct PreparedScript
+        {
+            uint32 hash;
+            ConcreteNodeListPtr nodes; // null if the script is taken from the cache
+        };
+    }
+
+    /// The imports of a group may have changed on disk by the time its scripts are parsed again
+    class ScriptCompilerManager::ImportHashInvalidator : public ResourceGroupListener
+    {
+        ScriptCompilerManager* mOwner;
+    public:
+        ImportHashInvalidator(ScriptCompilerManager* owner) : mOwner(owner) {}
+
+        void resourceGroupScriptingStarted(const String& groupName, size_t scriptCount) override
+        {
+            mOwner->clearImportHashes(groupName);
+        }
+    };
+
     template<> ScriptCompilerManager *Singleton<ScriptCompilerManager>::msSingleton = 0;
     
     ScriptCompilerManager* ScriptCompilerManager::getSingletonPtr(void)
@@ -1512,6 +1825,7 @@ namespace Ogre
     }
     //-----------------------------------------------------------------------
     ScriptCompilerManager::ScriptCompilerManager()
+        : mScriptCacheHits(0), mSaveScriptsToCache(false), mScriptCacheDirty(false)
     {
             OGRE_LOCK_AUTO_MUTEX;
         mScriptPatterns.push_back("*.program");
@@ -1521,12 +1835,18 @@ namespace Ogre
         mScriptPatterns.push_back("*.os");
         ResourceGroupManager::getSingleton()._registerScriptLoader(this);
 
+        mImportHashInvalidator.reset(new ImportHashInvalidator(this));
+        ResourceGroupManager::getSingleton().addResourceGroupListener(mImportHashInvalidator.get());
+
         mBuiltinTranslatorManager = OGRE_NEW BuiltinScriptTranslatorManager();
         mManagers.push_back(mBuiltinTranslatorManager);
     }
     //-----------------------------------------------------------------------
     ScriptCompilerManager::~ScriptCompilerManager()
     {
+        // Root destroys the ResourceGroupManager first
+        if (ResourceGroupManager* rgm = ResourceGroupManager::getSingletonPtr())
+            rgm->removeResourceGroupListener(mImportHashInvalidator.get());
         OGRE_DELETE mBuiltinTranslatorManager;
     }
     //-----------------------------------------------------------------------
@@ -1606,13 +1926,243 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void ScriptCompilerManager::parseScript(DataStreamPtr& stream, const String& groupName)
     {
-        ConcreteNodeListPtr nodes =
-            ScriptParser::parse(ScriptLexer::tokenize(stream->getAsString(), stream->getName()), stream->getName());
+        parsePreparedScript(stream, groupName, prepareScript(stream, groupName));
+    }
+    //-------------------------------------------------------------------------
+    Any ScriptCompilerManager::prepareScript(DataStreamPtr& stream, const String& groupName)
+    {
+        const String& name = stream->getName();
+        String source = stream->getAsString();
+
+        PreparedScript script;
+        script.hash = FastHash(source.data(), source.size(), FastHash(name.data(), name.size()));
+
+        bool cached;
         {
-            // compile is not reentrant
             OGRE_LOCK_AUTO_MUTEX;
+            cached = !mScriptCompiler.getListener() && mScriptCache.find(script.hash) != mScriptCache.end();
+        }
+
+        if(!cached)
+            script.nodes = ScriptParser::parse(ScriptLexer::tokenize(source, name), name);
+        return script;
+    }
+    //-------------------------------------------------------------------------
+    void ScriptCompilerManager::parsePreparedScript(DataStreamPtr& stream, const String& groupName,
+                                                    const Any& prepared)
+    {
+        if (!prepared.has_value())
+        {
+            parseScript(stream, groupName);
+            return;
+        }
+
+        PreparedScript script = any_cast<PreparedScript>(prepared);
+
+        // compile is not reentrant
+        OGRE_LOCK_AUTO_MUTEX;
+        if(!script.nodes)
+        {
+            if(compileFromCache(script.hash, groupName))
+                return;
+
+            // the cache entry turned out to be stale
+            stream->seek(0);
+            script.nodes = ScriptParser::parse(ScriptLexer::tokenize(stream->getAsString(), stream->getName()),
+                                               stream->getName());
+        }
+        compileAndCache(script.hash, script.nodes, groupName);
+    }
+    //-------------------------------------------------------------------------
+    bool ScriptCompilerManager::compileFromCache(uint32 hash, const String& groupName)
+    {
+        auto it = mScriptCache.find(hash);
+        if(it == mScriptCache.end() || mScriptCompiler.getListener())
+            return false;
+
+        for(const auto& import : it->second.imports)
+        {
+            if(getImportHash(import.first, groupName) != import.second)
+                return false;
+        }
+
+        AbstractNodeListPtr ast = mScriptCompiler._deserialiseAST(it->second.ast);
+        if(!ast)
+            return false;
+
+        mScriptCompiler._compile(ast, groupName);
+        mScriptCacheHits++;
+        return true;
+    }
+    //-------------------------------------------------------------------------
+    uint32 ScriptCompilerManager::getImportHash(const String& name, const String& groupName)
+    {
+        auto key = std::make_pair(groupName, name);
+        auto it = mImportHashes.find(key);
+        if(it != mImportHashes.end())
+            return it->second;
+
+        uint32 hash = 0;
+        DataStreamPtr stream = ResourceGroupManager::getSingleton().openResource(name, groupName, NULL, false);
+        if(stream)
+        {
+            String source = stream->getAsString();
+            hash = FastHash(source.data(), source.size());
+        }
+        mImportHashes[key] = hash;
+        return hash;
+    }
+    //-------------------------------------------------------------------------
+    void ScriptCompilerManager::clearImportHashes(const String& groupName)
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+        auto it = mImportHashes.lower_bound(std::make_pair(groupName, BLANKSTRING));
+        while(it != mImportHashes.end() && it->first.first == groupName)
+            it = mImportHashes.erase(it);
+    }
+    //-------------------------------------------------------------------------
+    void ScriptCompilerManager::compileAndCache(uint32 hash, const ConcreteNodeListPtr& nodes,
+                                                const String& groupName)
+    {
+        if(!mSaveScriptsToCache || mScriptCompiler.getListener())
+        {
             mScriptCompiler.compile(nodes, groupName);
+            return;
+        }
+
+        AbstractNodeListPtr ast;
+        ScriptCompiler::ImportHashMap imports;
+        // scripts with errors are not cached, so they get reported again
+        if(!mScriptCompiler._compile(nodes, groupName, ast, imports))
+            return;
+
+        // the imports were just read, so they need no second look when compiling from the cache
+        for (const auto& import : imports)
+            mImportHashes[std::make_pair(groupName, import.first)] = import.second;
+
+        CachedScript& entry = mScriptCache[hash];
+        entry.imports.swap(imports);
+        entry.ast = ScriptCompiler::_serialiseAST(*ast);
+        mScriptCacheDirty = true;
+    }
+    //-------------------------------------------------------------------------
+    void ScriptCompilerManager::saveScriptCache(DataStreamPtr stream) const
+    {
+        if (!mScriptCacheDirty)
+            return;
+
+        if (!stream->isWriteable())
+        {
+            OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE,
+                "Unable to write to stream " + stream->getName(),
+                "ScriptCompilerManager::saveScriptCache");
+        }
+
+        OGRE_LOCK_AUTO_MUTEX;
+        StreamSerialiser serialiser(stream);
+        serialiser.writeChunkBegin(SCRIPT_CACHE_CHUNK_ID, SCRIPT_CACHE_VERSION);
+
+        // header: the AST encoding may change between releases and the entries are only
+        // read if the whole payload is present
+        uint32 ogreVersion = OGRE_VERSION;
+        uint32 numScripts = static_cast<uint32>(mScriptCache.size());
+        uint32 payloadSize = 0;
+        for (const auto& entry : mScriptCache)
+        {
+            payloadSize += sizeof(uint32) * 3;
+            for (const auto& import : entry.second.imports)
+                payloadSize += sizeof(uint32) * 2 + uint32(import.first.size());
+            payloadSize += uint32(entry.second.ast->size());
+        }
+        serialiser.write(&ogreVersion);
+        serialiser.write(&numScripts);
+        serialiser.write(&payloadSize);
+
+        for (const auto& entry : mScriptCache)
+        {
+            serialiser.write(&entry.first);
+
+            uint32 numImports = static_cast<uint32>(entry.second.imports.size());
+            serialiser.write(&numImports);
+            for (const auto& import : entry.second.imports)
+            {
+                serialiser.write(&import.first);
+                serialiser.write(&import.second);
+            }
+
+            const MemoryDataStreamPtr& ast = entry.second.ast;
+            uint32 astLength = static_cast<uint32>(ast->size());
+            serialiser.write(&astLength);
+            serialiser.writeData(ast->getPtr(), 1, astLength);
         }
+
+        serialiser.writeChunkEnd(SCRIPT_CACHE_CHUNK_ID);
+    }
+    //-------------------------------------------------------------------------
+    void ScriptCompilerManager::loadScriptCache(DataStreamPtr stream)
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+        mScriptCache.clear();
+        mImportHashes.clear();
+        mScriptCacheHits = 0;
+        // whatever happens below, the cache on disk does not match ours
+        mScriptCacheDirty = true;
+
+        try
+        {
+            StreamSerialiser serialiser(stream);
+            const StreamSerialiser::Chunk* chunk = serialiser.readChunkBegin();
+            if(chunk->id != SCRIPT_CACHE_CHUNK_ID || chunk->version != SCRIPT_CACHE_VERSION)
+            {
+                LogManager::getSingleton().logWarning("Invalid Script Cache, ignoring it");
+                return;
+            }
+
+            uint32 ogreVersion = 0, numScripts = 0, payloadSize = 0;
+            serialiser.read(&ogreVersion);
+            serialiser.read(&numScripts);
+            serialiser.read(&payloadSize);
+            if(ogreVersion != OGRE_VERSION)
+            {
+                LogManager::getSingleton().logMessage("Script Cache was written by a different Ogre version, ignoring it");
+                return;
+            }
+            if(stream->size() && stream->tell() + payloadSize > stream->size())
+            {
+                LogManager::getSingleton().logWarning("Script Cache is truncated, ignoring it");
+                return;
+            }
+
+            for (uint32 i = 0; i < numScripts; i++)
+            {
+                uint32 hash;
+                serialiser.read(&hash);
+                CachedScript& entry = mScriptCache[hash];
+
+                uint32 numImports = 0;
+                serialiser.read(&numImports);
+                for (uint32 j = 0; j < numImports; j++)
+                {
+                    String name;
+                    serialiser.read(&name);
+                    serialiser.read(&entry.imports[name]);
+                }
+
+                uint32 astLength = 0;
+                serialiser.read(&astLength);
+                entry.ast.reset(OGRE_NEW MemoryDataStream(astLength));
+                serialiser.readData(entry.ast->getPtr(), 1, astLength);
+            }
+            serialiser.readChunkEnd(SCRIPT_CACHE_CHUNK_ID);
+        }
+        catch (const Exception& e)
+        {
+            LogManager::getSingleton().logWarning("Could not load Script Cache: " + e.getDescription());
+            mScriptCache.clear();
+            return;
+        }
+
+        mScriptCacheDirty = false;
     }
 
     //-------------------------------------------------------------------------
@@ -910,6 +910,7 @@ void SceneManager::ShadowRenderer::renderShadowVolumesToStencil(const Light* lig
     }
 
     mDestRenderSystem->unbindGpuProgram(GPT_FRAGMENT_PROGRAM);
+    mSceneManager->mLastProgramsId = 0;
 
     // Can we do a 2-sided stencil?
     bool stencil2sided = false;
@@ -986,6 +987,8 @@ void SceneManager::ShadowRenderer::renderShadowVolumesToStencil(const Light* lig
     mDestRenderSystem->_disableTextureUnitsFrom(0);
     mDestRenderSystem->_setDepthBufferParams(true, false, CMPF_LESS);
     mDestRenderSystem->setStencilCheckEnabled(true);
+    // the states above bypassed the state cache
+    mDestRenderSystem->_invalidateStateCache();
 
     // Figure out the near clip volume
     const PlaneBoundedVolume& nearClipVol =
@@ -1102,6 +1105,7 @@ void SceneManager::ShadowRenderer::renderShadowVolumesToStencil(const Light* lig
                 true, false, false);
             mDestRenderSystem->setColourBlendState(disabled);
             mDestRenderSystem->_setDepthBufferParams(true, false, CMPF_LESS);
+            mDestRenderSystem->_invalidateStateCache();
         }
     }
 
@@ -1110,6 +1114,9 @@ void SceneManager::ShadowRenderer::renderShadowVolumesToStencil(const Light* lig
 
     mDestRenderSystem->unbindGpuProgram(GPT_VERTEX_PROGRAM);
 
+    // the states above were set directly
+    mDestRenderSystem->_invalidateStateCache();
+
     if (scissored == CLIPPED_SOME)
     {
         // disable scissor test
@@ -41,14 +41,16 @@ namespace Ogre {
         : Resource(),
         mNextAutoHandle(0),
         mBlendState(ANIMBLEND_AVERAGE),
-        mManualBonesDirty(false)
+        mManualBonesDirty(false),
+        mBonePaletteCacheFrame(0)
     {
     }
     //---------------------------------------------------------------------
     Skeleton::Skeleton(ResourceManager* creator, const String& name, ResourceHandle handle,
         const String& group, bool isManual, ManualResourceLoader* loader) 
         : Resource(creator, name, handle, group, isManual, loader), 
-        mNextAutoHandle(0), mBlendState(ANIMBLEND_AVERAGE)
+        mNextAutoHandle(0), mBlendState(ANIMBLEND_AVERAGE),
+        mBonePaletteCacheFrame(0)
         // set animation blending to weighted, not cumulative
     {
         if (createParamDictionary("Skeleton"))
@@ -98,6 +100,7 @@ namespace Ogre {
         mRootBones.clear();
         mManualBones.clear();
         mManualBonesDirty = false;
+        mBonePaletteCache.clear();
 
         // Destroy animations
         AnimationList::iterator ai;
@@ -422,6 +425,28 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    const Affine3* Skeleton::_findCachedBoneMatrices(unsigned long frameNumber,
+                                                     const BonePaletteKey& key) const
+    {
+        if (frameNumber != mBonePaletteCacheFrame)
+            return NULL;
+
+        BonePaletteCache::const_iterator i = mBonePaletteCache.find(key);
+        return i != mBonePaletteCache.end() ? i->second.data() : NULL;
+    }
+    //-----------------------------------------------------------------------
+    void Skeleton::_cacheBoneMatrices(unsigned long frameNumber, const BonePaletteKey& key,
+                                      const Affine3* matrices)
+    {
+        if (frameNumber != mBonePaletteCacheFrame)
+        {
+            mBonePaletteCache.clear();
+            mBonePaletteCacheFrame = frameNumber;
+        }
+
+        mBonePaletteCache[key].assign(matrices, matrices + mBoneList.size());
+    }
+    //-----------------------------------------------------------------------
     void Skeleton::_notifyManualBonesDirty(void)
     {
         mManualBonesDirty = true;
@@ -31,6 +31,8 @@ THE SOFTWARE.
 #include "OgreEdgeListBuilder.h"
 #include "OgreLodStrategy.h"
 #include "OgreSubEntity.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
 
@@ -39,6 +41,284 @@ namespace Ogre {
     #define REGION_MAX_INDEX 511
     #define REGION_MIN_INDEX -512
 
+    namespace {
+        typedef StaticGeometry::GeometryBucket GeometryBucket;
+        typedef StaticGeometry::MaterialBucket::GeometryBucketList GeometryBucketList;
+
+        /// Provides the contents of the buffers read by the buckets, reading each buffer once
+        class BakeSources
+        {
+            std::map<HardwareBuffer*, const uchar*> mContents;
+            /// Buffers kept locked until we are done
+            std::vector<HardwareBuffer*> mLocked;
+            /// Copies of the buffers, if they must not stay locked
+            std::vector<std::vector<uchar> > mCopies;
+            bool mCopy;
+
+            const uchar* getContents(HardwareBuffer* buf)
+            {
+                const uchar*& ret = mContents[buf];
+                if (ret)
+                    return ret;
+
+                if (mCopy)
+                {
+                    mCopies.emplace_back(buf->getSizeInBytes());
+                    buf->readData(0, buf->getSizeInBytes(), mCopies.back().data());
+                    ret = mCopies.back().data();
+                }
+                else
+                {
+                    ret = static_cast<const uchar*>(buf->lock(HardwareBuffer::HBL_READ_ONLY));
+                    mLocked.push_back(buf);
+                }
+                return ret;
+            }
+        public:
+            /// @param copy copy the buffers instead of locking them, so they can be used later on
+            explicit BakeSources(bool copy) : mCopy(copy) {}
+            ~BakeSources()
+            {
+                for (auto buf : mLocked)
+                    buf->unlock();
+            }
+
+            /// Get the contents of the buffers of each geometry queued in the bucket
+            std::vector<GeometryBucket::BufferContents> getContents(const GeometryBucket* bucket)
+            {
+                std::vector<GeometryBucket::BufferContents> ret;
+                ushort numBuffers = bucket->getVertexData()->vertexBufferBinding->getBufferCount();
+                for (auto geom : bucket->getQueuedGeometry())
+                {
+                    const IndexData* idx = geom->geometry->indexData;
+                    VertexBufferBinding* binds = geom->geometry->vertexData->vertexBufferBinding;
+
+                    GeometryBucket::BufferContents contents;
+                    contents.push_back(getContents(idx->indexBuffer.get()) +
+                                       idx->indexStart * idx->indexBuffer->getIndexSize());
+                    for (ushort b = 0; b < numBuffers; ++b)
+                        contents.push_back(getContents(binds->getBuffer(b).get()));
+                    ret.push_back(contents);
+                }
+                return ret;
+            }
+        };
+
+        void collectBuckets(const StaticGeometry::Region* region, GeometryBucketList& buckets)
+        {
+            for (auto lod : region->getLODBuckets())
+                for (const auto& mat : lod->getMaterialBuckets())
+                    buckets.insert(buckets.end(), mat.second->getGeometryList().begin(),
+                                   mat.second->getGeometryList().end());
+        }
+
+        /// Bake the buckets, spread over the WorkQueue
+        void bakeBuckets(const GeometryBucketList& buckets)
+        {
+            // read the sources up front, as the buffers can only be locked from this thread
+            BakeSources sources(false);
+            std::vector<std::vector<GeometryBucket::BufferContents> > contents;
+            for (auto b : buckets)
+                contents.push_back(sources.getContents(b));
+
+            auto bake = [&](size_t i) { buckets[i]->_bake(contents[i]); };
+            WorkQueue* wq = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL;
+            if (wq)
+                wq->parallelFor(buckets.size(), bake);
+            else
+            {
+                for (size_t i = 0; i < buckets.size(); ++i)
+                    bake(i);
+            }
+        }
+
+        /** Transform the float3 vectors found at the given stride.
+        @remarks
+            Borrows the skinning routine with a single bone, which uses SIMD where available.
+        */
+        void transformVectors(const uchar* src, uchar* dst, size_t stride, size_t count,
+                              const Affine3& xform, bool normalise)
+        {
+            static const float weight = 1;
+            static const uchar index = 0;
+            const Affine3* matrices[] = {&xform};
+            OptimisedUtil::getImplementation()->softwareVertexSkinning(
+                reinterpret_cast<const float*>(src), reinterpret_cast<float*>(dst), NULL, NULL, &weight,
+                &index, matrices, stride, stride, 0, 0, 0, 0, 1, count);
+
+            if (!normalise)
+                return;
+
+            for (size_t v = 0; v < count; ++v, dst += stride)
+            {
+                float* p = reinterpret_cast<float*>(dst);
+                Vector3 vec(p[0], p[1], p[2]);
+                vec.normalise();
+                p[0] = vec.x;
+                p[1] = vec.y;
+                p[2] = vec.z;
+            }
+        }
+    }
+
+    /** Bakes the regions of StaticGeometry::buildInBackground on the WorkQueue, one request per
+        region, and swaps them in once all are done.
+    */
+    class StaticGeometry::BuildHandler : public WorkQueue::RequestHandler,
+                                         public WorkQueue::ResponseHandler,
+                                         public BatchedGeometryAlloc
+    {
+        /// Bakes the buckets of a region
+        struct Task
+        {
+            BuildHandler* handler;
+            GeometryBucketList buckets;
+            std::vector<std::vector<GeometryBucket::BufferContents> > contents;
+            WorkQueue::RequestID id;
+            // held by the worker thread, so the buckets are never destroyed while baking
+            bool cancelled;
+            OGRE_WQ_MUTEX(mutex);
+        };
+        typedef std::shared_ptr<Task> TaskPtr;
+
+        StaticGeometry* mOwner;
+        /// The regions being built, not in the scene yet
+        RegionMap mRegions;
+        std::vector<TaskPtr> mTasks;
+        size_t mPendingTasks;
+        std::unique_ptr<BakeSources> mSources;
+        bool mStencilShadows;
+        uint16 mChannel;
+
+        void finish()
+        {
+            RegionMap regions;
+            regions.swap(mRegions);
+            mTasks.clear();
+            mSources.reset();
+
+            // the current regions share the names of the new ones, so must go first
+            mOwner->destroy();
+            mOwner->mRegionMap.swap(regions);
+            mOwner->finishBuild(mStencilShadows);
+        }
+    public:
+        BuildHandler(StaticGeometry* owner) : mOwner(owner), mPendingTasks(0), mStencilShadows(false)
+        {
+            WorkQueue* wq = Root::getSingleton().getWorkQueue();
+            mChannel = wq->getChannel("Ogre/StaticGeometryBuild");
+            wq->addRequestHandler(mChannel, this);
+            wq->addResponseHandler(mChannel, this);
+        }
+
+        ~BuildHandler()
+        {
+            cancel();
+            WorkQueue* wq = Root::getSingleton().getWorkQueue();
+            // waits for the running requests
+            wq->removeRequestHandler(mChannel, this);
+            wq->removeResponseHandler(mChannel, this);
+        }
+
+        bool isBuilding() const { return !mTasks.empty(); }
+
+        void request(RegionMap& regions, bool stencilShadows)
+        {
+            cancel();
+            mRegions.swap(regions);
+            mStencilShadows = stencilShadows;
+
+            // copy the sources, so the meshes are free to change meanwhile
+            mSources.reset(new BakeSources(true));
+            for (const auto& r : mRegions)
+            {
+                TaskPtr task = std::make_shared<Task>();
+                task->handler = this;
+                task->id = 0;
+                task->cancelled = false;
+                collectBuckets(r.second, task->buckets);
+                for (auto b : task->buckets)
+                    task->contents.push_back(mSources->getContents(b));
+                mTasks.push_back(task);
+            }
+            mPendingTasks = mTasks.size();
+
+            if (mTasks.empty())
+            {
+                finish();
+                return;
+            }
+
+            // the responses may be processed right away, if the queue is synchronous
+            std::vector<TaskPtr> tasks = mTasks;
+            WorkQueue* wq = Root::getSingleton().getWorkQueue();
+            for (const auto& task : tasks)
+                task->id = wq->addRequest(mChannel, 0, task);
+        }
+
+        void cancel()
+        {
+            WorkQueue* wq = Root::getSingleton().getWorkQueue();
+            for (const auto& task : mTasks)
+            {
+                wq->abortRequest(task->id);
+
+                OGRE_WQ_LOCK_MUTEX(task->mutex);
+                task->cancelled = true;
+            }
+            mTasks.clear();
+            mSources.reset();
+
+            for (const auto& r : mRegions)
+                OGRE_DELETE r.second;
+            mRegions.clear();
+        }
+
+        WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ) override
+        {
+            TaskPtr task = any_cast<TaskPtr>(req->getData());
+            // another StaticGeometry shares the channel
+            if (task->handler != this)
+                return NULL;
+
+            OGRE_WQ_LOCK_MUTEX(task->mutex);
+            if (task->cancelled)
+                return OGRE_NEW WorkQueue::Response(req, false, Any(), "cancelled");
+
+            try
+            {
+                for (size_t i = 0; i < task->buckets.size(); ++i)
+                    task->buckets[i]->_bake(task->contents[i]);
+            }
+            catch (const std::exception& e)
+            {
+                return OGRE_NEW WorkQueue::Response(req, false, Any(), e.what());
+            }
+
+            return OGRE_NEW WorkQueue::Response(req, true, Any());
+        }
+
+        void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ) override
+        {
+            TaskPtr task = any_cast<TaskPtr>(res->getRequest()->getData());
+            // cancelled meanwhile, or belonging to another StaticGeometry
+            if (std::find(mTasks.begin(), mTasks.end(), task) == mTasks.end())
+                return;
+
+            if (!res->succeeded())
+            {
+                // keep the current regions rather than showing a partial build
+                LogManager::getSingleton().logError("StaticGeometry '" + mOwner->getName() +
+                                                    "': build failed - " + res->getMessages());
+                cancel();
+                return;
+            }
+
+            if (--mPendingTasks == 0)
+                finish();
+        }
+    };
+
     //--------------------------------------------------------------------------
     StaticGeometry::StaticGeometry(SceneManager* owner, const String& name):
         mOwner(owner),
@@ -157,8 +437,8 @@ namespace Ogre {
             str << mName << ":" << index;
             // Calculate the region centre
             Vector3 centre = getRegionCentre(x, y, z);
+            // added to the scene once built
             ret = OGRE_NEW Region(this, str.str(), mOwner, index, centre);
-            mOwner->injectMovableObject(ret);
             ret->setVisible(mVisible);
             ret->setCastShadows(mCastShadows);
             if (mRenderQueueIDSet)
@@ -318,6 +598,7 @@ namespace Ogre {
         // Otherwise, we have to create a new one
         SubMeshLodGeometryLinkList* lodList = OGRE_NEW_T(SubMeshLodGeometryLinkList, MEMCATEGORY_GEOMETRY)();
         mSubMeshGeometryLookup[sm] = lodList;
+        sm->parent->loadStreamedLodLevels();
         ushort numLods = sm->parent->hasManualLodLevel() ? 1 :
             sm->parent->getNumLodLevels();
         lodList->resize(numLods);
@@ -509,12 +790,8 @@ namespace Ogre {
         }
     }
     //--------------------------------------------------------------------------
-    void StaticGeometry::build(void)
+    void StaticGeometry::allocateRegions(void)
     {
-        // Make sure there's nothing from previous builds
-        destroy();
-
-        // Firstly allocate meshes to regions
         for (QueuedSubMeshList::iterator qi = mQueuedSubMeshes.begin();
             qi != mQueuedSubMeshes.end(); ++qi)
         {
@@ -522,26 +799,80 @@ namespace Ogre {
             Region* region = getRegion(qsm->worldBounds, true);
             region->assign(qsm);
         }
-        bool stencilShadows = false;
-        if (mCastShadows && mOwner->isShadowTechniqueStencilBased())
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::build(void)
+    {
+        // Make sure there's nothing from previous builds
+        destroy();
+
+        // Firstly allocate meshes to regions
+        allocateRegions();
+        bool stencilShadows = mCastShadows && mOwner->isShadowTechniqueStencilBased();
+
+        // Set up the buckets of each region, then bake all of them at once
+        GeometryBucketList buckets;
+        for (RegionMap::iterator ri = mRegionMap.begin();
+            ri != mRegionMap.end(); ++ri)
         {
-            stencilShadows = true;
+            ri->second->_prepareBuild(stencilShadows);
+            collectBuckets(ri->second, buckets);
         }
+        bakeBuckets(buckets);
+
+        finishBuild(stencilShadows);
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::buildInBackground(void)
+    {
+        if (!mBuildHandler)
+            mBuildHandler.reset(new BuildHandler(this));
 
-        // Now tell each region to build itself
+        // allocate to new regions, while the current ones stay in place
+        RegionMap regions;
+        mRegionMap.swap(regions);
+        allocateRegions();
+        mRegionMap.swap(regions);
+
+        bool stencilShadows = mCastShadows && mOwner->isShadowTechniqueStencilBased();
+        for (RegionMap::iterator ri = regions.begin(); ri != regions.end(); ++ri)
+        {
+            ri->second->_prepareBuild(stencilShadows);
+        }
+
+        mBuildHandler->request(regions, stencilShadows);
+    }
+    //--------------------------------------------------------------------------
+    bool StaticGeometry::isBuilding(void) const
+    {
+        return mBuildHandler && mBuildHandler->isBuilding();
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::finishBuild(bool stencilShadows)
+    {
         for (RegionMap::iterator ri = mRegionMap.begin();
             ri != mRegionMap.end(); ++ri)
         {
-            ri->second->build(stencilShadows);
-            
-            // Set the visibility flags on these regions
-            ri->second->setVisibilityFlags(mVisibilityFlags);
-        }
+            Region* region = ri->second;
+            region->_finishBuild(stencilShadows);
 
+            // the settings may have changed while building in the background
+            region->setVisible(mVisible);
+            region->setCastShadows(mCastShadows);
+            if (mRenderQueueIDSet)
+            {
+                region->setRenderQueueGroup(mRenderQueueID);
+            }
+            region->setVisibilityFlags(mVisibilityFlags);
+        }
     }
     //--------------------------------------------------------------------------
     void StaticGeometry::destroy(void)
     {
+        // drop any pending background build
+        if (mBuildHandler)
+            mBuildHandler->cancel();
+
         // delete the regions
         for (RegionMap::iterator i = mRegionMap.begin();
             i != mRegionMap.end(); ++i)
@@ -770,10 +1101,17 @@ namespace Ogre {
     //--------------------------------------------------------------------------
     void StaticGeometry::Region::build(bool stencilShadows)
     {
-        // Create a node
-        mNode = mSceneMgr->getRootSceneNode()->createChildSceneNode(mName,
-            mCentre);
-        mNode->attachObject(this);
+        _prepareBuild(stencilShadows);
+
+        GeometryBucketList buckets;
+        collectBuckets(this, buckets);
+        bakeBuckets(buckets);
+
+        _finishBuild(stencilShadows);
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::Region::_prepareBuild(bool stencilShadows)
+    {
         // We need to create enough LOD buckets to deal with the highest LOD
         // we encountered in all the meshes queued
         for (ushort lod = 0; lod < mLodValues.size(); ++lod)
@@ -789,12 +1127,26 @@ namespace Ogre {
             {
                 lodBucket->assign(*qi, lod);
             }
-            // now build
-            lodBucket->build(stencilShadows);
-        }
-
 
+            for (const auto& mat : lodBucket->getMaterialBuckets())
+            {
+                mat.second->_prepareBuild(stencilShadows);
+            }
+        }
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::Region::_finishBuild(bool stencilShadows)
+    {
+        mSceneMgr->injectMovableObject(this);
+        // Create a node
+        mNode = mSceneMgr->getRootSceneNode()->createChildSceneNode(mName,
+            mCentre);
+        mNode->attachObject(this);
 
+        for (auto lodBucket : mLodBucketList)
+        {
+            lodBucket->_finishBuild(stencilShadows);
+        }
     }
     //--------------------------------------------------------------------------
     const String& StaticGeometry::Region::getMovableType(void) const
@@ -987,54 +1339,75 @@ namespace Ogre {
     //--------------------------------------------------------------------------
     void StaticGeometry::LODBucket::build(bool stencilShadows)
     {
+        // Just pass this on to child buckets
+        for (MaterialBucketMap::iterator i = mMaterialBucketMap.begin();
+            i != mMaterialBucketMap.end(); ++i)
+        {
+            i->second->build(stencilShadows);
+        }
+
+        if (stencilShadows)
+        {
+            buildEdgeList();
+        }
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::LODBucket::_finishBuild(bool stencilShadows)
+    {
+        for (MaterialBucketMap::iterator i = mMaterialBucketMap.begin();
+            i != mMaterialBucketMap.end(); ++i)
+        {
+            for (GeometryBucket* geom : i->second->getGeometryList())
+            {
+                geom->_upload(stencilShadows);
+            }
+        }
 
+        if (stencilShadows)
+        {
+            buildEdgeList();
+        }
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::LODBucket::buildEdgeList(void)
+    {
         EdgeListBuilder eb;
         size_t vertexSet = 0;
 
-        // Just pass this on to child buckets
         for (MaterialBucketMap::iterator i = mMaterialBucketMap.begin();
             i != mMaterialBucketMap.end(); ++i)
         {
             MaterialBucket* mat = i->second;
 
-            mat->build(stencilShadows);
-
-            if (stencilShadows)
+            // Check if we have vertex programs here
+            Technique* t = mat->getMaterial()->getBestTechnique();
+            if (t)
             {
-                // Check if we have vertex programs here
-                Technique* t = mat->getMaterial()->getBestTechnique();
-                if (t)
+                Pass* p = t->getPass(0);
+                if (p)
                 {
-                    Pass* p = t->getPass(0);
-                    if (p)
+                    if (p->hasVertexProgram())
                     {
-                        if (p->hasVertexProgram())
-                        {
-                            mVertexProgramInUse = true;
-                        }
+                        mVertexProgramInUse = true;
                     }
                 }
+            }
 
-                for (GeometryBucket* geom : mat->getGeometryList())
-                {
-                    // Check we're dealing with 16-bit indexes here
-                    // Since stencil shadows can only deal with 16-bit
-                    // More than that and stencil is probably too CPU-heavy
-                    // in any case
-                    assert(geom->getIndexData()->indexBuffer->getType()
-                        == HardwareIndexBuffer::IT_16BIT &&
-                        "Only 16-bit indexes allowed when using stencil shadows");
-                    eb.addVertexData(geom->getVertexData());
-                    eb.addIndexData(geom->getIndexData(), vertexSet++);
-                }
-
+            for (GeometryBucket* geom : mat->getGeometryList())
+            {
+                // Check we're dealing with 16-bit indexes here
+                // Since stencil shadows can only deal with 16-bit
+                // More than that and stencil is probably too CPU-heavy
+                // in any case
+                assert(geom->getIndexData()->indexBuffer->getType()
+                    == HardwareIndexBuffer::IT_16BIT &&
+                    "Only 16-bit indexes allowed when using stencil shadows");
+                eb.addVertexData(geom->getVertexData());
+                eb.addIndexData(geom->getIndexData(), vertexSet++);
             }
         }
 
-        if (stencilShadows)
-        {
-            mEdgeList = eb.build();
-        }
+        mEdgeList = eb.build();
     }
     //--------------------------------------------------------------------------
     void StaticGeometry::LODBucket::addRenderables(RenderQueue* queue,
@@ -1211,6 +1584,16 @@ namespace Ogre {
         }
     }
     //--------------------------------------------------------------------------
+    void StaticGeometry::MaterialBucket::_prepareBuild(bool stencilShadows)
+    {
+        mTechnique = 0;
+        mMaterial->load();
+        for (auto gb : mGeometryBucketList)
+        {
+            gb->_prepareBuild(stencilShadows);
+        }
+    }
+    //--------------------------------------------------------------------------
     void StaticGeometry::MaterialBucket::addRenderables(RenderQueue* queue,
         uint8 group, Real lodValue)
     {
@@ -1408,6 +1791,13 @@ namespace Ogre {
         }
     }
     void StaticGeometry::GeometryBucket::build(bool stencilShadows)
+    {
+        _prepareBuild(stencilShadows);
+        bakeBuckets(GeometryBucketList(1, this));
+        _upload(stencilShadows);
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::GeometryBucket::_prepareBuild(bool stencilShadows)
     {
         // Need to double the vertex count for the position buffer
         // if we're doing stencil shadows
@@ -1415,159 +1805,124 @@ namespace Ogre {
                    "Index range exceeded when using stencil shadows, consider reducing your region size or "
                    "reducing poly count");
 
-        // Ok, here's where we transfer the vertices and indexes to the shared
-        // buffers
+        // checked here, as baking may run on a worker thread
+        for (const VertexElement& elem : mVertexData->vertexDeclaration->getElements())
+        {
+            VertexElementSemantic sem = elem.getSemantic();
+            if (sem != VES_POSITION && sem != VES_NORMAL && sem != VES_TANGENT && sem != VES_BINORMAL)
+                continue;
+
+            OgreAssert(VertexElement::getBaseType(elem.getType()) == VET_FLOAT1 &&
+                           VertexElement::getTypeCount(elem.getType()) >= 3,
+                       "spatial vertex elements must be float3 or float4");
+        }
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::GeometryBucket::_bake(const std::vector<BufferContents>& sources)
+    {
         // Shortcuts
         VertexDeclaration* dcl = mVertexData->vertexDeclaration;
-        VertexBufferBinding* binds = mVertexData->vertexBufferBinding;
-
-        // create index buffer, and lock
+        ushort numBuffers = mVertexData->vertexBufferBinding->getBufferCount();
         auto indexType = mIndexData->indexBuffer->getType();
-        mIndexData->indexBuffer = HardwareBufferManager::getSingleton()
-            .createIndexBuffer(indexType, mIndexData->indexCount,
-                HardwareBuffer::HBU_STATIC_WRITE_ONLY);
-        HardwareBufferLockGuard dstIndexLock(mIndexData->indexBuffer, HardwareBuffer::HBL_DISCARD);
-        uint32* p32Dest = static_cast<uint32*>(dstIndexLock.pData);
-        uint16* p16Dest = static_cast<uint16*>(dstIndexLock.pData);
-        // create all vertex buffers, and lock
-        ushort b;
-
-        std::vector<uchar*> destBufferLocks;
+
+        // allocate the index buffer, followed by all vertex buffers
+        mBakedBuffers.resize(numBuffers + 1);
+        mBakedBuffers[0].resize(mIndexData->indexCount * mIndexData->indexBuffer->getIndexSize());
+        uint32* p32Dest = reinterpret_cast<uint32*>(mBakedBuffers[0].data());
+        uint16* p16Dest = reinterpret_cast<uint16*>(mBakedBuffers[0].data());
+
+        std::vector<uchar*> pDest;
         std::vector<VertexDeclaration::VertexElementList> bufferElements;
-        for (b = 0; b < binds->getBufferCount(); ++b)
+        for (ushort b = 0; b < numBuffers; ++b)
         {
-            HardwareVertexBufferSharedPtr vbuf =
-                HardwareBufferManager::getSingleton().createVertexBuffer(
-                    dcl->getVertexSize(b),
-                    mVertexData->vertexCount,
-                    HardwareBuffer::HBU_STATIC_WRITE_ONLY);
-            binds->setBinding(b, vbuf);
-            uchar* pLock = static_cast<uchar*>(
-                vbuf->lock(HardwareBuffer::HBL_DISCARD));
-            destBufferLocks.push_back(pLock);
+            mBakedBuffers[b + 1].resize(dcl->getVertexSize(b) * mVertexData->vertexCount);
+            pDest.push_back(mBakedBuffers[b + 1].data());
             // Pre-cache vertex elements per buffer
             bufferElements.push_back(dcl->findElementsBySource(b));
         }
 
-
         // Iterate over the geometry items
         uint32 indexOffset = 0;
-        QueuedGeometryList::iterator gi, giend;
-        giend = mQueuedGeometry.end();
         Vector3 regionCentre = mParent->getParent()->getParent()->getCentre();
-        for (gi = mQueuedGeometry.begin(); gi != giend; ++gi)
+        for (size_t g = 0; g < mQueuedGeometry.size(); ++g)
         {
-            QueuedGeometry* geom = *gi;
+            QueuedGeometry* geom = mQueuedGeometry[g];
+            const BufferContents& src = sources[g];
+
             // Copy indexes across with offset
             IndexData* srcIdxData = geom->geometry->indexData;
-            HardwareBufferLockGuard srcIdxLock(srcIdxData->indexBuffer,
-                                               srcIdxData->indexStart * srcIdxData->indexBuffer->getIndexSize(), 
-                                               srcIdxData->indexCount * srcIdxData->indexBuffer->getIndexSize(),
-                                               HardwareBuffer::HBL_READ_ONLY);
             if (indexType == HardwareIndexBuffer::IT_32BIT)
             {
-                uint32* pSrc = static_cast<uint32*>(srcIdxLock.pData);
-                copyIndexes(pSrc, p32Dest, srcIdxData->indexCount, indexOffset);
+                copyIndexes(reinterpret_cast<const uint32*>(src[0]), p32Dest, srcIdxData->indexCount,
+                            indexOffset);
                 p32Dest += srcIdxData->indexCount;
             }
             else
             {
-                // Lock source indexes
-                uint16* pSrc = static_cast<uint16*>(srcIdxLock.pData);
-                copyIndexes(pSrc, p16Dest, srcIdxData->indexCount, indexOffset);
+                copyIndexes(reinterpret_cast<const uint16*>(src[0]), p16Dest, srcIdxData->indexCount,
+                            indexOffset);
                 p16Dest += srcIdxData->indexCount;
             }
-            srcIdxLock.unlock();
+
+            // Positions are moved relative to the region centre. Directions use the
+            // inverse transpose, which undoes the scale instead of applying it
+            Affine3 pointXform(geom->position - regionCentre, geom->orientation, geom->scale);
+            Affine3 dirXform(Vector3::ZERO, geom->orientation, 1 / geom->scale);
 
             // Now deal with vertex buffers
             // we can rely on buffer counts / formats being the same
-            VertexData* srcVData = geom->geometry->vertexData;
-            VertexBufferBinding* srcBinds = srcVData->vertexBufferBinding;
-            for (b = 0; b < binds->getBufferCount(); ++b)
+            size_t vertexCount = geom->geometry->vertexData->vertexCount;
+            for (ushort b = 0; b < numBuffers; ++b)
             {
-                // lock source
-                HardwareVertexBufferSharedPtr srcBuf = srcBinds->getBuffer(b);
-                HardwareBufferLockGuard srcBufLock(srcBuf, HardwareBuffer::HBL_READ_ONLY);
-                uchar* pSrcBase = static_cast<uchar*>(srcBufLock.pData);
-                // Get buffer lock pointer, we'll update this later
-                uchar* pDstBase = destBufferLocks[b];
-                size_t bufInc = srcBuf->getVertexSize();
-
-                // Iterate over vertices
-                float *pSrcReal, *pDstReal;
-                Vector3 tmp;
-                for (size_t v = 0; v < srcVData->vertexCount; ++v)
-                {
-                    // Iterate over vertex elements
-                    VertexDeclaration::VertexElementList& elems =
-                        bufferElements[b];
-                    VertexDeclaration::VertexElementList::iterator ei;
-                    for (ei = elems.begin(); ei != elems.end(); ++ei)
-                    {
-                        VertexElement& elem = *ei;
-                        elem.baseVertexPointerToElement(pSrcBase, &pSrcReal);
-                        elem.baseVertexPointerToElement(pDstBase, &pDstReal);
-                        switch (elem.getSemantic())
-                        {
-                        case VES_POSITION:
-                            tmp.x = *pSrcReal++;
-                            tmp.y = *pSrcReal++;
-                            tmp.z = *pSrcReal++;
-                            // transform
-                            tmp = (geom->orientation * (tmp * geom->scale)) +
-                                geom->position;
-                            // Adjust for region centre
-                            tmp -= regionCentre;
-                            *pDstReal++ = tmp.x;
-                            *pDstReal++ = tmp.y;
-                            *pDstReal++ = tmp.z;
-                            break;
-                        case VES_NORMAL:
-                        case VES_TANGENT:
-                        case VES_BINORMAL:
-                            tmp.x = *pSrcReal++;
-                            tmp.y = *pSrcReal++;
-                            tmp.z = *pSrcReal++;
-                            // scale (invert)
-                            tmp = tmp / geom->scale;
-                            tmp.normalise();
-                            // rotation
-                            tmp = geom->orientation * tmp;
-                            *pDstReal++ = tmp.x;
-                            *pDstReal++ = tmp.y;
-                            *pDstReal++ = tmp.z;
-                            // copy parity for tangent.
-                            if (elem.getType() == Ogre::VET_FLOAT4)
-                                *pDstReal = *pSrcReal;
-                            break;
-                        default:
-                            // just raw copy
-                            memcpy(pDstReal, pSrcReal,
-                                    VertexElement::getTypeSize(elem.getType()));
-                            break;
-                        };
-
-                    }
-
-                    // Increment both pointers
-                    pDstBase += bufInc;
-                    pSrcBase += bufInc;
+                size_t vertexSize = dcl->getVertexSize(b);
+                const uchar* pSrcBase = src[b + 1];
+                uchar* pDstBase = pDest[b];
 
+                // copy everything raw, then transform the spatial elements in place
+                memcpy(pDstBase, pSrcBase, vertexSize * vertexCount);
+                for (const VertexElement& elem : bufferElements[b])
+                {
+                    VertexElementSemantic sem = elem.getSemantic();
+                    if (sem != VES_POSITION && sem != VES_NORMAL && sem != VES_TANGENT &&
+                        sem != VES_BINORMAL)
+                        continue;
+
+                    // the parity of tangents is left as copied
+                    transformVectors(pSrcBase + elem.getOffset(), pDstBase + elem.getOffset(), vertexSize,
+                                     vertexCount, sem == VES_POSITION ? pointXform : dirXform,
+                                     sem != VES_POSITION);
                 }
 
-                // Update pointer
-                destBufferLocks[b] = pDstBase;
+                pDest[b] += vertexSize * vertexCount;
             }
 
-            indexOffset += geom->geometry->vertexData->vertexCount;
+            indexOffset += vertexCount;
         }
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::GeometryBucket::_upload(bool stencilShadows)
+    {
+        OgreAssert(mBakedBuffers.size() == size_t(mVertexData->vertexBufferBinding->getBufferCount() + 1),
+                   "geometry must be baked first");
 
-        // Unlock everything
-        dstIndexLock.unlock();
-        for (b = 0; b < binds->getBufferCount(); ++b)
+        // Ok, here's where we transfer the vertices and indexes to the shared
+        // buffers
+        auto& hbm = HardwareBufferManager::getSingleton();
+        mIndexData->indexBuffer = hbm.createIndexBuffer(mIndexData->indexBuffer->getType(),
+                                                        mIndexData->indexCount,
+                                                        HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+        mIndexData->indexBuffer->writeData(0, mBakedBuffers[0].size(), mBakedBuffers[0].data(), true);
+
+        VertexDeclaration* dcl = mVertexData->vertexDeclaration;
+        VertexBufferBinding* binds = mVertexData->vertexBufferBinding;
+        for (ushort b = 0; b < binds->getBufferCount(); ++b)
         {
-            binds->getBuffer(b)->unlock();
+            HardwareVertexBufferSharedPtr vbuf = hbm.createVertexBuffer(
+                dcl->getVertexSize(b), mVertexData->vertexCount, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+            vbuf->writeData(0, mBakedBuffers[b + 1].size(), mBakedBuffers[b + 1].data(), true);
+            binds->setBinding(b, vbuf);
         }
+        mBakedBuffers.clear();
 
         if (stencilShadows)
         {
@@ -93,6 +93,10 @@ namespace Ogre {
 
         // tell parent to reconsider material vertex processing options
         mParentEntity->reevaluateVertexProcessing();
+
+        SceneManager* sm = mParentEntity->_getManager();
+        if (sm && sm->_hasRenderRecordings() && mParentEntity->isInScene())
+            sm->_notifySceneChanged(mParentEntity->getWorldBoundingBox(true));
     }
     //-----------------------------------------------------------------------
     Technique* SubEntity::getTechnique(void) const
@@ -38,6 +38,7 @@ namespace Ogre {
         , mVertexAnimationType(VAT_NONE)
         , mVertexAnimationIncludesNormals(false)
         , mBuildEdgesEnabled(true)
+        , mTexelFactor(-1)
     {
         indexData = OGRE_NEW IndexData();
     }
@@ -232,6 +233,68 @@ namespace Ogre {
         }
     };
     //---------------------------------------------------------------------
+    Real SubMesh::_getTexelFactor(void) const
+    {
+        if (mTexelFactor >= 0)
+            return mTexelFactor;
+
+        mTexelFactor = 0;
+
+        const VertexData* vert = useSharedVertices ? parent->sharedVertexData : vertexData;
+        if (!vert || operationType != RenderOperation::OT_TRIANGLE_LIST)
+            return mTexelFactor;
+
+        const VertexElement* poselem = vert->vertexDeclaration->findElementBySemantic(VES_POSITION);
+        const VertexElement* uvelem = vert->vertexDeclaration->findElementBySemantic(VES_TEXTURE_COORDINATES, 0);
+        if (!poselem || !uvelem || poselem->getType() != VET_FLOAT3 || uvelem->getType() != VET_FLOAT2)
+            return mTexelFactor;
+
+        HardwareVertexBufferSharedPtr posbuf = vert->vertexBufferBinding->getBuffer(poselem->getSource());
+        HardwareVertexBufferSharedPtr uvbuf = vert->vertexBufferBinding->getBuffer(uvelem->getSource());
+        HardwareBufferLockGuard posLock(posbuf, HardwareBuffer::HBL_READ_ONLY);
+        HardwareBufferLockGuard uvLock;
+        if (uvbuf != posbuf)
+            uvLock.lock(uvbuf.get(), HardwareBuffer::HBL_READ_ONLY);
+        uint8* posdata = static_cast<uint8*>(posLock.pData);
+        uint8* uvdata = uvbuf != posbuf ? static_cast<uint8*>(uvLock.pData) : posdata;
+
+        HardwareBufferLockGuard indexLock;
+        size_t count = vert->vertexCount;
+        if (indexData->indexCount > 0)
+        {
+            indexLock.lock(indexData->indexBuffer.get(), HardwareBuffer::HBL_READ_ONLY);
+            count = indexData->indexCount;
+        }
+        bool use32bit = indexLock.pData && indexData->indexBuffer->getType() == HardwareIndexBuffer::IT_32BIT;
+
+        Real objectArea = 0, uvArea = 0;
+        for (size_t i = 0; i + 2 < count; i += 3)
+        {
+            Vector3 p[3];
+            Vector2 uv[3];
+            for (int j = 0; j < 3; j++)
+            {
+                size_t idx = vert->vertexStart + i + j;
+                if (use32bit)
+                    idx = static_cast<uint32*>(indexLock.pData)[indexData->indexStart + i + j];
+                else if (indexLock.pData)
+                    idx = static_cast<uint16*>(indexLock.pData)[indexData->indexStart + i + j];
+
+                float* pFloat;
+                poselem->baseVertexPointerToElement(posdata + idx * posbuf->getVertexSize(), &pFloat);
+                p[j] = Vector3(pFloat[0], pFloat[1], pFloat[2]);
+                uvelem->baseVertexPointerToElement(uvdata + idx * uvbuf->getVertexSize(), &pFloat);
+                uv[j] = Vector2(pFloat[0], pFloat[1]);
+            }
+            objectArea += (p[1] - p[0]).crossProduct(p[2] - p[0]).length();
+            uvArea += std::abs((uv[1] - uv[0]).crossProduct(uv[2] - uv[0]));
+        }
+
+        if (uvArea > 0)
+            mTexelFactor = Math::Sqrt(objectArea / uvArea);
+        return mTexelFactor;
+    }
+    //-----------------------------------------------------------------------
     void SubMesh::generateExtremes(size_t count)
     {
         extremityPoints.clear();
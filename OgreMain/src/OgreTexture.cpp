@@ -31,6 +31,34 @@ THE SOFTWARE.
 #include "OgreTexture.h"
 
 namespace Ogre {
+    namespace {
+        /// Replaces the single image without mipmaps by one with a chain of at most numMipmaps levels
+        void generateMipmaps(std::vector<Image>& images, uint32 numMipmaps)
+        {
+            const Image& img = images[0];
+            // the custom mipmaps of the source are used as they are
+            if (img.getNumMipmaps() > 0 || PixelUtil::isCompressed(img.getFormat()))
+                return;
+
+            uint32 width = img.getWidth(), height = img.getHeight();
+            uint32 maxMipmaps = 0;
+            while (std::max(width, height) >> (maxMipmaps + 1))
+                maxMipmaps++;
+            numMipmaps = std::min(numMipmaps, maxMipmaps);
+            if (!numMipmaps)
+                return;
+
+            // swapping the vectors avoids copying the image data
+            std::vector<Image> chain(1);
+            chain[0].create(img.getFormat(), width, height, 1, 1, numMipmaps);
+            PixelUtil::bulkPixelConversion(img.getPixelBox(), chain[0].getPixelBox());
+            // filter each level down from the previous one
+            for (uint32 mip = 1; mip <= numMipmaps; mip++)
+                Image::scale(chain[0].getPixelBox(0, mip - 1), chain[0].getPixelBox(0, mip), Image::FILTER_BILINEAR);
+
+            std::swap(images, chain);
+        }
+    }
     const char* Texture::CUBEMAP_SUFFIXES[] = {"_rt", "_lf", "_up", "_dn", "_fr", "_bk"};
     //--------------------------------------------------------------------------
     Texture::Texture(ResourceManager* creator, const String& name, 
@@ -58,7 +86,11 @@ namespace Ogre {
             mInternalResourcesCreated(false),
             mMipmapsHardwareGenerated(false),
             mHwGamma(false),
-            mTextureType(TEX_TYPE_2D)
+            mTextureType(TEX_TYPE_2D),
+            mMipmapSkip(0),
+            mResidentMipmapSkip(0),
+            mLastVisibleFrame(0),
+            mStreamingPending(false)
     {
         if (createParamDictionary("Texture"))
         {
@@ -204,14 +236,24 @@ namespace Ogre {
 
         // The custom mipmaps in the image clamp the request
         uint32 imageMips = images[0]->getNumMipmaps();
+        // Streamed textures leave out the largest mipmaps of the image
+        uint32 skip = 0;
 
         if(imageMips > 0)
         {
-            mNumMipmaps = mNumRequestedMipmaps = std::min(mNumRequestedMipmaps, imageMips);
+            if (images.size() == 1 && mTextureType == TEX_TYPE_2D)
+                skip = std::min(mMipmapSkip, imageMips);
+
+            mNumRequestedMipmaps = std::min(mNumRequestedMipmaps, imageMips);
+            mNumMipmaps = std::min(mNumRequestedMipmaps, imageMips - skip);
             // Disable flag for auto mip generation
             mUsage &= ~TU_AUTOMIPMAP;
         }
 
+        mMipmapSkip = skip;
+        mWidth = std::max(mWidth >> skip, 1u);
+        mHeight = std::max(mHeight >> skip, 1u);
+
         // Create the texture
         createInternalResources();
         // Check if we're loading one image with multiple faces
@@ -293,7 +335,7 @@ namespace Ogre {
                 else
                 {
                     // Load from faces of images[0]
-                    src = images[0]->getPixelBox(i, mip);
+                    src = images[0]->getPixelBox(i, mip + skip);
                 }
 
                 // Allow reinterpreting luminance as alpha
@@ -355,6 +397,7 @@ namespace Ogre {
     void Texture::unloadImpl(void)
     {
         freeInternalResources();
+        mMipmapSkip = mResidentMipmapSkip = 0;
     }
     //-----------------------------------------------------------------------------   
     void Texture::copyToTexture( TexturePtr& target )
@@ -433,8 +476,12 @@ namespace Ogre {
         DataStreamPtr dstream = ResourceGroupManager::getSingleton().openResource(name, mGroup, this);
 
         imgs.push_back(Image());
-        Image& img = imgs.back();
-        img.load(dstream, ext);
+        decodeImage(imgs.back(), dstream, ext, haveNPOT);
+    }
+
+    void Texture::decodeImage(Image& img, const DataStreamPtr& stream, const String& ext, bool haveNPOT)
+    {
+        img.load(stream, ext);
 
         if( haveNPOT )
             return;
@@ -492,11 +539,43 @@ namespace Ogre {
                 throw; // rethrow
         }
 
-        // read sub-images
+        // read sub-images into memory, then decode them in parallel
+        std::vector<DataStreamPtr> streams;
+        std::vector<String> exts;
         for(const String& name : mLayerNames)
         {
             StringUtil::splitBaseFilename(name, baseName, ext);
-            readImage(loadedImages, name, ext, haveNPOT);
+            DataStreamPtr stream = ResourceGroupManager::getSingleton().openResource(name, mGroup, this);
+            streams.push_back(std::make_shared<MemoryDataStream>(stream));
+            exts.push_back(ext);
+        }
+
+        size_t first = loadedImages.size();
+        loadedImages.resize(first + streams.size());
+        std::vector<std::exception_ptr> errors(streams.size());
+        auto decodeLayer = [&](size_t i) {
+            try
+            {
+                decodeImage(loadedImages[first + i], streams[i], exts[i], haveNPOT);
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        };
+
+        if (WorkQueue* wq = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL)
+            wq->parallelFor(streams.size(), decodeLayer);
+        else
+        {
+            for (size_t i = 0; i < streams.size(); ++i)
+                decodeLayer(i);
+        }
+
+        for (const auto& e : errors)
+        {
+            if (e)
+                std::rethrow_exception(e);
         }
 
         // If compressed and 0 custom mipmap, disable auto mip generation and
@@ -510,6 +589,13 @@ namespace Ogre {
             mUsage &= ~TU_AUTOMIPMAP;
         }
 
+        // Streaming needs the mipmaps in the image, so generate them in software if it has none
+        if (TextureManager::getSingleton().getStreamingResidentSize() && loadedImages.size() == 1 &&
+            mTextureType == TEX_TYPE_2D && mNumRequestedMipmaps > 0)
+        {
+            generateMipmaps(loadedImages, mNumRequestedMipmaps);
+        }
+
         // avoid copying Image data
         std::swap(mLoadedImages, loadedImages);
     }
@@ -541,6 +627,75 @@ namespace Ogre {
             imagePtrs.push_back(&loadedImages[i]);
         }
 
+        // Only upload the mipmaps up to the resident size, if streaming. The others are decoded
+        // again when needed, so the image is not kept.
+        mMipmapSkip = mResidentMipmapSkip = 0;
+        uint32 residentSize = TextureManager::getSingleton().getStreamingResidentSize();
+        if (residentSize && mCreator && loadedImages.size() == 1 && mTextureType == TEX_TYPE_2D)
+        {
+            const Image& img = loadedImages[0];
+            uint32 size = std::max(img.getWidth(), img.getHeight());
+            while (mResidentMipmapSkip < img.getNumMipmaps() && (size >> mResidentMipmapSkip) > residentSize)
+                mResidentMipmapSkip++;
+            mMipmapSkip = mResidentMipmapSkip;
+        }
+
         _loadImages(imagePtrs);
     }
+
+    void Texture::_notifyRequiredSize(uint32 texels)
+    {
+        // only managed textures have a source to stream from
+        if (!mResidentMipmapSkip || !mCreator)
+            return;
+
+        mLastVisibleFrame = Root::getSingleton().getNextFrameNumber();
+
+        if (mStreamingPending || !isLoaded())
+            return;
+
+        uint32 skip = mMipmapSkip;
+        uint32 size = std::max(mSrcWidth, mSrcHeight);
+        while (skip > 0 && (size >> skip) < texels)
+            skip--;
+
+        if (skip < mMipmapSkip)
+        {
+            mStreamingPending = true;
+            static_cast<TextureManager*>(mCreator)->_requestStreaming(this, skip);
+        }
+    }
+
+    void Texture::_streamMipmaps(const Image& source, uint32 mipmapSkip)
+    {
+        mStreamingPending = false;
+        if (!isLoaded() || !mResidentMipmapSkip || mipmapSkip == mMipmapSkip)
+            return;
+
+        OGRE_LOCK_AUTO_MUTEX;
+        // keep the memory usage of the manager in sync with the new size
+        if (mCreator)
+            mCreator->_notifyResourceUnloaded(this);
+
+        freeInternalResources();
+        mMipmapSkip = mipmapSkip;
+        _loadImages(ConstImagePtrList(1, &source));
+
+        if (mCreator)
+            mCreator->_notifyResourceLoaded(this);
+    }
+
+    void Texture::decodeStreamingSource(LoadedImages& images, const DataStreamPtr& stream, const String& ext,
+                                        uint32 width, uint32 height, uint32 numMipmaps)
+    {
+        images.resize(1);
+        Image& img = images[0];
+        img.load(stream, ext);
+
+        // scaled to a power of two on loading, if the render system needed that
+        if (img.getNumMipmaps() == 0 && (img.getWidth() != width || img.getHeight() != height))
+            img.resize(width, height);
+
+        generateMipmaps(images, numMipmaps);
+    }
 }
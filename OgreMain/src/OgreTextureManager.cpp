@@ -27,8 +27,96 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 #include "OgrePixelFormat.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
+    namespace
+    {
+        struct TextureStreamingRequest
+        {
+            TexturePtr texture;
+            uint32 mipmapSkip;
+            size_t stateCount;
+            uint32 width;
+            uint32 height;
+            uint32 numMipmaps;
+            String ext;
+        };
+
+        struct TextureStreamingResponse
+        {
+            TexturePtr texture;
+            uint32 mipmapSkip;
+            size_t stateCount;
+            SharedPtr<std::vector<Image> > images;
+        };
+    }
+    /// decodes the source images of streamed textures on the WorkQueue
+    class TextureManager::StreamingHandler : public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler
+    {
+        TextureManager* mManager;
+        uint16 mChannel;
+    public:
+        StreamingHandler(TextureManager* manager) : mManager(manager)
+        {
+            WorkQueue* wq = Root::getSingleton().getWorkQueue();
+            mChannel = wq->getChannel("Ogre/TextureStreaming");
+            wq->addRequestHandler(mChannel, this);
+            wq->addResponseHandler(mChannel, this);
+        }
+
+        ~StreamingHandler()
+        {
+            if (!Root::getSingletonPtr())
+                return;
+            WorkQueue* wq = Root::getSingleton().getWorkQueue();
+            wq->abortRequestsByChannel(mChannel);
+            wq->removeRequestHandler(mChannel, this);
+            wq->removeResponseHandler(mChannel, this);
+        }
+
+        void request(const TextureStreamingRequest& req)
+        {
+            Root::getSingleton().getWorkQueue()->addRequest(mChannel, 0, req);
+        }
+
+        WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ) override
+        {
+            TextureStreamingRequest sreq = any_cast<TextureStreamingRequest>(req->getData());
+            TextureStreamingResponse sres = {sreq.texture, sreq.mipmapSkip, sreq.stateCount,
+                                             std::make_shared<std::vector<Image> >()};
+
+            try
+            {
+                DataStreamPtr stream = ResourceGroupManager::getSingleton().openResource(
+                    sreq.texture->getName(), sreq.texture->getGroup(), sreq.texture.get());
+                Texture::decodeStreamingSource(*sres.images, stream, sreq.ext, sreq.width, sreq.height,
+                                               sreq.numMipmaps);
+            }
+            catch (const Exception& e)
+            {
+                return OGRE_NEW WorkQueue::Response(req, false, sres, e.getFullDescription());
+            }
+
+            return OGRE_NEW WorkQueue::Response(req, true, sres);
+        }
+
+        void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ) override
+        {
+            TextureStreamingResponse sres = any_cast<TextureStreamingResponse>(res->getData());
+            if (!res->succeeded())
+            {
+                // the texture stays at its previous mipmaps
+                sres.texture->mStreamingPending = false;
+                LogManager::getSingleton().logError("Streaming texture '" + sres.texture->getName() +
+                                                    "' failed: " + res->getMessages());
+                return;
+            }
+
+            // uploaded at the end of the frame, see _updateStreaming
+            mManager->mStreamedImages.push_back({sres.texture, sres.mipmapSkip, sres.stateCount, sres.images});
+        }
+    };
     //-----------------------------------------------------------------------
     template<> TextureManager* Singleton<TextureManager>::msSingleton = 0;
     TextureManager* TextureManager::getSingletonPtr(void)
@@ -44,6 +132,9 @@ namespace Ogre {
          : mPreferredIntegerBitDepth(0)
          , mPreferredFloatBitDepth(0)
          , mDefaultNumMipmaps(MIP_UNLIMITED)
+         , mStreamingResidentSize(0)
+         , mStreamingBudget(0)
+         , mStreamingUploadBudget(0)
     {
         mResourceType = "Texture";
         mLoadOrder = 75.0f;
@@ -54,6 +145,8 @@ namespace Ogre {
     TextureManager::~TextureManager()
     {
         // subclasses should unregister with resource group manager
+        mStreamingHandler.reset();
+        mStreamedImages.clear();
 
     }
     SamplerPtr TextureManager::createSampler(const String& name)
@@ -307,6 +400,103 @@ namespace Ogre {
         mDefaultNumMipmaps = num;
     }
     //-----------------------------------------------------------------------
+    void TextureManager::_requestStreaming(Texture* texture, uint32 mipmapSkip)
+    {
+        TexturePtr tex = static_pointer_cast<Texture>(getByHandle(texture->getHandle()));
+        if (!tex)
+        {
+            texture->mStreamingPending = false;
+            return;
+        }
+
+        String baseName, ext;
+        StringUtil::splitBaseFilename(tex->getName(), baseName, ext);
+
+        if (!mStreamingHandler)
+            mStreamingHandler.reset(new StreamingHandler(this));
+        mStreamingHandler->request({tex, mipmapSkip, tex->getStateCount(), tex->getSrcWidth(), tex->getSrcHeight(),
+                                    tex->mNumRequestedMipmaps, ext});
+    }
+    //-----------------------------------------------------------------------
+    void TextureManager::_updateStreaming()
+    {
+        if (mStreamedImages.empty())
+            return;
+
+        size_t uploaded = 0;
+        size_t count = 0;
+        for (; count < mStreamedImages.size(); count++)
+        {
+            if (mStreamingUploadBudget && count > 0 && uploaded >= mStreamingUploadBudget)
+                break;
+
+            const StreamedImage& img = mStreamedImages[count];
+            // the texture might have been reloaded or unloaded meanwhile
+            if (!img.texture->isLoaded() || img.texture->getStateCount() != img.stateCount)
+            {
+                img.texture->mStreamingPending = false;
+                continue;
+            }
+
+            try
+            {
+                img.texture->_streamMipmaps(img.images->front(), img.mipmapSkip);
+                uploaded += img.texture->getSize();
+            }
+            catch (const Exception& e)
+            {
+                img.texture->mStreamingPending = false;
+                LogManager::getSingleton().logError("Streaming texture '" + img.texture->getName() +
+                                                    "' failed: " + e.getDescription());
+            }
+        }
+        mStreamedImages.erase(mStreamedImages.begin(), mStreamedImages.begin() + count);
+
+        enforceStreamingBudget();
+    }
+    //-----------------------------------------------------------------------
+    void TextureManager::enforceStreamingBudget()
+    {
+        if (!mStreamingBudget)
+            return;
+
+        std::vector<Texture*> streamed;
+        size_t total = 0;
+        {
+            OGRE_LOCK_AUTO_MUTEX;
+            for (const auto& r : mResourcesByHandle)
+            {
+                auto tex = static_cast<Texture*>(r.second.get());
+                if (tex->isLoaded() && !tex->mStreamingPending && tex->mMipmapSkip < tex->mResidentMipmapSkip)
+                {
+                    streamed.push_back(tex);
+                    total += tex->getSize();
+                }
+            }
+        }
+
+        if (total <= mStreamingBudget)
+            return;
+
+        // evict the least recently seen textures first, but never the ones on screen right now
+        std::sort(streamed.begin(), streamed.end(), [](const Texture* a, const Texture* b) {
+            return a->mLastVisibleFrame < b->mLastVisibleFrame;
+        });
+
+        // called at the end of the frame, when the frame number has already been advanced
+        unsigned long frame = Root::getSingleton().getNextFrameNumber() - 1;
+        for (auto tex : streamed)
+        {
+            if (total <= mStreamingBudget || tex->mLastVisibleFrame == frame)
+                break;
+
+            // decoded again on the WorkQueue, as the image is not kept
+            total -= tex->getSize();
+            tex->mStreamingPending = true;
+            _requestStreaming(tex, tex->mResidentMipmapSkip);
+        }
+    }
+    //-----------------------------------------------------------------------
     bool TextureManager::isFormatSupported(TextureType ttype, PixelFormat format, int usage)
     {
         return getNativeFormat(ttype, format, usage) == format;
@@ -214,6 +214,22 @@ namespace Ogre
             return false;
     }
     //-----------------------------------------------------------------------
+    bool UnifiedHighLevelGpuProgram::isInstancingIncluded(void) const
+    {
+        if (_getDelegate())
+            return _getDelegate()->isInstancingIncluded();
+        else
+            return false;
+    }
+    //-----------------------------------------------------------------------
+    int UnifiedHighLevelGpuProgram::getInstancingTexCoordIndex(void) const
+    {
+        if (_getDelegate())
+            return _getDelegate()->getInstancingTexCoordIndex();
+        else
+            return -1;
+    }
+    //-----------------------------------------------------------------------
     const GpuProgramParametersPtr& UnifiedHighLevelGpuProgram::getDefaultParameters(void)
     {
         if (_getDelegate())
@@ -93,6 +93,20 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void Viewport::setRenderRecordingEnabled(bool enabled)
+    {
+        if (enabled == getRenderRecordingEnabled())
+            return;
+
+        mRenderRecording.reset(enabled ? new RenderCommandList() : NULL);
+    }
+    //---------------------------------------------------------------------
+    void Viewport::invalidateRenderRecording(void)
+    {
+        if (mRenderRecording)
+            mRenderRecording->valid = false;
+    }
+    //---------------------------------------------------------------------
     bool Viewport::_isUpdated(void) const
     {
         return mUpdated;
@@ -30,6 +30,52 @@ THE SOFTWARE.
 #include "OgreTimer.h"
 
 namespace Ogre {
+    namespace {
+        /// State shared between the threads taking part in a parallelFor
+        struct ParallelForTask
+        {
+            std::function<void(size_t)> func;
+            size_t count;
+            /// Number of indices claimed at once
+            size_t grain;
+            std::atomic<size_t> next;
+            std::atomic<size_t> done;
+            /// First exception thrown by func, rethrown on the calling thread
+            std::exception_ptr error;
+            std::atomic<bool> failed;
+            OGRE_WQ_MUTEX(errorMutex);
+
+            ParallelForTask(size_t c, size_t g, const std::function<void(size_t)>& f)
+                : func(f), count(c), grain(g), next(0), done(0), failed(false) {}
+
+            void run()
+            {
+                size_t begin;
+                while ((begin = next.fetch_add(grain)) < count)
+                {
+                    size_t end = std::min(begin + grain, count);
+                    // once func has thrown, the remaining chunks are only counted as done
+                    if (!failed)
+                    {
+                        try
+                        {
+                            for (size_t i = begin; i < end; ++i)
+                                func(i);
+                        }
+                        catch (...)
+                        {
+                            OGRE_WQ_LOCK_MUTEX(errorMutex);
+                            if (!error)
+                                error = std::current_exception();
+                            failed = true;
+                        }
+                    }
+                    done += end - begin;
+                }
+            }
+        };
+        typedef SharedPtr<ParallelForTask> ParallelForTaskPtr;
+    }
     //---------------------------------------------------------------------
     uint16 WorkQueue::getChannel(const String& channelName)
     {
@@ -43,8 +89,16 @@ namespace Ogre {
         return i->second;
     }
     //---------------------------------------------------------------------
-    WorkQueue::Request::Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid)
-        : mChannel(channel), mType(rtype), mData(rData), mRetryCount(retry), mID(rid), mAborted(false)
+    void WorkQueue::parallelFor(size_t count, const std::function<void(size_t)>& func)
+    {
+        for (size_t i = 0; i < count; ++i)
+            func(i);
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::Request::Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid,
+                                int channelPriority, int priority)
+        : mChannel(channel), mType(rtype), mData(rData), mRetryCount(retry), mID(rid), mAborted(false),
+          mChannelPriority(channelPriority), mPriority(priority)
     {
 
     }
@@ -81,6 +135,10 @@ namespace Ogre {
         , mIdleThreadRunning(false)
         , mIdleProcessed(0)
     {
+        mParallelForChannel = getChannel("Ogre/ParallelFor");
+        addRequestHandler(mParallelForChannel, &mParallelForHandler);
+        // the caller of parallelFor is blocked until its helpers are done
+        setChannelPriority(mParallelForChannel, std::numeric_limits<int>::max());
     }
     //---------------------------------------------------------------------
     const String& DefaultWorkQueueBase::getName() const
@@ -98,6 +156,22 @@ namespace Ogre {
         mWorkerThreadCount = c;
     }
     //---------------------------------------------------------------------
+    void DefaultWorkQueueBase::setChannelPriority(uint16 channel, int priority)
+    {
+            OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+
+        if (mChannelPriorities.size() <= channel)
+            mChannelPriorities.resize(channel + 1, 0);
+        mChannelPriorities[channel] = priority;
+    }
+    //---------------------------------------------------------------------
+    int DefaultWorkQueueBase::getChannelPriority(uint16 channel) const
+    {
+            OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+
+        return channel < mChannelPriorities.size() ? mChannelPriorities[channel] : 0;
+    }
+    //---------------------------------------------------------------------
     bool DefaultWorkQueueBase::getWorkersCanAccessRenderSystem() const
     {
         return mWorkerRenderSystemAccess;
@@ -125,6 +199,43 @@ namespace Ogre {
         mResponseQueue.clear();
     }
     //---------------------------------------------------------------------
+    void DefaultWorkQueueBase::parallelFor(size_t count, const std::function<void(size_t)>& func)
+    {
+        size_t numHelpers = std::min(mWorkerThreadCount, count ? count - 1 : 0);
+#if OGRE_THREAD_SUPPORT
+        if (!mIsRunning || mPaused || !mAcceptRequests)
+#endif
+            numHelpers = 0;
+
+        if (!numHelpers)
+        {
+            WorkQueue::parallelFor(count, func);
+            return;
+        }
+
+        // a few chunks per thread, so that threads finishing early can take over work
+        size_t grain = std::max<size_t>(1, count / ((numHelpers + 1) * 4));
+        ParallelForTaskPtr task = std::make_shared<ParallelForTask>(count, grain, func);
+        for (size_t i = 0; i < numHelpers; ++i)
+            addRequest(mParallelForChannel, 0, task);
+
+        // Don't wait for the workers to wake up, they only help with what is left.
+        // Late requests find nothing to do and return immediately.
+        task->run();
+        while (task->done < count)
+            OGRE_THREAD_YIELD;
+
+        if (task->error)
+            std::rethrow_exception(task->error);
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::Response* DefaultWorkQueueBase::ParallelForHandler::handleRequest(const Request* req,
+                                                                              const WorkQueue* srcQ)
+    {
+        any_cast<ParallelForTaskPtr>(req->getData())->run();
+        return OGRE_NEW Response(req, true, Any());
+    }
+    //---------------------------------------------------------------------
     void DefaultWorkQueueBase::addRequestHandler(uint16 channel, RequestHandler* rh)
     {
             OGRE_WQ_LOCK_RW_MUTEX_WRITE(mRequestHandlerMutex);
@@ -194,7 +305,7 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     WorkQueue::RequestID DefaultWorkQueueBase::addRequest(uint16 channel, uint16 requestType, 
-        const Any& rData, uint8 retryCount, bool forceSynchronous, bool idleThread)
+        const Any& rData, uint8 retryCount, bool forceSynchronous, bool idleThread, int priority)
     {
         Request* req = 0;
         RequestID rid = 0;
@@ -207,7 +318,8 @@ namespace Ogre {
                 return 0;
 
             rid = ++mRequestCount;
-            req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid);
+            req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid, getChannelPriority(channel),
+                                   priority);
 
             LogManager::getSingleton().stream(LML_TRIVIAL) << 
                 "DefaultWorkQueueBase('" << mName << "') - QUEUED(thread:" <<
@@ -217,7 +329,7 @@ namespace Ogre {
 #if OGRE_THREAD_SUPPORT
             if (!forceSynchronous&& !idleThread)
             {
-                mRequestQueue.push_back(req);
+                queueRequest(req);
                 notifyWorkers();
                 return rid;
             }
@@ -238,7 +350,7 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     void DefaultWorkQueueBase::addRequestWithRID(WorkQueue::RequestID rid, uint16 channel, 
-        uint16 requestType, const Any& rData, uint8 retryCount)
+        uint16 requestType, const Any& rData, uint8 retryCount, int priority)
     {
         // lock to push request to the queue
             OGRE_WQ_LOCK_MUTEX(mRequestMutex);
@@ -246,7 +358,8 @@ namespace Ogre {
         if (mShuttingDown)
             return;
 
-        Request* req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid);
+        Request* req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid, getChannelPriority(channel),
+                                        priority);
 
         LogManager::getSingleton().stream(LML_TRIVIAL) << 
             "DefaultWorkQueueBase('" << mName << "') - REQUEUED(thread:" <<
@@ -254,13 +367,29 @@ namespace Ogre {
             << "): ID=" << rid
                    << " channel=" << channel << " requestType=" << requestType;
 #if OGRE_THREAD_SUPPORT
-        mRequestQueue.push_back(req);
+        queueRequest(req);
         notifyWorkers();
 #else
         processRequestResponse(req, true);
 #endif
     }
     //---------------------------------------------------------------------
+    void DefaultWorkQueueBase::queueRequest(Request* req)
+    {
+        // the channel priority decides first, then the priority of the request
+        auto before = [](const Request* a, const Request* b) {
+            if (a->getChannelPriority() != b->getChannelPriority())
+                return a->getChannelPriority() > b->getChannelPriority();
+            return a->getPriority() > b->getPriority();
+        };
+
+        // common case: same priority as everything pending, just append
+        RequestQueue::iterator pos = mRequestQueue.end();
+        if (!mRequestQueue.empty() && before(req, mRequestQueue.back()))
+            pos = std::upper_bound(mRequestQueue.begin(), mRequestQueue.end(), req, before);
+        mRequestQueue.insert(pos, req);
+    }
+    //---------------------------------------------------------------------
     void DefaultWorkQueueBase::abortRequest(RequestID id)
     {
             OGRE_WQ_LOCK_MUTEX(mProcessMutex);
@@ -552,7 +681,7 @@ namespace Ogre {
                 if (req->getRetryCount())
                 {
                     addRequestWithRID(req->getID(), req->getChannel(), req->getType(), req->getData(), 
-                        req->getRetryCount() - 1);
+                        req->getRetryCount() - 1, req->getPriority());
                     // discard response (this also deletes request)
                     OGRE_DELETE response;
                     return;
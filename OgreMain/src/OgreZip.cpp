@@ -29,6 +29,9 @@ THE SOFTWARE.
 
 #if OGRE_NO_ZIP_ARCHIVE == 0
 #include <zip.h>
+// only the declarations, the implementation is compiled as part of zip.c
+#define MINIZ_HEADER_FILE_ONLY
+#include <miniz.h>
 
 namespace Ogre {
 namespace {
@@ -38,6 +41,10 @@ namespace {
         /// Handle to root zip file
         zip_t* mZipFile;
         MemoryDataStreamPtr mBuffer;
+        /// Set if mBuffer maps the archive file, allowing stored entries to be accessed in place
+        SharedPtr<MemoryMappedDataStream> mMappedBuffer;
+        /// Reader on mMappedBuffer to look up where stored entries are, as zip.h does not expose that
+        mutable mz_zip_archive mMappedZip;
         /// File list (since zziplib seems to only allow scanning of dir tree once)
         FileInfoList mFileList;
         OGRE_AUTO_MUTEX;
@@ -81,6 +88,31 @@ namespace {
         /// @copydoc Archive::getModifiedTime
         time_t getModifiedTime(const String& filename) const;
     };
+
+    /// Offset of the data of a stored (uncompressed) entry in the archive,
+    /// or -1 if the entry is compressed, encrypted or the archive is damaged
+    int64 storedEntryOffset(mz_zip_archive* zip, const uchar* archive, size_t size, int index)
+    {
+        // see the local file header in the zip APPNOTE
+        const size_t LOCAL_HEADER_SIZE = 30;
+        const uint32 LOCAL_HEADER_SIGNATURE = 0x04034b50;
+
+        mz_zip_archive_file_stat stat;
+        if (index < 0 || !mz_zip_reader_file_stat(zip, mz_uint(index), &stat) || stat.m_method != 0 ||
+            (stat.m_bit_flag & (1 | 32)) || stat.m_local_header_ofs + LOCAL_HEADER_SIZE > size)
+            return -1;
+
+        const uchar* header = archive + stat.m_local_header_ofs;
+        auto readLE16 = [header](size_t ofs) { return uint32(header[ofs]) | uint32(header[ofs + 1]) << 8; };
+        if ((readLE16(0) | readLE16(2) << 16) != LOCAL_HEADER_SIGNATURE)
+            return -1;
+
+        // the data follows the local header, which has its own extra field
+        uint64 offset = stat.m_local_header_ofs + LOCAL_HEADER_SIZE + readLE16(26) + readLE16(28);
+        if (offset + stat.m_comp_size > size)
+            return -1;
+        return int64(offset);
+    }
 }
     //-----------------------------------------------------------------------
     ZipArchive::ZipArchive(const String& name, const String& archType, const uint8* externBuf, size_t externBufSz)
@@ -101,7 +133,18 @@ namespace {
         if (!mZipFile)
         {
             if(!mBuffer)
-                mBuffer.reset(new MemoryDataStream(_openFileStream(mName, std::ios::binary)));
+            {
+                mMappedBuffer = MemoryMappedDataStream::open(mName, "", MemoryMappedDataStream::getMinMappedSize());
+                if(mMappedBuffer)
+                {
+                    mBuffer = mMappedBuffer;
+                    memset(&mMappedZip, 0, sizeof(mMappedZip));
+                    if(!mz_zip_reader_init_mem(&mMappedZip, mBuffer->getPtr(), mBuffer->size(), 0))
+                        mMappedBuffer.reset();
+                }
+                else
+                    mBuffer.reset(new MemoryDataStream(_openFileStream(mName, std::ios::binary)));
+            }
 
             mZipFile = zip_open_stream((const char*)mBuffer->getPtr(), mBuffer->size());
 
@@ -150,6 +193,9 @@ namespace {
             mZipFile = 0;
             mFileList.clear();
             mBuffer.reset();
+            if(mMappedBuffer)
+                mz_zip_reader_end(&mMappedZip);
+            mMappedBuffer.reset();
         }
     
     }
@@ -181,6 +227,18 @@ namespace {
             OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "could not open "+lookUpFileName);
         }
 
+        // Stored entries of a mapped archive need no extraction
+        int64 storedOffset = mMappedBuffer ? storedEntryOffset(&mMappedZip, mMappedBuffer->getPtr(),
+                                                               mMappedBuffer->size(), zip_entry_index(mZipFile))
+                                           : -1;
+        if(storedOffset >= 0)
+        {
+            auto ret = std::make_shared<MemoryMappedDataStream>(lookUpFileName, *mMappedBuffer, size_t(storedOffset),
+                                                                zip_entry_size(mZipFile));
+            zip_entry_close(mZipFile);
+            return ret;
+        }
+
         // Construct & return stream
         auto ret = std::make_shared<MemoryDataStream>(zip_entry_size(mZipFile));
 
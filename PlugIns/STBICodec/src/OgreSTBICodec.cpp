@@ -170,11 +170,25 @@ namespace Ogre {
     //---------------------------------------------------------------------
     ImageCodec::DecodeResult STBIImageCodec::decode(const DataStreamPtr& input) const
     {
-        String contents = input->getAsString();
+        String contents;
+        const uchar* data;
+        size_t size;
+        if (auto memory = dynamic_cast<MemoryDataStream*>(input.get()))
+        {
+            // decode in place, e.g. from a memory mapped file
+            data = memory->getCurrentPtr();
+            size = memory->size() - memory->tell();
+            memory->skip(long(size));
+        }
+        else
+        {
+            contents = input->getAsString();
+            data = (const uchar*)contents.data();
+            size = contents.size();
+        }
 
         int width, height, components;
-        stbi_uc* pixelData = stbi_load_from_memory((const uchar*)contents.data(),
-                static_cast<int>(contents.size()), &width, &height, &components, 0);
+        stbi_uc* pixelData = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &components, 0);
 
         if (!pixelData)
         {
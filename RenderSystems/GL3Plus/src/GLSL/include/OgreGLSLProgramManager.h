@@ -58,6 +58,9 @@ namespace Ogre {
 
         GL3PlusRenderSystem* mRenderSystem;
 
+        /// the default uniform blocks of all shaders are streamed through this
+        std::unique_ptr<UniformBufferRing> mUniformBufferRing;
+
         /** Find the data source definition for a given uniform name
             and reference. Return true if found and pair the reference
             with its data source. */
@@ -93,6 +96,9 @@ namespace Ogre {
 
         GL3PlusStateCacheManager* getStateCacheManager();
 
+        /// Returns the ring the default uniform blocks are written to
+        UniformBufferRing* getUniformBufferRing();
+
         static GLSLProgramManager& getSingleton(void);
         static GLSLProgramManager* getSingletonPtr(void);
     };
@@ -67,6 +67,18 @@ namespace Ogre {
         return mRenderSystem->_getStateCacheManager();
     }
 
+    UniformBufferRing* GLSLProgramManager::getUniformBufferRing()
+    {
+        if (!mUniformBufferRing)
+        {
+            GLint alignment = 0;
+            OGRE_CHECK_GL_ERROR(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment));
+            // room for a few frames worth of per draw constants
+            mUniformBufferRing.reset(new UniformBufferRing(4 * 1024 * 1024, alignment));
+        }
+        return mUniformBufferRing.get();
+    }
+
     GLSLProgram* GLSLProgramManager::getActiveProgram(void)
     {
         // If there is an active link program then return it.
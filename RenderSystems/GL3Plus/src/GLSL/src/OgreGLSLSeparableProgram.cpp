@@ -35,6 +35,7 @@
 #include "OgreLogManager.h"
 #include "OgreGLUniformCache.h"
 #include "OgreGL3PlusStateCacheManager.h"
+#include "OgreRoot.h"
 
 namespace Ogre
 {
@@ -122,8 +123,25 @@ namespace Ogre
         if(const auto& ubo = static_cast<GLSLShader*>(mShaders[fromProgType])->getDefaultBuffer())
         {
             // we ignore ma
-            ubo->writeData(0, ubo->getSizeInBytes(), params->getConstantList().data(), true);
-            static_cast<GL3PlusHardwareBuffer*>(ubo.get())->bind();
+            // append the constants to the ring, instead of orphaning the shader's own buffer per draw
+            UniformBufferRing* ring = GLSLProgramManager::getSingleton().getUniformBufferRing();
+            size_t size = ubo->getSizeInBytes();
+            size_t offset = ring->write(params->getConstantList().data(), size,
+                                        Root::getSingleton().getNextFrameNumber());
+
+            if (offset != size_t(-1))
+            {
+                auto ringBuffer = static_cast<GL3PlusHardwareBuffer*>(ring->getBuffer().get());
+                OGRE_CHECK_GL_ERROR(glBindBufferRange(GL_UNIFORM_BUFFER,
+                                                      static_cast<GL3PlusHardwareBuffer*>(ubo.get())->getGLBufferBinding(),
+                                                      ringBuffer->getGLBufferId(), offset, size));
+            }
+            else
+            {
+                // the ring is still in use by the GPU
+                ubo->writeData(0, size, params->getConstantList().data(), true);
+                static_cast<GL3PlusHardwareBuffer*>(ubo.get())->bind();
+            }
             usesUBO = true;
         }
 
@@ -31,6 +31,8 @@ THE SOFTWARE.
 #include "OgreShaderProgramManager.h"
 #include "OgreShaderFunctionAtom.h"
 
+#include <thread>
+
 using namespace Ogre;
 
 struct RTShaderSystem : public RootWithoutRenderSystemFixture
@@ -70,6 +72,78 @@ TEST_F(RTShaderSystem, createShaderBasedTechnique)
     EXPECT_TRUE(shaderGen.removeShaderBasedTechnique(mat->getTechniques()[0], "MyScheme"));
 }
 
+TEST_F(RTShaderSystem, ProgramIndex)
+{
+    const String cachePath = "./RTShaderCache/";
+    FileSystemLayer::createDirectory(cachePath);
+    FileSystemLayer::removeFile(cachePath + "RTShaderProgramIndex.txt");
+
+    String programNames[2];
+    for (int i = 0; i < 2; i++)
+    {
+        // the second generator starts from the programs indexed by the first one
+        if (i > 0)
+        {
+            RTShader::ShaderGenerator::destroy();
+            RTShader::ShaderGenerator::initialize();
+            RTShader::ShaderGenerator::getSingleton().setTargetLanguage("glsl");
+        }
+
+        auto& shaderGen = RTShader::ShaderGenerator::getSingleton();
+        shaderGen.setShaderCachePath(cachePath);
+
+        auto mat = MaterialManager::getSingleton().create(StringUtil::format("TestMat%d", i), RGN_DEFAULT);
+        EXPECT_TRUE(shaderGen.createShaderBasedTechnique(mat->getTechniques()[0], "MyScheme"));
+        shaderGen.getRenderState("MyScheme")->setLightCountAutoUpdate(false);
+        shaderGen.validateMaterial("MyScheme", *mat);
+
+        ASSERT_EQ(mat->getTechniques().size(), size_t(2));
+        programNames[i] = mat->getTechniques()[1]->getPasses()[0]->getVertexProgramName();
+    }
+
+    EXPECT_EQ(programNames[0], programNames[1]);
+
+    // the second run found both programs in the index, so nothing was added
+    std::ifstream indexFile(cachePath + "RTShaderProgramIndex.txt");
+    String line;
+    int lineCount = 0;
+    while (std::getline(indexFile, line))
+        lineCount++;
+    EXPECT_EQ(lineCount, 2);
+}
+
+TEST_F(RTShaderSystem, BackgroundGeneration)
+{
+    auto wq = mRoot->getWorkQueue();
+    wq->startup();
+
+    auto& shaderGen = RTShader::ShaderGenerator::getSingleton();
+    shaderGen.setBackgroundGeneration(true);
+
+    auto mat = MaterialManager::getSingleton().create("TestMat", RGN_DEFAULT);
+    EXPECT_TRUE(shaderGen.createShaderBasedTechnique(mat->getTechniques()[0], "MyScheme"));
+    shaderGen.getRenderState("MyScheme")->setLightCountAutoUpdate(false);
+    shaderGen.validateScheme("MyScheme");
+
+    // the simple render state is used meanwhile
+    ASSERT_EQ(mat->getTechniques().size(), size_t(2));
+    auto pass = mat->getTechniques()[1]->getPasses()[0];
+    EXPECT_TRUE(pass->hasGpuProgram(GPT_VERTEX_PROGRAM));
+    EXPECT_EQ(shaderGen.getPendingGenerationCount(), size_t(1));
+
+    for (int i = 0; i < 1000 && shaderGen.getPendingGenerationCount() > 0; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        wq->processResponses();
+    }
+
+    EXPECT_EQ(shaderGen.getPendingGenerationCount(), size_t(0));
+    EXPECT_TRUE(pass->hasGpuProgram(GPT_VERTEX_PROGRAM));
+    EXPECT_TRUE(pass->hasGpuProgram(GPT_FRAGMENT_PROGRAM));
+
+    wq->shutdown();
+}
+
 TEST_F(RTShaderSystem, MaterialSerializer)
 {
     auto& shaderGen = RTShader::ShaderGenerator::getSingleton();
@@ -121,3 +195,33 @@ TEST_F(RTShaderSystem, FunctionInvocationOrder)
     EXPECT_TRUE(c == a);
     EXPECT_FALSE(c < a);
 }
+
+TEST_F(RTShaderSystem, AtomKeyOperator)
+{
+    using namespace RTShader;
+
+    auto a = ParameterFactory::createConstParam(Vector3(1, 2, 3));
+    auto b = ParameterFactory::createConstParam(Vector3(4, 5, 6));
+    auto dst = ParameterFactory::createOutPosition(0);
+
+    // two programs that only differ by the operator must not share the cached GPU program
+    String keys[2];
+    const char ops[] = {'+', '*'};
+    for (int i = 0; i < 2; i++)
+    {
+        BinaryOpAtom atom(ops[i], 0);
+        atom.setOperands({Operand(a, Operand::OPS_IN), Operand(b, Operand::OPS_IN), Operand(dst, Operand::OPS_OUT)});
+        atom._appendToKey(keys[i]);
+    }
+    EXPECT_NE(keys[0], keys[1]);
+
+    // the key is stable across runs and compilers, so a call to "assign" differs by its tag only
+    AssignmentAtom assign(Out(dst), In(a), 0);
+    FunctionInvocation call("assign", 0);
+    call.setOperands(assign.getOperandList());
+    String assignKey, callKey;
+    assign._appendToKey(assignKey);
+    call._appendToKey(callKey);
+    EXPECT_NE(assignKey, callKey);
+    EXPECT_EQ(assignKey[0], 'A');
+}
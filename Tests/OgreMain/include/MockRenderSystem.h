@@ -0,0 +1,93 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef TESTS_OGREMAIN_INCLUDE_MOCKRENDERSYSTEM_H_
+#define TESTS_OGREMAIN_INCLUDE_MOCKRENDERSYSTEM_H_
+
+#include "OgreRenderSystem.h"
+#include "OgreRenderSystemCapabilities.h"
+#include "OgreHardwareVertexBuffer.h"
+
+/// a RenderSystem without a backend, that counts the calls reaching the backend
+class MockRenderSystem : public Ogre::RenderSystem
+{
+public:
+    std::map<Ogre::String, int> calls;
+    /// instances and first instance texture coordinate of each draw, -1 if not instanced
+    std::vector<std::pair<size_t, int> > draws;
+    /// byte offset of the instance data of each instanced draw
+    std::vector<size_t> instanceOffsets;
+    Ogre::RenderSystemCapabilities caps;
+
+    MockRenderSystem() { mCurrentCapabilities = &caps; }
+
+    const Ogre::String& getName(void) const
+    {
+        static Ogre::String name = "Mock Rendering Subsystem";
+        return name;
+    }
+    void setConfigOption(const Ogre::String&, const Ogre::String&) {}
+    Ogre::HardwareOcclusionQuery* createHardwareOcclusionQuery(void) { return NULL; }
+    Ogre::RenderSystemCapabilities* createRenderSystemCapabilities() const { return NULL; }
+    Ogre::MultiRenderTarget* createMultiRenderTarget(const Ogre::String&) { return NULL; }
+    void _setSampler(size_t, Ogre::Sampler&) { calls["sampler"]++; }
+    void _setTexture(size_t, bool, const Ogre::TexturePtr&) { calls["texture"]++; }
+    void setColourBlendState(const Ogre::ColourBlendState&) { calls["blend"]++; }
+    void _setAlphaRejectSettings(Ogre::CompareFunction, unsigned char, bool) { calls["alphaReject"]++; }
+    Ogre::DepthBuffer* _createDepthBufferFor(Ogre::RenderTarget*) { return NULL; }
+    void _endFrame(void) {}
+    void _setViewport(Ogre::Viewport* vp) { mActiveViewport = vp; }
+    void _setCullingMode(Ogre::CullingMode mode) { mCullingMode = mode; calls["culling"]++; }
+    void _setDepthBufferParams(bool, bool, Ogre::CompareFunction) { calls["depth"]++; }
+    void _setDepthBias(float, float) { calls["depthBias"]++; }
+    void _convertProjectionMatrix(const Ogre::Matrix4& matrix, Ogre::Matrix4& dest, bool) { dest = matrix; }
+    void _setPolygonMode(Ogre::PolygonMode) { calls["polygon"]++; }
+    void setStencilState(const Ogre::StencilState&) { calls["stencil"]++; }
+    void bindGpuProgramParameters(Ogre::GpuProgramType, const Ogre::GpuProgramParametersPtr&, Ogre::uint16) {}
+    void setScissorTest(bool, const Ogre::Rect&) {}
+    void clearFrameBuffer(Ogre::uint32, const Ogre::ColourValue&, float, Ogre::uint16) {}
+    Ogre::Real getMinimumDepthInputValue(void) { return -1; }
+    Ogre::Real getMaximumDepthInputValue(void) { return 1; }
+    void _setRenderTarget(Ogre::RenderTarget*) {}
+    void beginProfileEvent(const Ogre::String&) {}
+    void endProfileEvent(void) {}
+    void markProfileEvent(const Ogre::String&) {}
+    void initialiseFromRenderSystemCapabilities(Ogre::RenderSystemCapabilities*, Ogre::RenderTarget*) {}
+    void setShadingType(Ogre::ShadeOptions) { calls["shading"]++; }
+    void _render(const Ogre::RenderOperation& op)
+    {
+        calls["render"]++;
+        auto decl = getGlobalInstanceVertexBufferVertexDeclaration();
+        draws.push_back({op.numberOfInstances, decl ? int(decl->getElement(0)->getIndex()) : -1});
+        if (decl)
+            instanceOffsets.push_back(decl->getElement(0)->getOffset());
+        RenderSystem::_render(op);
+    }
+};
+
+#endif /* TESTS_OGREMAIN_INCLUDE_MOCKRENDERSYSTEM_H_ */
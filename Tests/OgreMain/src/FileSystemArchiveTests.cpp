@@ -263,6 +263,27 @@ TEST_F(FileSystemArchiveTests,FileRead)
     EXPECT_TRUE(stream->eof());
 }
 //--------------------------------------------------------------------------
+TEST_F(FileSystemArchiveTests,FileReadMapped)
+{
+    // small files are read as before
+    EXPECT_FALSE(std::dynamic_pointer_cast<MemoryMappedDataStream>(mArch->open("rootfile.txt")));
+
+    // read-only files above the threshold are memory mapped, so they can be accessed in place
+    size_t minSize = MemoryMappedDataStream::getMinMappedSize();
+    MemoryMappedDataStream::setMinMappedSize(0);
+    DataStreamPtr stream = mArch->open("rootfile.txt");
+    MemoryMappedDataStream::setMinMappedSize(minSize);
+    auto mapped = std::dynamic_pointer_cast<MemoryMappedDataStream>(stream);
+    ASSERT_TRUE(mapped);
+    EXPECT_EQ(String("this is line 1"), String((const char*)mapped->getPtr(), 14));
+
+    // ranges keep the mapping alive
+    MemoryMappedDataStream range("range", *mapped, 8, 6);
+    stream.reset();
+    mapped.reset();
+    EXPECT_EQ(String("line 1"), range.getAsString());
+}
+//--------------------------------------------------------------------------
 TEST_F(FileSystemArchiveTests,ReadInterleave)
 {
     // Test overlapping reads from same archive
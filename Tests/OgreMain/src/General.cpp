@@ -32,12 +32,18 @@ THE SOFTWARE.
 #include "OgreEntity.h"
 #include "OgreCamera.h"
 #include "RootWithoutRenderSystemFixture.h"
+#include "MockRenderSystem.h"
 #include "OgreStaticPluginLoader.h"
 
 #include "OgreMaterialSerializer.h"
 #include "OgreTechnique.h"
 #include "OgrePass.h"
 #include "OgreMaterialManager.h"
+#include "OgreWorkQueue.h"
+#include "Threading/OgreDefaultWorkQueue.h"
+#include "OgreResourceBackgroundQueue.h"
+#include "OgreTimer.h"
+#include "OgreScriptCompiler.h"
 #include "OgreConfigFile.h"
 #include "OgreSTBICodec.h"
 #include "OgreHighLevelGpuProgramManager.h"
@@ -49,10 +55,25 @@ THE SOFTWARE.
 #include "OgreTextureManager.h"
 #include "OgreFileSystem.h"
 #include "OgreArchiveManager.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreManualObject.h"
+#include "OgreStaticGeometry.h"
+#include "OgreSubMesh.h"
+#include "OgreRenderTarget.h"
+#include "OgreViewport.h"
+#include "OgreHardwarePixelBuffer.h"
+#include "OgreMeshSerializer.h"
+#include "OgreLodStrategy.h"
+#include "OgreTagPoint.h"
 
 #include "OgreHighLevelGpuProgram.h"
+#include "OgreGpuProgramManager.h"
+#include "OgreControllerManager.h"
 
+#include <atomic>
+#include <fstream>
 #include <random>
+#include <thread>
 using std::minstd_rand;
 
 using namespace Ogre;
@@ -91,6 +112,310 @@ TEST(SceneManager,removeAndDestroyAllChildren)
     sm->getRootSceneNode()->removeAndDestroyAllChildren();
 }
 
+struct MockRenderTarget : public RenderTarget
+{
+    MockRenderTarget()
+    {
+        mName = "MockRenderTarget";
+        mWidth = mHeight = 64;
+    }
+    void copyContentsToMemory(const Box& src, const PixelBox& dst, FrameBuffer buffer) override {}
+    bool requiresTextureFlipping() const override { return false; }
+};
+
+struct FindVisibleObjectsCounter : public SceneManager::Listener
+{
+    int count = 0;
+    void preFindVisibleObjects(SceneManager* source, SceneManager::IlluminationRenderStage irs,
+                               Viewport* v) override
+    {
+        count++;
+    }
+};
+
+typedef RootWithoutRenderSystemFixture RenderRecordingTests;
+TEST_F(RenderRecordingTests, recordAndReplay)
+{
+    MockRenderSystem rs;
+    rs.caps.setCapability(RSC_FIXED_FUNCTION);
+    mRoot->setRenderSystem(&rs);
+    ControllerManager controllerMgr; // usually created by Root::initialise
+    SceneManager* sm = mRoot->createSceneManager();
+
+    Camera* cam = sm->createCamera("cam");
+    cam->setNearClipDistance(1);
+    cam->setFarClipDistance(100);
+    sm->getRootSceneNode()->attachObject(cam);
+
+    auto createTriangle = [sm](const Vector3& pos) {
+        ManualObject* obj = sm->createManualObject();
+        obj->begin("BaseWhiteNoLighting");
+        obj->position(-1, -1, 0);
+        obj->position(1, -1, 0);
+        obj->position(0, 1, 0);
+        obj->end();
+        SceneNode* node = sm->getRootSceneNode()->createChildSceneNode(pos);
+        node->attachObject(obj);
+        return node;
+    };
+    SceneNode* inView = createTriangle(Vector3(0, 0, -10));
+    SceneNode* behind = createTriangle(Vector3(0, 0, 10));
+
+    FindVisibleObjectsCounter traversals;
+    sm->addListener(&traversals);
+
+    MockRenderTarget target;
+    {
+        Viewport vp(cam, &target, 0, 0, 1, 1, 0);
+        vp.setOverlaysEnabled(false);
+        vp.setRenderRecordingEnabled(true);
+
+        auto renderFrame = [&]() {
+            rs.calls.clear();
+            mRoot->_fireFrameStarted();
+            sm->_renderScene(cam, &vp, false);
+            mRoot->_fireFrameRenderingQueued();
+            mRoot->_fireFrameEnded();
+            return rs.calls["render"];
+        };
+
+        // recorded, then replayed without traversing the scene
+        EXPECT_EQ(renderFrame(), 1);
+        EXPECT_EQ(renderFrame(), 1);
+        EXPECT_EQ(traversals.count, 1);
+        ASSERT_EQ(vp._getRenderRecording()->commands.size(), 1u);
+        EXPECT_TRUE(vp._getRenderRecording()->commands[0].derived);
+
+        // changes outside of the view do not matter
+        behind->translate(Vector3::UNIT_X);
+        EXPECT_EQ(renderFrame(), 1);
+        EXPECT_EQ(traversals.count, 1);
+
+        // objects entering the view do
+        behind->setPosition(0, 0, -20);
+        EXPECT_EQ(renderFrame(), 2);
+        EXPECT_EQ(traversals.count, 2);
+        EXPECT_EQ(renderFrame(), 2);
+        EXPECT_EQ(traversals.count, 2);
+
+        // as do changes to the recorded passes
+        MaterialManager::getSingleton()
+            .getByName("BaseWhiteNoLighting")
+            ->getTechnique(0)
+            ->getPass(0)
+            ->removeAllTextureUnitStates();
+        EXPECT_EQ(renderFrame(), 2);
+        EXPECT_EQ(traversals.count, 3);
+
+        // and hiding objects
+        inView->getAttachedObject(0)->setVisible(false);
+        EXPECT_EQ(renderFrame(), 1);
+        EXPECT_EQ(traversals.count, 4);
+
+        // a scene changing every frame is recorded less often
+        for (int i = 0; i < 8; i++)
+        {
+            behind->translate(Vector3::UNIT_X * 0.01);
+            EXPECT_EQ(renderFrame(), 1);
+        }
+        EXPECT_EQ(traversals.count, 12);
+        EXPECT_GT(vp._getRenderRecording()->wastedRecordings, 1);
+        EXPECT_GT(vp._getRenderRecording()->nextRecordingFrame, mRoot->getNextFrameNumber());
+    }
+
+    sm->removeListener(&traversals);
+    mRoot->destroySceneManager(sm);
+    mRoot->setRenderSystem(NULL);
+}
+
+struct MeshLodEventCounter : public LodListener
+{
+    int count = 0;
+    bool prequeueEntityMeshLodChanged(EntityMeshLodChangedEvent& evt) override
+    {
+        count++;
+        return false;
+    }
+};
+
+TEST_F(RenderRecordingTests, replayRefreshesLod)
+{
+    MockRenderSystem rs;
+    rs.caps.setCapability(RSC_FIXED_FUNCTION);
+    mRoot->setRenderSystem(&rs);
+    ControllerManager controllerMgr; // usually created by Root::initialise
+    SceneManager* sm = mRoot->createSceneManager();
+
+    Camera* cam = sm->createCamera("cam");
+    cam->setNearClipDistance(1);
+    cam->setFarClipDistance(100);
+    sm->getRootSceneNode()->attachObject(cam);
+    MeshPtr plane = MeshManager::getSingleton().createPlane("replayRefreshesLod", RGN_DEFAULT,
+                                                           Plane(Vector3::UNIT_Z, 0), 2, 2);
+    sm->getRootSceneNode()->createChildSceneNode(Vector3(0, 0, -10))->attachObject(sm->createEntity(plane));
+
+    FindVisibleObjectsCounter traversals;
+    sm->addListener(&traversals);
+    MeshLodEventCounter lodEvents;
+    sm->addLodListener(&lodEvents);
+
+    MockRenderTarget target;
+    {
+        Viewport vp(cam, &target, 0, 0, 1, 1, 0);
+        vp.setOverlaysEnabled(false);
+        vp.setRenderRecordingEnabled(true);
+
+        for (int i = 0; i < 3; i++)
+        {
+            mRoot->_fireFrameStarted();
+            sm->_renderScene(cam, &vp, false);
+            mRoot->_fireFrameRenderingQueued();
+            mRoot->_fireFrameEnded();
+        }
+
+        // the LOD of the recorded objects is still evaluated every frame
+        EXPECT_EQ(traversals.count, 1);
+        EXPECT_EQ(vp._getRenderRecording()->objects.size(), 1u);
+        EXPECT_EQ(lodEvents.count, 3);
+
+        // the recorded commands might use the index buffers of evicted LOD levels
+        sm->_notifySceneChanged(AxisAlignedBox::BOX_INFINITE);
+        EXPECT_FALSE(vp._getRenderRecording()->valid);
+    }
+
+    sm->removeLodListener(&lodEvents);
+    sm->removeListener(&traversals);
+    mRoot->destroySceneManager(sm);
+    mRoot->setRenderSystem(NULL);
+}
+
+struct MockProgram : public GpuProgram
+{
+    MockProgram(ResourceManager* creator, const String& name, ResourceHandle handle, const String& group)
+        : GpuProgram(creator, name, handle, group, false, NULL)
+    {
+        if (createParamDictionary("MockProgram"))
+            setupBaseParamDictionary();
+    }
+    void loadFromSource() override {}
+    void unloadImpl() override {}
+    bool isSupported() const override { return true; }
+    const String& getLanguage() const override
+    {
+        static String language = "mock";
+        return language;
+    }
+};
+
+struct MockProgramFactory : public GpuProgramFactory
+{
+    const String& getLanguage() const override
+    {
+        static String language = "mock";
+        return language;
+    }
+    GpuProgram* create(ResourceManager* creator, const String& name, ResourceHandle handle,
+                       const String& group, bool, ManualResourceLoader*) override
+    {
+        return new MockProgram(creator, name, handle, group);
+    }
+};
+
+typedef RootWithoutRenderSystemFixture AutoInstancingTests;
+TEST_F(AutoInstancingTests, splitsRuns)
+{
+    MockRenderSystem rs;
+    rs.caps.setCapability(RSC_VERTEX_BUFFER_INSTANCE_DATA);
+    rs.caps.setCapability(RSC_FIXED_FUNCTION);
+    mRoot->setRenderSystem(&rs);
+    ControllerManager controllerMgr;
+    SceneManager* sm = mRoot->createSceneManager();
+
+    MockProgramFactory factory;
+    GpuProgramManager::getSingleton().addFactory(&factory);
+    GpuProgramPtr vp = GpuProgramManager::getSingleton().createProgram("instancedVP", RGN_DEFAULT, "mock",
+                                                                       GPT_VERTEX_PROGRAM);
+    vp->setSource("");
+    vp->setParameter("includes_instancing", "true 4");
+    EXPECT_EQ(vp->getInstancingTexCoordIndex(), 4);
+    EXPECT_EQ(vp->getParameter("includes_instancing"), "true 4");
+
+    MaterialPtr mat = MaterialManager::getSingleton().create("autoInstanced", RGN_DEFAULT);
+    mat->getTechnique(0)->getPass(0)->setVertexProgram("instancedVP");
+
+    MeshManager::getSingleton().createPlane("autoInstancedPlane", RGN_DEFAULT, Plane(Vector3::UNIT_Z, 0), 1, 1);
+
+    Camera* cam = sm->createCamera("cam");
+    cam->setNearClipDistance(1);
+    cam->setFarClipDistance(100);
+    sm->getRootSceneNode()->attachObject(cam);
+
+    std::vector<SceneNode*> nodes;
+    for (int i = 0; i < 4; i++)
+    {
+        Entity* ent = sm->createEntity("autoInstancedPlane");
+        ent->setMaterial(mat);
+        nodes.push_back(sm->getRootSceneNode()->createChildSceneNode(Vector3(i - 1.5, 0, -10)));
+        nodes.back()->attachObject(ent);
+    }
+
+    MockRenderTarget target;
+    {
+        Viewport viewport(cam, &target, 0, 0, 1, 1, 0);
+        viewport.setOverlaysEnabled(false);
+
+        auto renderFrame = [&]() {
+            rs.draws.clear();
+            mRoot->_fireFrameStarted();
+            sm->_renderScene(cam, &viewport, false);
+            mRoot->_fireFrameRenderingQueued();
+            mRoot->_fireFrameEnded();
+            return rs.draws;
+        };
+
+        typedef std::vector<std::pair<size_t, int> > Draws;
+
+        // all drawn as instances, with the matrix where the program reads it
+        EXPECT_EQ(renderFrame(), Draws({{4, 4}}));
+
+        // a flipped winding splits the run
+        nodes[2]->setScale(-1, 1, 1);
+        EXPECT_EQ(renderFrame(), Draws({{2, 4}, {1, 4}, {1, 4}}));
+
+        // as does different geometry
+        nodes[2]->setScale(1, 1, 1);
+        nodes[1]->detachAllObjects();
+        ManualObject* obj = sm->createManualObject();
+        obj->begin("autoInstanced");
+        obj->position(-1, -1, 0);
+        obj->position(1, -1, 0);
+        obj->position(0, 1, 0);
+        obj->end();
+        nodes[1]->attachObject(obj);
+        EXPECT_EQ(renderFrame(), Draws({{1, 4}, {1, 4}, {2, 4}}));
+
+        // by default following the texture coordinates of the geometry
+        vp->setInstancingIncluded(true);
+        nodes[1]->detachAllObjects();
+        EXPECT_EQ(renderFrame(), Draws({{3, 1}}));
+
+        // with the dynamic vertex rings enabled, consecutive batches are appended to a ring
+        HardwareBufferManager::getSingleton().setDynamicVertexRingSize(4096);
+        rs.instanceOffsets.clear();
+        EXPECT_EQ(renderFrame(), Draws({{3, 1}}));
+        EXPECT_EQ(renderFrame(), Draws({{3, 1}}));
+        EXPECT_EQ(rs.instanceOffsets, std::vector<size_t>({0, 3 * 48}));
+        HardwareBufferManager::getSingleton().setDynamicVertexRingSize(0);
+    }
+
+    mRoot->destroySceneManager(sm);
+    mRoot->setRenderSystem(NULL);
+    MaterialManager::getSingleton().remove(mat);
+    GpuProgramManager::getSingleton().remove(vp);
+    vp.reset();
+    GpuProgramManager::getSingleton().removeFactory(&factory);
+}
+
 static void createRandomEntityClones(Entity* ent, size_t cloneCount, const Vector3& min,
                                      const Vector3& max, SceneManager* mgr)
 {
@@ -289,6 +614,149 @@ TEST(Image, Combine)
     ASSERT_TRUE(!memcmp(combined.getData(), ref.getData(), ref.getSize()));
 }
 
+struct MockPixelBuffer : public HardwarePixelBuffer
+{
+    MockPixelBuffer(uint32 width, uint32 height, PixelFormat format)
+        : HardwarePixelBuffer(width, height, 1, format, HBU_GPU_ONLY, false, false)
+    {
+    }
+    PixelBox lockImpl(const Box&, LockOptions) override { return PixelBox(); }
+    void blitFromMemory(const PixelBox&, const Box&) override {}
+    void blitToMemory(const Box&, const PixelBox&) override {}
+};
+
+struct MockTexture : public Texture
+{
+    MockTexture(ResourceManager* creator, const String& name, ResourceHandle handle, const String& group)
+        : Texture(creator, name, handle, group)
+    {
+    }
+    void createInternalResourcesImpl() override
+    {
+        for (uint32 mip = 0; mip <= mNumMipmaps; mip++)
+            mSurfaceList.push_back(
+                std::make_shared<MockPixelBuffer>(std::max(mWidth >> mip, 1u), std::max(mHeight >> mip, 1u), mFormat));
+    }
+    void freeInternalResourcesImpl() override {}
+};
+
+struct MockTextureManager : public TextureManager
+{
+    Resource* createImpl(const String& name, ResourceHandle handle, const String& group, bool,
+                         ManualResourceLoader*, const NameValuePairList*) override
+    {
+        return new MockTexture(this, name, handle, group);
+    }
+    bool isHardwareFilteringSupported(TextureType, PixelFormat, int, bool) override { return false; }
+    PixelFormat getNativeFormat(TextureType, PixelFormat format, int) override { return format; }
+};
+
+typedef RootWithoutRenderSystemFixture TextureStreamingTests;
+TEST_F(TextureStreamingTests, budgetAndEviction)
+{
+    MockRenderSystem rs;
+    mRoot->setRenderSystem(&rs);
+    MockTextureManager texMgr;
+    texMgr.setStreamingResidentSize(32);
+    STBIImageCodec::startup();
+
+    auto& rgm = ResourceGroupManager::getSingleton();
+    rgm.addResourceLocation(".", "FileSystem", RGN_DEFAULT, false, false);
+
+    // a png has no mipmaps, so they are generated for streaming
+    Image img(PF_BYTE_RGBA, 256, 256);
+    memset(img.getData(), 0x7f, img.getSize());
+    DataStreamPtr encoded = img.encode("png");
+    std::vector<TexturePtr> textures;
+    for (int i = 0; i < 2; i++)
+    {
+        String name = StringUtil::format("streamed%d.png", i);
+        rgm.createResource(name, RGN_DEFAULT)->write(encoded->getAsString().c_str(), encoded->size());
+        encoded->seek(0);
+        textures.push_back(texMgr.load(name, RGN_DEFAULT));
+
+        // only the mipmaps up to the resident size are uploaded
+        ASSERT_TRUE(textures.back()->isStreamed());
+        EXPECT_EQ(textures.back()->getMipmapSkip(), 3u);
+        EXPECT_EQ(textures.back()->getWidth(), 32u);
+    }
+
+    mRoot->getWorkQueue()->startup();
+
+    // the images are decoded on the WorkQueue and uploaded at the end of a frame
+    auto renderFrame = [&](std::vector<std::pair<TexturePtr, uint32>> seen) {
+        mRoot->_fireFrameStarted();
+        for (const auto& s : seen)
+            s.first->_notifyRequiredSize(s.second);
+        mRoot->_fireFrameRenderingQueued();
+        mRoot->_fireFrameEnded();
+    };
+    auto renderUntil = [&](std::vector<std::pair<TexturePtr, uint32>> seen, std::function<bool()> done) {
+        Timer timer;
+        while (!done() && timer.getMilliseconds() < 5000)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            renderFrame(seen);
+        }
+    };
+
+    textures[0]->_notifyRequiredSize(100);
+    EXPECT_EQ(textures[0]->getWidth(), 32u);
+
+    // with an upload budget, at most one texture is uploaded per frame
+    texMgr.setStreamingUploadBudget(1);
+    {
+        Timer timer;
+        while ((textures[0]->getWidth() != 128 || textures[1]->getWidth() != 128) &&
+               timer.getMilliseconds() < 5000)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            uint32 before = textures[0]->getWidth() + textures[1]->getWidth();
+            renderFrame({{textures[0], 100}, {textures[1], 100}});
+            EXPECT_LE(textures[0]->getWidth() + textures[1]->getWidth() - before, 96u);
+        }
+    }
+    EXPECT_EQ(textures[0]->getMipmapSkip(), 1u);
+    EXPECT_EQ(textures[1]->getWidth(), 128u);
+    texMgr.setStreamingUploadBudget(0);
+
+    // over budget, the least recently seen texture falls back to its resident mipmaps
+    texMgr.setStreamingBudget(textures[0]->getSize() + 1);
+    renderUntil({{textures[1], 1000}},
+                [&]() { return textures[1]->getWidth() == 256 && textures[0]->getWidth() == 32; });
+    EXPECT_EQ(textures[1]->getWidth(), 256u);
+    EXPECT_EQ(textures[0]->getWidth(), 32u);
+    EXPECT_EQ(textures[0]->getMipmapSkip(), 3u);
+
+    // but not the ones seen in the same frame
+    renderUntil({{textures[0], 100}, {textures[1], 100}}, [&]() { return textures[0]->getWidth() == 128; });
+    for (int i = 0; i < 3; i++)
+        renderFrame({{textures[0], 100}, {textures[1], 100}});
+    EXPECT_EQ(textures[0]->getWidth(), 128u);
+    EXPECT_EQ(textures[1]->getWidth(), 256u);
+
+    // a texture seen larger later on evicts the other one
+    renderUntil({{textures[0], 1000}},
+                [&]() { return textures[0]->getMipmapSkip() == 0 && textures[1]->getWidth() == 32; });
+    EXPECT_EQ(textures[0]->getMipmapSkip(), 0u);
+    EXPECT_EQ(textures[1]->getWidth(), 32u);
+
+    textures.clear();
+    texMgr.removeAll();
+    rgm.deleteResource("streamed0.png", RGN_DEFAULT);
+    rgm.deleteResource("streamed1.png", RGN_DEFAULT);
+    STBIImageCodec::shutdown();
+    mRoot->setRenderSystem(NULL);
+}
+
+TEST_F(TextureStreamingTests, texelFactor)
+{
+    // a 10x10 plane with the texture repeated twice in each direction
+    MeshPtr mesh = MeshManager::getSingleton().createPlane("texelFactor", RGN_DEFAULT, Plane(Vector3::UNIT_Z, 0),
+                                                           10, 10, 1, 1, true, 1, 2, 2);
+    EXPECT_FLOAT_EQ(mesh->getSubMesh(0)->_getTexelFactor(), 5);
+}
+
 struct UsePreviousResourceLoadingListener : public ResourceLoadingListener
 {
     bool resourceCollision(Resource *resource, ResourceManager *resourceManager) { return false; }
@@ -381,6 +849,145 @@ TEST(GpuSharedParameters, align)
     EXPECT_EQ(params.getConstantDefinition("d").logicalIndex, 48);
 }
 
+TEST(GpuProgramParameters, updateAutoParams)
+{
+    GpuProgramParameters params;
+    params._setLogicalIndexes(std::make_shared<GpuLogicalBufferStruct>());
+    params.setAutoConstant(0, GpuProgramParameters::ACT_AMBIENT_LIGHT_COLOUR);
+    params.setAutoConstant(1, GpuProgramParameters::ACT_WORLD_MATRIX);
+    size_t ambientIndex = params.findFloatAutoConstantEntry(0)->physicalIndex;
+    size_t worldIndex = params.findFloatAutoConstantEntry(1)->physicalIndex;
+
+    Affine3 world = Affine3::IDENTITY;
+    world.setTrans(Vector3(1, 2, 3));
+    AutoParamDataSource source;
+    source.setWorldMatrices(&world, 1);
+    source.setAmbientLightColour(ColourValue(0.5, 0.5, 0.5));
+
+    // per object updates leave the global constants alone
+    params._updateAutoParams(&source, GPV_PER_OBJECT);
+    EXPECT_EQ(params.getFloatPointer(worldIndex)[3], 1);
+    EXPECT_EQ(params.getFloatPointer(worldIndex)[11], 3);
+    EXPECT_EQ(params.getFloatPointer(ambientIndex)[0], 0);
+
+    params._updateAutoParams(&source, GPV_GLOBAL);
+    EXPECT_EQ(params.getFloatPointer(ambientIndex)[0], 0.5);
+
+    // adding a constant updates the plan
+    params.setAutoConstant(8, GpuProgramParameters::ACT_INVERSE_WORLD_MATRIX);
+    params._updateAutoParams(&source, GPV_PER_OBJECT);
+    EXPECT_EQ(params.getFloatPointer(params.findFloatAutoConstantEntry(8)->physicalIndex)[3], -1);
+}
+
+TEST(RenderSystem, stateCache)
+{
+    MockRenderSystem rs;
+
+    ColourBlendState blend;
+    rs._applyBlendState(blend, CMPF_ALWAYS_PASS, 0, false);
+    rs._applyBlendState(blend, CMPF_ALWAYS_PASS, 0, false);
+    EXPECT_EQ(rs.calls["blend"], 1);
+    EXPECT_EQ(rs.calls["alphaReject"], 1);
+
+    // any field of the block makes a difference
+    blend.writeA = false;
+    rs._applyBlendState(blend, CMPF_ALWAYS_PASS, 0, false);
+    rs._applyBlendState(blend, CMPF_ALWAYS_PASS, 1, false);
+    EXPECT_EQ(rs.calls["blend"], 3);
+
+    rs._applyDepthState(true, true, CMPF_LESS_EQUAL, 0, 0);
+    rs._applyDepthState(true, true, CMPF_LESS_EQUAL, 0, 0);
+    rs._applyDepthState(true, false, CMPF_LESS_EQUAL, 0, 0);
+    EXPECT_EQ(rs.calls["depth"], 2);
+    EXPECT_EQ(rs.calls["depthBias"], 2);
+
+    rs._applyRasterState(CULL_CLOCKWISE, PM_SOLID, SO_GOURAUD);
+    rs._applyRasterState(CULL_CLOCKWISE, PM_SOLID, SO_GOURAUD);
+    EXPECT_EQ(rs.calls["culling"], 1);
+
+    EXPECT_EQ(rs.getStateChangeStats().issued, 6u);
+    EXPECT_EQ(rs.getStateChangeStats().filtered, 3u);
+
+    // states set behind the back of the cache
+    rs._setCullingMode(CULL_NONE);
+    rs._invalidateStateCache();
+    rs._applyRasterState(CULL_CLOCKWISE, PM_SOLID, SO_GOURAUD);
+    rs._applyDepthState(true, false, CMPF_LESS_EQUAL, 0, 0);
+    EXPECT_EQ(rs.calls["culling"], 3);
+    EXPECT_EQ(rs.calls["depth"], 3);
+}
+
+typedef RootWithoutRenderSystemFixture UniformBufferRingTests;
+TEST_F(UniformBufferRingTests, write)
+{
+    DefaultHardwareBufferManagerBase mgr;
+    UniformBufferRing ring(256, 64, 2, &mgr);
+
+    std::vector<uchar> data(100);
+    for (uchar i = 0; i < 2; ++i)
+    {
+        std::fill(data.begin(), data.end(), i + 1);
+        size_t offset = ring.write(data.data(), data.size(), 0);
+        // offsets are aligned
+        EXPECT_EQ(offset, i * 128u);
+
+        std::vector<uchar> written(data.size());
+        ring.getBuffer()->readData(offset, written.size(), written.data());
+        EXPECT_EQ(written, data);
+    }
+
+    // the GPU may still read frame 0, so the third write does not fit
+    EXPECT_EQ(ring.write(data.data(), data.size(), 1), size_t(-1));
+
+    // frame 0 is done, so writing starts at the front again
+    EXPECT_EQ(ring.write(data.data(), data.size(), 2), 0u);
+}
+
+typedef RootWithoutRenderSystemFixture VertexBufferRingTests;
+TEST_F(VertexBufferRingTests, lock)
+{
+    DefaultHardwareBufferManagerBase mgr;
+    VertexBufferRing ring(16, 10, 2, &mgr);
+
+    size_t start;
+    float data[16] = {1, 2, 3, 4};
+    void* p = ring.lock(4, 0, start);
+    ASSERT_TRUE(p);
+    memcpy(p, data, sizeof(data));
+    ring.unlock();
+    EXPECT_EQ(start, 0u);
+
+    float written[16];
+    ring.getBuffer()->readData(0, sizeof(written), written);
+    EXPECT_EQ(written[3], 4);
+
+    EXPECT_TRUE(ring.lock(4, 0, start));
+    ring.unlock();
+    EXPECT_EQ(start, 4u);
+
+    // the GPU may still read frame 0, so there is no room to wrap around
+    EXPECT_FALSE(ring.lock(4, 1, start));
+    EXPECT_FALSE(ring.lock(11, 2, start));
+
+    // frame 0 is done
+    EXPECT_TRUE(ring.lock(4, 2, start));
+    ring.unlock();
+    EXPECT_EQ(start, 0u);
+    EXPECT_TRUE(ring.lock(4, 2, start));
+    ring.unlock();
+    EXPECT_EQ(start, 4u);
+    EXPECT_FALSE(ring.lock(4, 3, start));
+
+    // disabled unless given a budget
+    EXPECT_FALSE(mgr.getDynamicVertexRing(16));
+    mgr.setDynamicVertexRingSize(1024);
+    EXPECT_EQ(mgr.getDynamicVertexRing(16)->getBuffer()->getNumVertices(), 64u);
+    EXPECT_EQ(mgr.getDynamicVertexRing(16), mgr.getDynamicVertexRing(16));
+    EXPECT_EQ(mgr.getDynamicVertexRing(16)->getFramesInFlight(), 3u);
+    mgr.setDynamicVertexRingSize(1024, 2);
+    EXPECT_EQ(mgr.getDynamicVertexRing(12)->getFramesInFlight(), 2u);
+}
+
 typedef RootWithoutRenderSystemFixture HighLevelGpuProgramTest;
 TEST_F(HighLevelGpuProgramTest, resolveIncludes)
 {
@@ -435,4 +1042,956 @@ TEST_F(SkeletonTests, linkedSkeletonAnimationSource)
     entity->getSkeleton()->addLinkedSkeletonAnimationSource("ninja.skeleton");
     entity->refreshAvailableAnimationState();
     EXPECT_TRUE(entity->getAnimationState("Stealth")); // animation from ninja.sekeleton
-}
\ No newline at end of file
+}
+
+// Image::scale spreads the rows over the WorkQueue of Root
+typedef RootWithoutRenderSystemFixture ImageTests;
+TEST_F(ImageTests, parallelResize)
+{
+    for (auto format : {PF_BYTE_RGBA, PF_FLOAT32_RGB, PF_FLOAT16_RGBA})
+    {
+        Image src(format, 1024, 512);
+        for (uint32 y = 0; y < src.getHeight(); y++)
+            for (uint32 x = 0; x < src.getWidth(); x++)
+                src.setColourAt(ColourValue((x % 17) / 16.0f, (y % 13) / 12.0f, ((x + y) % 7) / 6.0f), x, y, 0);
+
+        // the queue is not started yet, so this runs serially
+        Image serial(format, 700, 300);
+        Image::scale(src.getPixelBox(), serial.getPixelBox());
+
+        mRoot->getWorkQueue()->startup();
+        Image parallel(format, 700, 300);
+        Image::scale(src.getPixelBox(), parallel.getPixelBox());
+        mRoot->getWorkQueue()->shutdown();
+
+        EXPECT_TRUE(!memcmp(serial.getData(), parallel.getData(), serial.getSize()));
+    }
+}
+
+TEST_F(ImageTests, parallelDDSDecompress)
+{
+    // without a render system, the DXT levels are decompressed in software
+    for (auto name : {"gras_02_dxt1.dds", "ogreborderUp_dxt3.dds", "ogreborderUp_dxt5.dds"})
+    {
+        String path = String("../../Tests/Media/") + name;
+
+        // the queue is not started yet, so this runs serially
+        Image serial;
+        serial.load(Root::openFileStream(path), "dds");
+        ASSERT_FALSE(PixelUtil::isCompressed(serial.getFormat()));
+
+        mRoot->getWorkQueue()->startup();
+        Image parallel;
+        parallel.load(Root::openFileStream(path), "dds");
+        mRoot->getWorkQueue()->shutdown();
+
+        ASSERT_EQ(serial.getSize(), parallel.getSize());
+        EXPECT_TRUE(!memcmp(serial.getData(), parallel.getData(), serial.getSize()));
+    }
+}
+
+TEST(WorkQueue, parallelFor)
+{
+    DefaultWorkQueue wq("WorkQueueTest");
+    for (bool started : {false, true})
+    {
+        if (started)
+            wq.startup();
+
+        std::vector<int> visited(1000, 0);
+        wq.parallelFor(visited.size(), [&visited](size_t i) { visited[i]++; });
+        EXPECT_EQ(std::count(visited.begin(), visited.end(), 1), int(visited.size()));
+
+        wq.parallelFor(0, [&visited](size_t i) { visited[i]++; });
+    }
+}
+
+TEST(WorkQueue, parallelForThrows)
+{
+    DefaultWorkQueue wq("WorkQueueTest");
+    for (bool started : {false, true})
+    {
+        if (started)
+            wq.startup();
+
+        // every chunk throws, so some throw on the worker threads
+        EXPECT_THROW(wq.parallelFor(1000, [](size_t i) {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "index " + std::to_string(i));
+        }), InvalidParametersException);
+
+        // the queue is still usable afterwards
+        std::atomic<int> sum(0);
+        wq.parallelFor(100, [&sum](size_t i) { sum += 1; });
+        EXPECT_EQ(sum, 100);
+    }
+}
+
+#if OGRE_THREAD_SUPPORT
+TEST(WorkQueue, channelPriority)
+{
+    struct Handler : public WorkQueue::RequestHandler
+    {
+        std::vector<int> order;
+        WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ) override
+        {
+            order.push_back(any_cast<int>(req->getData()));
+            return OGRE_NEW WorkQueue::Response(req, true, Any());
+        }
+    } handler;
+
+    // not started, so requests stay queued until processed by hand
+    DefaultWorkQueue queue("WorkQueueTest");
+    DefaultWorkQueueBase* wq = &queue;
+    uint16 low = wq->getChannel("Test/Low");
+    uint16 high = wq->getChannel("Test/High");
+    wq->setChannelPriority(low, -1);
+    wq->setChannelPriority(high, 1);
+    EXPECT_EQ(wq->getChannelPriority(high), 1);
+    for (auto c : {low, high})
+        wq->addRequestHandler(c, &handler);
+
+    wq->addRequest(low, 0, 0);
+    wq->addRequest(low, 0, 1);
+    wq->addRequest(high, 0, 2);
+    wq->addRequest(low, 0, 3);
+    wq->addRequest(high, 0, 4);
+    for (int i = 0; i < 5; i++)
+        wq->_processNextRequest();
+
+    EXPECT_EQ(handler.order, std::vector<int>({2, 4, 0, 1, 3}));
+
+    // the request priority orders within the channel priority
+    handler.order.clear();
+    wq->addRequest(low, 0, 0);
+    wq->addRequest(low, 0, 1, 0, false, false, 2);
+    wq->addRequest(high, 0, 2, 0, false, false, -1);
+    wq->addRequest(low, 0, 3, 0, false, false, 2);
+    wq->addRequest(high, 0, 4);
+    for (int i = 0; i < 5; i++)
+        wq->_processNextRequest();
+
+    EXPECT_EQ(handler.order, std::vector<int>({4, 2, 1, 3, 0}));
+
+    for (auto c : {low, high})
+        wq->removeRequestHandler(c, &handler);
+}
+#endif
+
+typedef RootWithoutRenderSystemFixture ResourceBackgroundQueueTests;
+TEST_F(ResourceBackgroundQueueTests, loadResourceGroup)
+{
+    struct Listener : public ResourceBackgroundQueue::Listener, public ResourceGroupListener
+    {
+        size_t progress = 0;
+        bool completed = false;
+        BackgroundProcessResult result;
+        std::vector<String> events;
+        void operationCompleted(BackgroundProcessTicket, const BackgroundProcessResult& r) override
+        {
+            completed = true;
+            result = r;
+        }
+        void operationProgress(BackgroundProcessTicket, size_t done, size_t total) override
+        {
+            EXPECT_EQ(done, progress + 1);
+            EXPECT_EQ(total, 5u);
+            progress = done;
+        }
+        void resourceGroupLoadStarted(const String& name, size_t count) override
+        {
+            events.push_back("groupStarted " + std::to_string(count));
+        }
+        void resourceLoadStarted(const ResourcePtr& res) override
+        {
+            // already prepared by the worker threads
+            EXPECT_NE(res->getLoadingState(), Resource::LOADSTATE_UNLOADED) << res->getName();
+            events.push_back(res->getName());
+        }
+        void resourceLoadEnded() override { events.push_back("ended"); }
+        void resourceGroupLoadEnded(const String&) override { events.push_back("groupEnded"); }
+    } listener;
+
+    ConfigFile cf;
+    cf.load(mFSLayer->getConfigFilePath("resources.cfg"));
+
+    auto& rgm = ResourceGroupManager::getSingleton();
+    rgm.createResourceGroup("BGQTest", false);
+    rgm.addResourceLocation(cf.getSettings("General").begin()->second + "/../models", "FileSystem", "BGQTest");
+    for (auto name : {"robot.mesh", "knot.mesh", "ogrehead.mesh", "sphere.mesh"})
+        rgm.declareResource(name, "Mesh", "BGQTest");
+    rgm.declareResource("robot.skeleton", "Skeleton", "BGQTest");
+    rgm.initialiseResourceGroup("BGQTest");
+    rgm.addResourceGroupListener(&listener);
+
+    auto bgq = ResourceBackgroundQueue::getSingletonPtr();
+    WorkQueue* wq = mRoot->getWorkQueue();
+    bgq->initialise();
+    wq->startup();
+    bgq->setMaxConcurrentPrepares(2);
+
+    auto ticket = bgq->loadResourceGroup("BGQTest", &listener);
+    Timer timer;
+    while (!bgq->isProcessComplete(ticket) && timer.getMilliseconds() < 10000)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        wq->processResponses();
+    }
+    wq->shutdown();
+    rgm.removeResourceGroupListener(&listener);
+
+    EXPECT_TRUE(listener.completed);
+    EXPECT_FALSE(listener.result.error) << listener.result.message;
+    EXPECT_EQ(listener.progress, 5u);
+    EXPECT_TRUE(rgm.isResourceGroupLoaded("BGQTest"));
+    EXPECT_TRUE(MeshManager::getSingleton().getByName("robot.mesh", "BGQTest")->isLoaded());
+    EXPECT_TRUE(SkeletonManager::getSingleton().getByName("robot.skeleton", "BGQTest")->isLoaded());
+
+    // the events of loadResourceGroup, in loading order: skeletons before meshes
+    ASSERT_EQ(listener.events.size(), 12u);
+    EXPECT_EQ(listener.events.front(), "groupStarted 5");
+    EXPECT_EQ(listener.events[1], "robot.skeleton");
+    for (size_t i = 2; i < 11; i += 2)
+        EXPECT_EQ(listener.events[i], "ended");
+    EXPECT_EQ(listener.events.back(), "groupEnded");
+}
+
+TEST_F(ResourceBackgroundQueueTests, loadResourceGroupFailure)
+{
+    struct Listener : public ResourceBackgroundQueue::Listener
+    {
+        bool completed = false;
+        BackgroundProcessResult result;
+        void operationCompleted(BackgroundProcessTicket, const BackgroundProcessResult& r) override
+        {
+            completed = true;
+            result = r;
+        }
+    } listener;
+
+    auto& rgm = ResourceGroupManager::getSingleton();
+    rgm.createResourceGroup("BGQFailure", false);
+    rgm.declareResource("missing.mesh", "Mesh", "BGQFailure");
+    rgm.initialiseResourceGroup("BGQFailure");
+
+    auto bgq = ResourceBackgroundQueue::getSingletonPtr();
+    WorkQueue* wq = mRoot->getWorkQueue();
+    bgq->initialise();
+    wq->startup();
+
+    auto ticket = bgq->loadResourceGroup("BGQFailure", &listener);
+    Timer timer;
+    while (!bgq->isProcessComplete(ticket) && timer.getMilliseconds() < 10000)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        wq->processResponses();
+    }
+    wq->shutdown();
+
+    // the error is reported instead of being swallowed
+    EXPECT_TRUE(listener.completed);
+    EXPECT_TRUE(listener.result.error);
+    EXPECT_NE(listener.result.message.find("missing.mesh"), String::npos) << listener.result.message;
+    EXPECT_FALSE(rgm.isResourceGroupLoaded("BGQFailure"));
+}
+
+static void expectBuffersEqual(HardwareBuffer* a, HardwareBuffer* b)
+{
+    ASSERT_EQ(a->getSizeInBytes(), b->getSizeInBytes());
+    HardwareBufferLockGuard lockA(a, HardwareBuffer::HBL_READ_ONLY);
+    HardwareBufferLockGuard lockB(b, HardwareBuffer::HBL_READ_ONLY);
+    EXPECT_EQ(memcmp(lockA.pData, lockB.pData, a->getSizeInBytes()), 0);
+}
+
+struct SharedStreamLoadingListener : public ResourceLoadingListener
+{
+    DataStreamPtr stream;
+    DataStreamPtr resourceLoading(const String& name, const String& group, Resource* resource)
+    {
+        return stream;
+    }
+};
+
+typedef RootWithoutRenderSystemFixture MeshSerializerInPlaceTests;
+TEST_F(MeshSerializerInPlaceTests, matchesLockedRead)
+{
+    MeshPtr src = MeshManager::getSingleton().load("knot.mesh", RGN_DEFAULT);
+    String path = mFSLayer->getWritablePath("inplace.mesh");
+    MeshSerializer().exportMesh(src.get(), path);
+
+    // a file stream is read through a lock, a memory stream is written from in place
+    std::ifstream file(path.c_str(), std::ios::binary);
+    DataStreamPtr locked(OGRE_NEW FileStreamDataStream(&file, false));
+    MeshPtr a = MeshManager::getSingleton().createManual("locked", RGN_DEFAULT);
+    MeshSerializer().importMesh(locked, a.get());
+
+    locked->seek(0);
+    DataStreamPtr inPlace(OGRE_NEW MemoryDataStream(locked));
+    MeshPtr b = MeshManager::getSingleton().createManual("inPlace", RGN_DEFAULT);
+    MeshSerializer().importMesh(inPlace, b.get());
+
+    ASSERT_EQ(a->getNumSubMeshes(), b->getNumSubMeshes());
+    for (ushort i = 0; i < a->getNumSubMeshes(); ++i)
+    {
+        IndexData* ia = a->getSubMesh(i)->indexData;
+        IndexData* ib = b->getSubMesh(i)->indexData;
+        EXPECT_EQ(ia->indexCount, ib->indexCount);
+        expectBuffersEqual(ia->indexBuffer.get(), ib->indexBuffer.get());
+    }
+    const VertexData* va = a->sharedVertexData ? a->sharedVertexData : a->getSubMesh(0)->vertexData;
+    const VertexData* vb = b->sharedVertexData ? b->sharedVertexData : b->getSubMesh(0)->vertexData;
+    ASSERT_EQ(va->vertexBufferBinding->getBufferCount(), vb->vertexBufferBinding->getBufferCount());
+    for (unsigned short i = 0; i < va->vertexBufferBinding->getBufferCount(); ++i)
+        expectBuffersEqual(va->vertexBufferBinding->getBuffer(i).get(),
+                           vb->vertexBufferBinding->getBuffer(i).get());
+    file.close();
+    FileSystemLayer::removeFile(path);
+}
+
+TEST_F(MeshSerializerInPlaceTests, sharedStream)
+{
+    MeshPtr src = MeshManager::getSingleton().load("knot.mesh", RGN_DEFAULT);
+    String path = mFSLayer->getWritablePath("inplace.mesh");
+    MeshSerializer().exportMesh(src.get(), path);
+
+    std::ifstream file(path.c_str(), std::ios::binary);
+    SharedStreamLoadingListener listener;
+    listener.stream.reset(OGRE_NEW MemoryDataStream(DataStreamPtr(OGRE_NEW FileStreamDataStream(&file, false))));
+    auto mapped = MemoryMappedDataStream::open(path);
+    ResourceGroupManager::getSingleton().setLoadingListener(&listener);
+
+    MeshPtr mesh = MeshManager::getSingleton().create("shared.mesh", RGN_DEFAULT);
+    mesh->prepare();
+
+    // another reader of the stream must not affect the prepared mesh
+    listener.stream->seek(listener.stream->size() / 2);
+    mesh->load();
+
+    EXPECT_EQ(mesh->getNumSubMeshes(), src->getNumSubMeshes());
+    EXPECT_EQ(mesh->getSubMesh(0)->indexData->indexCount, src->getSubMesh(0)->indexData->indexCount);
+
+    // a mapped file is used in place, but with an own read position as well
+    if (mapped)
+    {
+        listener.stream = mapped;
+        MeshPtr mappedMesh = MeshManager::getSingleton().create("mapped.mesh", RGN_DEFAULT);
+        mappedMesh->prepare();
+        listener.stream->seek(listener.stream->size() / 2);
+        mappedMesh->load();
+
+        EXPECT_EQ(mappedMesh->getNumSubMeshes(), src->getNumSubMeshes());
+        EXPECT_EQ(mappedMesh->getSubMesh(0)->indexData->indexCount, src->getSubMesh(0)->indexData->indexCount);
+    }
+    ResourceGroupManager::getSingleton().setLoadingListener(NULL);
+
+    listener.stream.reset();
+    mapped.reset();
+    file.close();
+    FileSystemLayer::removeFile(path);
+}
+
+typedef RootWithoutRenderSystemFixture MeshLodStreamingTests;
+TEST_F(MeshLodStreamingTests, workQueue)
+{
+    // generated levels, that reuse the full detail indices
+    MeshPtr src = MeshManager::getSingleton().load("knot.mesh", RGN_DEFAULT);
+    src->freeEdgeList();
+    src->_setLodInfo(4);
+    for (ushort level = 1; level < 4; ++level)
+    {
+        MeshLodUsage usage;
+        usage.userValue = 100 * level;
+        usage.value = src->getLodStrategy()->transformUserValue(usage.userValue);
+        src->_setLodUsage(level, usage);
+        for (ushort i = 0; i < src->getNumSubMeshes(); ++i)
+            src->_setSubMeshLodFaceList(i, level, src->getSubMesh(i)->indexData->clone());
+    }
+    MeshSerializer().exportMesh(src.get(), "lodstream.mesh");
+
+    auto& rgm = ResourceGroupManager::getSingleton();
+    auto& mm = MeshManager::getSingleton();
+    rgm.addResourceLocation(".", "FileSystem", "LodStreamTest");
+    mm.setLodStreaming(true);
+    MeshPtr mesh = mm.load("lodstream.mesh", "LodStreamTest");
+    mm.setLodStreaming(false);
+    ASSERT_FALSE(mesh->isLodLevelResident(1));
+
+    WorkQueue* wq = mRoot->getWorkQueue();
+    wq->startup();
+
+    // the LOD level picked while rendering a frame, responses are processed at its end
+    auto renderFrame = [this, &mesh](ushort lod) {
+        mRoot->_fireFrameStarted();
+        ushort rendered = mesh->_getResidentLodIndex(lod);
+        mRoot->_fireFrameRenderingQueued();
+        mRoot->_fireFrameEnded();
+        return rendered;
+    };
+    auto renderUntilResident = [&](ushort lod) {
+        Timer timer;
+        while (!mesh->isLodLevelResident(lod) && timer.getMilliseconds() < 5000)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            renderFrame(lod);
+        }
+    };
+
+    // the coarsest level is rendered until the requested one is read
+    EXPECT_EQ(renderFrame(1), 3);
+    renderUntilResident(1);
+    EXPECT_EQ(renderFrame(1), 1);
+
+    // with a budget, the levels no longer rendered make room
+    mm.setLodStreamingBudget(1);
+    EXPECT_EQ(renderFrame(2), 3);
+    renderUntilResident(2);
+    EXPECT_TRUE(mesh->isLodLevelResident(2));
+    EXPECT_FALSE(mesh->isLodLevelResident(1));
+
+    // but the level in use stays, even though it exceeds the budget on its own
+    for (int i = 0; i < 3; ++i)
+        EXPECT_EQ(renderFrame(2), 2);
+    EXPECT_TRUE(mesh->isLodLevelResident(2));
+
+    mm.setLodStreamingBudget(0);
+    wq->shutdown();
+    rgm.destroyResourceGroup("LodStreamTest");
+    std::remove("lodstream.mesh");
+}
+
+typedef RootWithoutRenderSystemFixture PoseTests;
+TEST_F(PoseTests, softwareBlendMatchesPerPose)
+{
+    VertexData data[2];
+    for (auto& d : data)
+    {
+        d.vertexCount = 4;
+        d.vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+        d.vertexDeclaration->addElement(0, 12, VET_FLOAT3, VES_NORMAL);
+        auto buf = HardwareBufferManager::getSingleton().createVertexBuffer(
+            24, 4, HardwareBuffer::HBU_DYNAMIC, true);
+        std::vector<float> zeros(24, 0.0f);
+        buf->writeData(0, buf->getSizeInBytes(), zeros.data());
+        d.vertexBufferBinding->setBinding(0, buf);
+    }
+
+    Pose a(1), b(1);
+    a.addVertex(0, Vector3(1, 2, 3), Vector3::UNIT_X);
+    a.addVertex(3, Vector3(4, 5, 6), Vector3::UNIT_Y);
+    b.addVertex(3, Vector3(1, 1, 1), Vector3::UNIT_Z);
+    b.addVertex(1, Vector3(2, 0, 0), Vector3::UNIT_Z);
+
+    Mesh::softwareVertexPoseBlend(0.5, a.getVertexOffsets(), a.getNormals(), &data[0]);
+    Mesh::softwareVertexPoseBlend(0.25, b.getVertexOffsets(), b.getNormals(), &data[0]);
+
+    Mesh::PoseWeightList poses = {{&a, Real(0.5)}, {&b, Real(0.25)}};
+    Mesh::softwareVertexPoseBlend(poses, &data[1]);
+
+    float expected[24], result[24];
+    data[0].vertexBufferBinding->getBuffer(0)->readData(0, sizeof(expected), expected);
+    data[1].vertexBufferBinding->getBuffer(0)->readData(0, sizeof(result), result);
+    for (int i = 0; i < 24; i++)
+        EXPECT_FLOAT_EQ(expected[i], result[i]);
+}
+
+TEST_F(PoseTests, packedDataFollowsEdits)
+{
+    Pose pose(1);
+    pose.addVertex(0, Vector3(1, 2, 3));
+    pose.addVertex(2, Vector3(4, 5, 6));
+    EXPECT_EQ(pose._getPackedOffsets(), std::vector<float>({1, 2, 3, 4, 5, 6}));
+
+    // same size, different content
+    pose.addVertex(2, Vector3(7, 8, 9));
+    EXPECT_EQ(pose._getPackedOffsets(), std::vector<float>({1, 2, 3, 7, 8, 9}));
+
+    pose.removeVertex(0);
+    pose.addVertex(1, Vector3(1, 1, 1));
+    EXPECT_EQ(pose._getPackedIndices(), std::vector<uint32>({1, 2}));
+
+    // writes through the offline processing accessor
+    pose._getVertexOffsets()[2] = Vector3(3, 2, 1);
+    EXPECT_EQ(pose._getPackedOffsets(), std::vector<float>({1, 1, 1, 3, 2, 1}));
+}
+
+TEST_F(SkeletonTests, bonePaletteCache)
+{
+    auto skel = static_pointer_cast<Skeleton>(
+        SkeletonManager::getSingleton().load("jaiqua.skeleton", RGN_DEFAULT));
+    std::vector<Affine3> matrices(skel->getNumBones(), Affine3::IDENTITY);
+
+    Skeleton::BonePaletteKey key = {{skel->getAnimation(0), 3, 1.0f}};
+    EXPECT_FALSE(skel->_findCachedBoneMatrices(1, key));
+
+    skel->_cacheBoneMatrices(1, key, matrices.data());
+    EXPECT_TRUE(skel->_findCachedBoneMatrices(1, key));
+    EXPECT_FALSE(skel->_findCachedBoneMatrices(2, key));
+
+    key[0].timeStep = 4;
+    EXPECT_FALSE(skel->_findCachedBoneMatrices(1, key));
+}
+
+TEST_F(SkeletonTests, bonePaletteCacheEntities)
+{
+    auto sceneMgr = mRoot->createSceneManager();
+    Entity* first = sceneMgr->createEntity("jaiqua.mesh");
+    Entity* second = sceneMgr->createEntity("jaiqua.mesh");
+    Entity* reference = sceneMgr->createEntity("jaiqua.mesh");
+    first->setSkeletonEvaluationCacheQuantum(0.1);
+    second->setSkeletonEvaluationCacheQuantum(0.1);
+
+    Real times[] = {0.98, 1.03, 1.0};
+    Entity* entities[] = {first, second, reference};
+    for (int i = 0; i < 3; i++)
+    {
+        AnimationState* state = entities[i]->getAnimationState("Sneak");
+        state->setEnabled(true);
+        state->setTimePosition(times[i]);
+        entities[i]->_updateAnimation();
+    }
+
+    // both are evaluated at the rounded time, not at the time of the entity evaluated first
+    for (ushort i = 0; i < reference->_getNumBoneMatrices(); i++)
+    {
+        for (int j = 0; j < 12; j++)
+        {
+            Real expected = reference->_getBoneMatrices()[i][0][j];
+            EXPECT_FLOAT_EQ(first->_getBoneMatrices()[i][0][j], expected);
+            EXPECT_FLOAT_EQ(second->_getBoneMatrices()[i][0][j], expected);
+        }
+    }
+}
+
+TEST_F(SkeletonTests, animationLod)
+{
+    auto sceneMgr = mRoot->createSceneManager();
+    Camera* cam = sceneMgr->createCamera("cam");
+    sceneMgr->getRootSceneNode()->attachObject(cam);
+    SceneNode* node = sceneMgr->getRootSceneNode()->createChildSceneNode(Vector3(0, 0, -1000));
+
+    Entity* reduced = sceneMgr->createEntity("jaiqua.mesh");
+    Entity* full = sceneMgr->createEntity("jaiqua.mesh");
+    node->attachObject(reduced);
+    node->attachObject(full);
+    reduced->setAnimationLodLevels({100});
+
+    const ushort boneHandle = reduced->getSkeleton()->getNumBones() - 1;
+    Bone* bone = reduced->getSkeleton()->getBone(boneHandle);
+    TagPoint* tag = reduced->attachObjectToBone(bone->getName(), sceneMgr->createLight());
+
+    for (int frame = 0; frame < 6; frame++)
+    {
+        for (Entity* e : {reduced, full})
+        {
+            AnimationState* state = e->getAnimationState("Sneak");
+            state->setEnabled(true);
+            state->setTimePosition(frame * 0.05);
+        }
+        reduced->_notifyCurrentCamera(cam);
+        EXPECT_EQ(reduced->getCurrentAnimationLodIndex(), 1);
+        reduced->_updateAnimation();
+        full->_updateAnimation();
+
+        // the bones follow the matrices on skipped frames too
+        Affine3 offset;
+        bone->_getOffsetTransform(offset);
+        for (int j = 0; j < 12; j++)
+            EXPECT_FLOAT_EQ(offset[0][j], reduced->_getBoneMatrices()[boneHandle][0][j]);
+        EXPECT_TRUE(tag->_getDerivedPosition().positionEquals(
+            node->_getFullTransform() * bone->_getDerivedPosition(), 1e-3));
+
+        // every other frame is evaluated, without lagging behind
+        for (ushort i = 0; frame % 2 == 0 && i < full->_getNumBoneMatrices(); i++)
+        {
+            for (int j = 0; j < 12; j++)
+                EXPECT_FLOAT_EQ(reduced->_getBoneMatrices()[i][0][j], full->_getBoneMatrices()[i][0][j]);
+        }
+
+        mRoot->_fireFrameRenderingQueued();
+    }
+}
+
+TEST_F(SkeletonTests, animationLodMatrices)
+{
+    auto sceneMgr = mRoot->createSceneManager();
+    Camera* cam = sceneMgr->createCamera("cam");
+    sceneMgr->getRootSceneNode()->attachObject(cam);
+    SceneNode* node = sceneMgr->getRootSceneNode()->createChildSceneNode(Vector3(0, 0, -1000));
+
+    Entity* reduced = sceneMgr->createEntity("jaiqua.mesh");
+    Entity* full = sceneMgr->createEntity("jaiqua.mesh");
+    node->attachObject(reduced);
+    node->attachObject(full);
+    reduced->setAnimationLodLevels({100});
+
+    const ushort boneHandle = reduced->getSkeleton()->getNumBones() - 1;
+    Bone* bone = reduced->getSkeleton()->getBone(boneHandle);
+    Affine3 evaluated;
+
+    for (int frame = 0; frame < 6; frame++)
+    {
+        for (Entity* e : {reduced, full})
+        {
+            AnimationState* state = e->getAnimationState("Sneak");
+            state->setEnabled(true);
+            state->setTimePosition(frame * 0.05);
+        }
+        reduced->_notifyCurrentCamera(cam);
+        reduced->_updateAnimation();
+        full->_updateAnimation();
+
+        if (frame % 2 == 0)
+        {
+            bone->_getOffsetTransform(evaluated);
+        }
+        else if (frame > 2)
+        {
+            // skipped frames extrapolate the matrices without posing the skeleton
+            Affine3 offset;
+            bone->_getOffsetTransform(offset);
+            for (int j = 0; j < 12; j++)
+            {
+                EXPECT_FLOAT_EQ(offset[0][j], evaluated[0][j]);
+                EXPECT_NEAR(reduced->_getBoneMatrices()[boneHandle][0][j],
+                            full->_getBoneMatrices()[boneHandle][0][j], 0.05);
+            }
+        }
+
+        mRoot->_fireFrameRenderingQueued();
+    }
+}
+
+struct ScriptOrderListener : public ResourceGroupListener, public ScriptCompilerListener
+{
+    StringVector events;
+    void scriptParseStarted(const String& scriptName, bool& skipThisScript) override
+    {
+        events.push_back("started " + scriptName);
+    }
+    void scriptParseEnded(const String& scriptName, bool skipped) override { events.push_back("ended " + scriptName); }
+    void handleError(ScriptCompiler* compiler, uint32 code, const String& file, int line, const String& msg) override
+    {
+        events.push_back(StringUtil::format("error %s:%d %u", file.c_str(), line, code));
+    }
+};
+
+struct NoopLoadingListener : public ResourceLoadingListener
+{
+    bool resourceCollision(Resource* resource, ResourceManager* resourceManager) override { return false; }
+};
+
+typedef RootWithoutRenderSystemFixture ScriptCompilerTests;
+TEST_F(ScriptCompilerTests, parallelParsingMatchesSerial)
+{
+    FileSystemLayer::createDirectory("scriptorder");
+    StringVector files;
+    for (int i = 0; i < 12; i++)
+    {
+        files.push_back(StringUtil::format("scriptorder/order%d.material", i));
+        std::ofstream out(files.back().c_str());
+        out << "material Order" << i << " { technique { pass {";
+        // a compile error, reported through the listener
+        if (i == 3)
+            out << "\n unknown_property 1\n";
+        out << "} } }\n";
+        // a parse error, which aborts parsing the group
+        if (i == 9)
+            out << "import\n";
+    }
+
+    auto& rgm = ResourceGroupManager::getSingleton();
+    auto& scm = ScriptCompilerManager::getSingleton();
+
+    // a loading listener may replace the streams, so the scripts are then parsed serially
+    auto parseGroup = [&](bool serial) {
+        ScriptOrderListener listener;
+        NoopLoadingListener loadingListener;
+        rgm.addResourceGroupListener(&listener);
+        scm.setListener(&listener);
+        if (serial)
+            rgm.setLoadingListener(&loadingListener);
+
+        rgm.createResourceGroup("ScriptOrder");
+        rgm.addResourceLocation("scriptorder", "FileSystem", "ScriptOrder");
+        try
+        {
+            rgm.initialiseResourceGroup("ScriptOrder");
+        }
+        catch (const Exception& e)
+        {
+            listener.events.push_back(e.getDescription());
+        }
+
+        rgm.setLoadingListener(NULL);
+        scm.setListener(NULL);
+        rgm.removeResourceGroupListener(&listener);
+        rgm.destroyResourceGroup("ScriptOrder");
+        return listener.events;
+    };
+
+    StringVector serial = parseGroup(true);
+    StringVector parallel = parseGroup(false);
+
+    for (const String& file : files)
+        FileSystemLayer::removeFile(file);
+    FileSystemLayer::removeDirectory("scriptorder");
+
+    // the files are listed in directory order, so the parse error may abort before the compile error
+    EXPECT_EQ(std::count_if(serial.begin(), serial.end(),
+                            [](const String& e) { return StringUtil::startsWith(e, "error"); }),
+              std::count(serial.begin(), serial.end(), "ended order3.material"));
+    EXPECT_TRUE(StringUtil::startsWith(serial.back(), "expected import target", false));
+    EXPECT_EQ(parallel, serial);
+}
+
+TEST_F(ScriptCompilerTests, scriptCache)
+{
+    String script = "abstract pass Red { diffuse 1 0 0 }\n"
+                    "material CachedMaterial { technique { pass : Red { ambient 0 1 0 } } }";
+
+    auto& scm = ScriptCompilerManager::getSingleton();
+    scm.setSaveScriptsToCache(true);
+    DataStreamPtr stream = std::make_shared<MemoryDataStream>("cache.material", &script[0], script.size());
+    scm.parseScript(stream, RGN_DEFAULT);
+    EXPECT_TRUE(scm.isScriptCacheDirty());
+
+    auto cache = std::make_shared<MemoryDataStream>(4096);
+    scm.saveScriptCache(cache);
+    MaterialManager::getSingleton().remove("CachedMaterial", RGN_DEFAULT);
+
+    cache->seek(0);
+    scm.loadScriptCache(cache);
+    EXPECT_FALSE(scm.isScriptCacheDirty());
+
+    EXPECT_EQ(scm.getScriptCacheHits(), 0u);
+
+    stream->seek(0);
+    scm.parseScript(stream, RGN_DEFAULT);
+    EXPECT_EQ(scm.getScriptCacheHits(), 1u);
+    EXPECT_FALSE(scm.isScriptCacheDirty());
+    auto mat = MaterialManager::getSingleton().getByName("CachedMaterial", RGN_DEFAULT);
+    ASSERT_TRUE(mat);
+    EXPECT_EQ(mat->getTechnique(0)->getPass(0)->getDiffuse(), ColourValue::Red);
+    EXPECT_EQ(mat->getTechnique(0)->getPass(0)->getAmbient(), ColourValue::Green);
+
+    // a truncated cache is discarded instead of yielding partial entries
+    size_t cacheSize = cache->tell();
+    auto truncated = std::make_shared<MemoryDataStream>(cache->getPtr(), cacheSize - 8);
+    scm.loadScriptCache(truncated);
+    EXPECT_TRUE(scm.isScriptCacheDirty());
+
+    MaterialManager::getSingleton().remove("CachedMaterial", RGN_DEFAULT);
+    stream->seek(0);
+    scm.parseScript(stream, RGN_DEFAULT);
+    EXPECT_EQ(scm.getScriptCacheHits(), 0u);
+    EXPECT_TRUE(MaterialManager::getSingleton().getByName("CachedMaterial", RGN_DEFAULT));
+    scm.setSaveScriptsToCache(false);
+}
+
+TEST_F(ScriptCompilerTests, scriptCacheImportChanged)
+{
+    auto writeScript = [](const char* name, const char* source) {
+        std::ofstream out(name);
+        out << source;
+    };
+    FileSystemLayer::createDirectory("scriptimport");
+    writeScript("scriptimport/base.material", "abstract pass Base { diffuse 1 0 0 }\n");
+    writeScript("scriptimport/user.material", "import Base from \"base.material\"\n"
+                                              "material ImportUser { technique { pass : Base {} } }\n");
+
+    auto& rgm = ResourceGroupManager::getSingleton();
+    auto& scm = ScriptCompilerManager::getSingleton();
+    scm.setSaveScriptsToCache(true);
+
+    auto parseGroup = [&]() {
+        rgm.createResourceGroup("ScriptImport");
+        rgm.addResourceLocation("scriptimport", "FileSystem", "ScriptImport");
+        rgm.initialiseResourceGroup("ScriptImport");
+        auto mat = MaterialManager::getSingleton().getByName("ImportUser", "ScriptImport");
+        ColourValue diffuse = mat ? mat->getTechnique(0)->getPass(0)->getDiffuse() : ColourValue::Black;
+        rgm.destroyResourceGroup("ScriptImport");
+        return diffuse;
+    };
+
+    EXPECT_EQ(parseGroup(), ColourValue::Red);
+    size_t hits = scm.getScriptCacheHits();
+    EXPECT_EQ(parseGroup(), ColourValue::Red);
+    EXPECT_EQ(scm.getScriptCacheHits(), hits + 2);
+
+    // same size, so only the content hash tells the difference
+    writeScript("scriptimport/base.material", "abstract pass Base { diffuse 0 1 0 }\n");
+    hits = scm.getScriptCacheHits();
+    EXPECT_EQ(parseGroup(), ColourValue::Green);
+    EXPECT_EQ(scm.getScriptCacheHits(), hits);
+
+    scm.setSaveScriptsToCache(false);
+    FileSystemLayer::removeFile("scriptimport/base.material");
+    FileSystemLayer::removeFile("scriptimport/user.material");
+    FileSystemLayer::removeDirectory("scriptimport");
+}
+
+typedef RootWithoutRenderSystemFixture PassTests;
+TEST_F(PassTests, stateIds)
+{
+    auto matA = MaterialManager::getSingleton().create("StateA", RGN_DEFAULT);
+    auto matB = MaterialManager::getSingleton().create("StateB", RGN_DEFAULT);
+    Pass* a = matA->getTechnique(0)->getPass(0);
+    Pass* b = matB->getTechnique(0)->getPass(0);
+    a->setDiffuse(ColourValue::Red); // not part of the render state
+    matA->load();
+    matB->load();
+    Pass::processPendingPassUpdates();
+
+    // different passes setting the same state
+    EXPECT_NE(a->getStateIds().programs, 0u);
+    EXPECT_EQ(a->getSortKey(), b->getSortKey());
+
+    b->setSceneBlending(SBT_TRANSPARENT_ALPHA);
+    b->_dirtyHash();
+    EXPECT_EQ(b->getStateIds().blend, 0u);
+
+    Pass::processPendingPassUpdates();
+    EXPECT_NE(a->getStateIds().blend, b->getStateIds().blend);
+    EXPECT_EQ(a->getStateIds().depth, b->getStateIds().depth);
+    EXPECT_EQ(a->getStateIds().programs, b->getStateIds().programs);
+    EXPECT_NE(a->getSortKey(), b->getSortKey());
+
+    // the blend state is forgotten once no pass uses it, but its ID is not handed out again
+    uint32 blend = b->getStateIds().blend;
+    b->setSceneBlending(SBT_ADD);
+    b->_dirtyHash();
+    Pass::processPendingPassUpdates();
+    b->setSceneBlending(SBT_TRANSPARENT_ALPHA);
+    b->_dirtyHash();
+    Pass::processPendingPassUpdates();
+    EXPECT_NE(b->getStateIds().blend, blend);
+    EXPECT_NE(b->getStateIds().blend, a->getStateIds().blend);
+}
+
+TEST_F(PassTests, stateIdsOnLoad)
+{
+    // passes are only loaded for supported techniques
+    MockRenderSystem rs;
+    rs.caps.setCapability(RSC_FIXED_FUNCTION);
+    rs.caps.setNumTextureUnits(1);
+    mRoot->setRenderSystem(&rs);
+
+    auto matA = MaterialManager::getSingleton().create("LoadA", RGN_DEFAULT);
+    auto matB = MaterialManager::getSingleton().create("LoadB", RGN_DEFAULT);
+    Pass* a = matA->getTechnique(0)->getPass(0);
+    Pass* b = matB->getTechnique(0)->getPass(0);
+
+    // equal samplers are interned by content, not by object
+    a->createTextureUnitState()->setSampler(std::make_shared<Sampler>());
+    b->createTextureUnitState()->setSampler(std::make_shared<Sampler>());
+    // set before loading, without dirtying the hash
+    b->setCullingMode(CULL_NONE);
+
+    matA->load();
+    matB->load();
+    Pass::processPendingPassUpdates();
+    EXPECT_EQ(a->getStateIds().textures, b->getStateIds().textures);
+    EXPECT_NE(a->getStateIds().raster, b->getStateIds().raster);
+
+    // loading again does not count as a change
+    matA->reload();
+    EXPECT_TRUE(Pass::getDirtyHashList().empty());
+    EXPECT_NE(a->getStateIds().raster, 0u);
+
+    MaterialManager::getSingleton().remove(matA);
+    MaterialManager::getSingleton().remove(matB);
+    mRoot->setRenderSystem(NULL);
+}
+
+static std::vector<float> getBakedVertices(const StaticGeometry* geom)
+{
+    std::vector<float> ret;
+    for (const auto& r : geom->getRegions())
+        for (auto lod : r.second->getLODBuckets())
+            for (const auto& mat : lod->getMaterialBuckets())
+                for (auto bucket : mat.second->getGeometryList())
+                {
+                    auto buf = bucket->getVertexData()->vertexBufferBinding->getBuffer(0);
+                    size_t offset = ret.size();
+                    ret.resize(offset + buf->getSizeInBytes() / sizeof(float));
+                    buf->readData(0, buf->getSizeInBytes(), &ret[offset]);
+                }
+    return ret;
+}
+
+typedef RootWithoutRenderSystemFixture StaticGeometryTests;
+TEST_F(StaticGeometryTests, build)
+{
+    auto sceneMgr = mRoot->createSceneManager();
+    auto ent = sceneMgr->createEntity("knot.mesh");
+
+    Vector3 pos(1000, 0, 0), scale(2, 1, 1);
+    Quaternion rot(Degree(90), Vector3::UNIT_Y);
+    auto geom = sceneMgr->createStaticGeometry("single");
+    geom->addEntity(ent, pos, rot, scale);
+    geom->build();
+
+    // the baked vertex of the first index matches the transformed source
+    SubMesh* sub = ent->getMesh()->getSubMesh(0);
+    VertexData* vdata = sub->useSharedVertices ? ent->getMesh()->sharedVertexData : sub->vertexData;
+    size_t srcIndex = 0;
+    if (sub->useSharedVertices)
+    {
+        HardwareBufferLockGuard idxLock(sub->indexData->indexBuffer, HardwareBuffer::HBL_READ_ONLY);
+        srcIndex = sub->indexData->indexBuffer->getType() == HardwareIndexBuffer::IT_32BIT
+                       ? static_cast<uint32*>(idxLock.pData)[sub->indexData->indexStart]
+                       : static_cast<uint16*>(idxLock.pData)[sub->indexData->indexStart];
+    }
+    auto posElem = vdata->vertexDeclaration->findElementBySemantic(VES_POSITION);
+    auto normElem = vdata->vertexDeclaration->findElementBySemantic(VES_NORMAL);
+    ASSERT_TRUE(posElem && normElem);
+    ASSERT_EQ(posElem->getSource(), 0);
+    ASSERT_EQ(normElem->getSource(), 0);
+
+    auto srcBuf = vdata->vertexBufferBinding->getBuffer(0);
+    std::vector<float> src(srcBuf->getSizeInBytes() / sizeof(float));
+    srcBuf->readData(0, srcBuf->getSizeInBytes(), src.data());
+    const float* srcVertex = &src[srcIndex * srcBuf->getVertexSize() / sizeof(float)];
+    Vector3 srcPos(srcVertex + posElem->getOffset() / sizeof(float));
+    Vector3 srcNorm(srcVertex + normElem->getOffset() / sizeof(float));
+
+    ASSERT_EQ(geom->getRegions().size(), 1u);
+    auto region = geom->getRegions().begin()->second;
+    auto baked = getBakedVertices(geom);
+    Vector3 bakedPos(&baked[posElem->getOffset() / sizeof(float)]);
+    Vector3 bakedNorm(&baked[normElem->getOffset() / sizeof(float)]);
+    EXPECT_TRUE(bakedPos.positionEquals(rot * (srcPos * scale) + pos - region->getCentre(), 1e-3));
+    EXPECT_TRUE(bakedNorm.positionEquals((rot * (srcNorm / scale)).normalisedCopy(), 1e-4));
+
+    // several regions, baked serially as the queue is not started yet
+    geom = sceneMgr->createStaticGeometry("city");
+    geom->setRegionDimensions(Vector3(500));
+    geom->addEntity(ent, Vector3::ZERO);
+    geom->addEntity(ent, pos, rot, scale);
+    geom->addEntity(ent, Vector3(0, 0, 1000), Quaternion::IDENTITY, Vector3(0.5));
+    geom->build();
+    EXPECT_EQ(geom->getRegions().size(), 3u);
+    auto serial = getBakedVertices(geom);
+
+    auto wq = mRoot->getWorkQueue();
+    wq->startup();
+
+    geom->build();
+    EXPECT_EQ(getBakedVertices(geom), serial);
+
+    // the current geometry stays in place until the new one is swapped in
+    geom->buildInBackground();
+    EXPECT_EQ(geom->getRegions().size(), 3u);
+    for (int i = 0; i < 1000 && geom->isBuilding(); i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        wq->processResponses();
+    }
+    EXPECT_FALSE(geom->isBuilding());
+    EXPECT_EQ(getBakedVertices(geom), serial);
+
+    // a pending build is dropped with the geometry
+    geom->buildInBackground();
+    sceneMgr->destroyStaticGeometry(geom);
+
+    wq->shutdown();
+}
@@ -29,7 +29,9 @@ THE SOFTWARE.
 #include "Ogre.h"
 #include "OgreInstancedEntity.h"
 #include "OgreInstanceBatchShader.h"
+#include "OgreInstanceBatchHW_VTF.h"
 #include "RootWithoutRenderSystemFixture.h"
+#include "MockRenderSystem.h"
 
 using namespace Ogre;
 
@@ -53,5 +55,101 @@ TEST_F(Instancing, Bounds) {
     EXPECT_EQ(instanced_entity.getBoundingRadius(), entity->getBoundingRadius());
 }
 
+TEST_F(Instancing, BakedAnimation) {
+    MeshPtr mesh = MeshManager::getSingleton().load("robot.mesh", RGN_DEFAULT);
+    MaterialPtr mat = MaterialManager::getSingleton().create("BakedAnimation", RGN_DEFAULT);
 
+    InstanceBatchHW_VTF baked(NULL, mesh, mat, 1, NULL, "Baked");
+    baked.setBakedAnimation(true, 30);
+    InstanceBatchHW_VTF evaluated(NULL, mesh, mat, 1, NULL, "Evaluated");
 
+    // baked instances only need their animation states
+    InstancedEntity bakedEntity(&baked, 0);
+    InstancedEntity otherBakedEntity(&baked, 1);
+    EXPECT_FALSE(bakedEntity.getSkeleton());
+    EXPECT_TRUE(bakedEntity.getAnimationState("Walk"));
+    EXPECT_FALSE(bakedEntity._updateAnimation());
+    EXPECT_FALSE(bakedEntity.shareTransformWith(&otherBakedEntity));
+
+    InstancedEntity evaluatedEntity(&evaluated, 0);
+    EXPECT_TRUE(evaluatedEntity.getSkeleton());
+
+    // the batch size is limited by the instance buffer, as long as the palettes fit in the texture
+    MockRenderSystem rs;
+    rs.caps.setCapability(RSC_VERTEX_BUFFER_INSTANCE_DATA);
+    rs.caps.setCapability(RSC_VERTEX_TEXTURE_FETCH);
+    mRoot->setRenderSystem(&rs);
+
+    EXPECT_EQ(baked.calculateMaxNumInstances(mesh->getSubMesh(0), IM_VTFBAKEDANIMATION), 65535u);
+    InstanceBatchHW_VTF tooDense(NULL, mesh, mat, 1, NULL, "TooDense");
+    tooDense.setBakedAnimation(true, 1e6);
+    EXPECT_EQ(tooDense.calculateMaxNumInstances(mesh->getSubMesh(0), IM_VTFBAKEDANIMATION), 0u);
+
+    mRoot->setRenderSystem(NULL);
+}
+
+TEST_F(Instancing, ParallelVertexBufferUpdate) {
+    MockRenderSystem rs;
+    rs.caps.setCapability(RSC_VERTEX_BUFFER_INSTANCE_DATA);
+    mRoot->setRenderSystem(&rs);
+
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    Camera* cam = sceneMgr->createCamera("cam");
+    sceneMgr->getRootSceneNode()->attachObject(cam);
+
+    // large enough to be culled and written in several chunks
+    const size_t numInstances = 3000;
+    MaterialManager::getSingleton().create("ParallelVertexBufferUpdate", RGN_DEFAULT);
+    InstanceManager* mgr = sceneMgr->createInstanceManager("mgr", "robot.mesh", RGN_DEFAULT,
+                                                           InstanceManager::HWInstancingBasic, numInstances);
+    std::vector<InstancedEntity*> entities;
+    for (size_t i = 0; i < numInstances; i++)
+    {
+        // every other instance is behind the camera, some are beside the frustum
+        Vector3 pos(i * 0.2f, 0, i % 2 ? 500 : -500);
+        entities.push_back(mgr->createInstancedEntity("ParallelVertexBufferUpdate"));
+        sceneMgr->getRootSceneNode()->createChildSceneNode(pos)->attachObject(entities.back());
+    }
+    sceneMgr->getRootSceneNode()->_update(true, false);
+    mgr->_updateDirtyBatches();
+
+    std::vector<Vector3> expected;
+    for (auto e : entities)
+        if (cam->isVisible(Sphere(e->_getDerivedPosition(), e->getBoundingRadius() * e->getMaxScaleCoef())))
+            expected.push_back(e->_getDerivedPosition());
+    ASSERT_LT(expected.size(), numInstances / 2);
+
+    mRoot->getWorkQueue()->startup();
+    auto batches = mgr->getInstanceBatchIterator("ParallelVertexBufferUpdate");
+    ASSERT_TRUE(batches.hasMoreElements());
+    InstanceBatch* batch = batches.getNext();
+    ASSERT_FALSE(batches.hasMoreElements());
+
+    RenderQueue queue;
+    batch->_notifyCurrentCamera(cam);
+    batch->_updateRenderQueue(&queue);
+    mRoot->getWorkQueue()->shutdown();
+
+    RenderOperation op;
+    batch->getRenderOperation(op);
+    ASSERT_EQ(op.numberOfInstances, expected.size());
+
+    // each visible instance is written once, without gaps
+    VertexBufferBinding* binding = op.vertexData->vertexBufferBinding;
+    std::vector<Vector3> written;
+    {
+        HardwareBufferLockGuard lock(binding->getBuffer(binding->getBufferCount() - 1),
+                                     HardwareBuffer::HBL_READ_ONLY);
+        const float* data = static_cast<const float*>(lock.pData);
+        for (size_t i = 0; i < expected.size(); i++)
+            written.push_back(Vector3(data[i * 12 + 3], data[i * 12 + 7], data[i * 12 + 11]));
+    }
+
+    auto byX = [](const Vector3& a, const Vector3& b) { return a.x < b.x; };
+    std::sort(expected.begin(), expected.end(), byX);
+    std::sort(written.begin(), written.end(), byX);
+    EXPECT_EQ(written, expected);
+
+    mRoot->destroySceneManager(sceneMgr);
+    mRoot->setRenderSystem(NULL);
+}
@@ -203,6 +203,50 @@ TEST_F(MeshSerializerTests,Mesh_Version_1_10)
     testMesh(MESH_VERSION_LATEST);
 }
 //--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_LodStreaming)
+{
+    if (mOrigMesh->getNumLodLevels() == 1)
+    {
+        // generated levels, that reuse the full detail indices
+        mOrigMesh->freeEdgeList();
+        mOrigMesh->_setLodInfo(4);
+        for (ushort level = 1; level < 4; ++level)
+        {
+            MeshLodUsage usage;
+            usage.userValue = 100 * level;
+            usage.value = mOrigMesh->getLodStrategy()->transformUserValue(usage.userValue);
+            mOrigMesh->_setLodUsage(level, usage);
+            for (ushort i = 0; i < mOrigMesh->getNumSubMeshes(); ++i)
+            {
+                mOrigMesh->_setSubMeshLodFaceList(i, level, mOrigMesh->getSubMesh(i)->indexData->clone());
+            }
+        }
+    }
+
+    MeshSerializer serializer;
+    serializer.exportMesh(mOrigMesh.get(), mMeshFullPath);
+
+    MeshManager::getSingleton().setLodStreaming(true);
+    mMesh->reload();
+    MeshManager::getSingleton().setLodStreaming(false);
+
+    // only the intermediate levels are deferred
+    ushort numLods = mMesh->getNumLodLevels();
+    EXPECT_TRUE(mMesh->isLodLevelResident(0));
+    EXPECT_TRUE(mMesh->isLodLevelResident(numLods - 1));
+    for (ushort i = 1; i < numLods - 1; ++i)
+    {
+        EXPECT_FALSE(mMesh->isLodLevelResident(i));
+    }
+
+    mMesh->loadStreamedLodLevels();
+    for (ushort i = 0; i < numLods; ++i)
+    {
+        EXPECT_TRUE(mMesh->isLodLevelResident(i));
+    }
+    assertMeshClone(mOrigMesh.get(), mMesh.get());
+}
+//--------------------------------------------------------------------------
 TEST_F(MeshSerializerTests,Mesh_Version_1_8)
 {
     testMesh(MESH_VERSION_1_8);
@@ -26,6 +26,7 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "PixelFormatTests.h"
+#include "OgreBitwise.h"
 #include <cstdlib>
 #include <iomanip>
 
@@ -227,6 +228,37 @@ TEST_F(PixelFormatTests,BulkConversion)
     testCase(PF_X8B8G8R8, PF_A8B8G8R8);
     testCase(PF_X8B8G8R8, PF_B8G8R8A8);
     testCase(PF_X8B8G8R8, PF_R8G8B8A8);
+    testCase(PF_R8, PF_R8G8B8A8);
+    testCase(PF_R8G8B8A8, PF_R8);
+    testCase(PF_L8, PF_R8G8B8A8);
+    testCase(PF_R8G8B8A8, PF_L8);
+    testCase(PF_R8G8B8, PF_R8G8B8A8);
+    testCase(PF_B8G8R8, PF_R8G8B8A8);
+    testCase(PF_FLOAT32_RGB, PF_FLOAT32_RGBA);
+    testCase(PF_FLOAT32_RGBA, PF_FLOAT32_RGB);
+    testCase(PF_FLOAT16_R, PF_FLOAT32_R);
+    testCase(PF_FLOAT16_GR, PF_FLOAT32_GR);
+    testCase(PF_FLOAT16_RGB, PF_FLOAT32_RGB);
+    testCase(PF_FLOAT16_RGBA, PF_FLOAT32_RGBA);
+    testCase(PF_FLOAT32_R, PF_FLOAT16_R);
+    testCase(PF_FLOAT32_GR, PF_FLOAT16_GR);
+    testCase(PF_FLOAT32_RGB, PF_FLOAT16_RGB);
+    testCase(PF_FLOAT32_RGBA, PF_FLOAT16_RGBA);
+}
+//--------------------------------------------------------------------------
+TEST_F(PixelFormatTests,HalfToFloat)
+{
+    // every half value, including denormals, infinities and NaNs
+    std::vector<uint16> halfs(65536);
+    for (size_t i = 0; i < halfs.size(); i++)
+        halfs[i] = uint16(i);
+    std::vector<uint32> floats(halfs.size());
+
+    PixelUtil::bulkPixelConversion(PixelBox(halfs.size() / 4, 1, 1, PF_FLOAT16_RGBA, halfs.data()),
+                                   PixelBox(floats.size() / 4, 1, 1, PF_FLOAT32_RGBA, floats.data()));
+
+    for (size_t i = 0; i < halfs.size(); i++)
+        EXPECT_EQ(floats[i], Bitwise::halfToFloatI(halfs[i])) << "half " << i;
 }
 //--------------------------------------------------------------------------
 
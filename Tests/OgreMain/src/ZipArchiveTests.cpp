@@ -223,6 +223,28 @@ TEST_F(ZipArchiveTests,FileRead)
     EXPECT_TRUE(stream->eof());
 }
 //--------------------------------------------------------------------------
+TEST_F(ZipArchiveTests,FileReadMapped)
+{
+    // stored entries of a mapped archive are ranges of the mapping
+    size_t minSize = MemoryMappedDataStream::getMinMappedSize();
+    MemoryMappedDataStream::setMinMappedSize(0);
+    String storedPath = StringUtil::replaceAll(arch->getName(), "ArchiveTest.zip", "ArchiveTestStored.zip");
+    Archive* mapped = ZipArchiveFactory().createInstance(storedPath, true);
+    mapped->load();
+    MemoryMappedDataStream::setMinMappedSize(minSize);
+
+    DataStreamPtr stream = mapped->open("rootfile.txt");
+    EXPECT_TRUE(std::dynamic_pointer_cast<MemoryMappedDataStream>(stream));
+    EXPECT_EQ(String("this is line 1 in file 1"), stream->getLine());
+    EXPECT_EQ(String("this is line 2 in file 1"), stream->getLine());
+
+    // the archive itself is small, so it is not mapped by default
+    EXPECT_FALSE(std::dynamic_pointer_cast<MemoryMappedDataStream>(arch->open("rootfile.txt")));
+
+    OGRE_DELETE mapped;
+    EXPECT_EQ(String("this is line 3 in file 1"), stream->getLine());
+}
+//--------------------------------------------------------------------------
 TEST_F(ZipArchiveTests,ReadInterleave)
 {
     // Test overlapping reads from same archive